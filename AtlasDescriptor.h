@@ -0,0 +1,94 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef ATLASDESCRIPTOR_H
+#define ATLASDESCRIPTOR_H
+
+#include "OptTile.h"
+#include "Exceptions.h"
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	/// <summary>
+	/// Rectangle de sous-texture utilisable à la compilation, sf::FloatRect n'ayant pas de constructeur constexpr ///
+	/// Subtexture rectangle usable at compile time, as sf::FloatRect has no constexpr constructor
+	/// </summary>
+	struct AtlasRect {
+		float left{ 0.f };
+		float top{ 0.f };
+		float width{ 0.f };
+		float height{ 0.f };
+
+		sf::FloatRect toFloatRect() const
+		{
+			return sf::FloatRect(left, top, width, height);
+		}
+	};
+
+	/// <summary>
+	/// Atlas décrit à la compilation, normalement généré par opttile_atlasgen. Chaque sous-texture est nommée par une valeur de Id,
+	/// dont la valeur numérique est l'index de la sous-texture dans le niveau ///
+	/// Atlas described at compile time, normally generated by opttile_atlasgen. Each subtexture is named by a value of Id,
+	/// whose numeric value is the index of the subtexture inside the level
+	/// </summary>
+	/// <typeparam name="Id">Énumération des sous-textures /// Enumeration of the subtextures</typeparam>
+	/// <typeparam name="N">Nombre de sous-textures /// Number of subtextures</typeparam>
+	template <typename Id, std::size_t N>
+	struct AtlasDescriptor {
+		static_assert(std::is_enum_v<Id>, "subtextures are named by an enumeration");
+		static_assert(N > 0, "an atlas holds at least one subtexture");
+
+		std::array<AtlasRect, N> rects;
+
+		static constexpr std::size_t size()
+		{
+			return N;
+		}
+
+		/// <summary>
+		/// Index de la sous-texture à passer au niveau. Évalué à la compilation, un identifiant hors de l'atlas est une erreur de compilation ///
+		/// Index of the subtexture to give to the level. Evaluated at compile time, an id outside of the atlas is a compile error
+		/// </summary>
+		/// <exception cref="AtlasException">L'identifiant n'existe pas dans l'atlas /// The id does not exist inside the atlas</exception>
+		constexpr int index(Id id) const
+		{
+			const auto valeur{ static_cast<std::underlying_type_t<Id>>(id) };
+			if (valeur < 0 || static_cast<std::size_t>(valeur) >= N)
+				throw AtlasException(static_cast<int>(valeur));
+			return static_cast<int>(valeur);
+		}
+
+		constexpr const AtlasRect& operator[](Id id) const
+		{
+			return rects[static_cast<std::size_t>(index(id))];
+		}
+
+		/// <summary>
+		/// Rectangles dans l'ordre des index, tels qu'attendus par Level::loadTexture ///
+		/// Rectangles in index order, as expected by Level::loadTexture
+		/// </summary>
+		std::vector<sf::FloatRect> subTextures() const
+		{
+			std::vector<sf::FloatRect> rectangles;
+			rectangles.reserve(N);
+			for (const AtlasRect& rectangle : rects)
+				rectangles.push_back(rectangle.toFloatRect());
+			return rectangles;
+		}
+	};
+}
+
+#endif // !ATLASDESCRIPTOR_H
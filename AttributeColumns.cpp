@@ -0,0 +1,36 @@
+#include "pch.h"
+#include "AttributeColumns.h"
+
+opt::AttributeColumns::AttributeColumns() : m_size{ 0 }
+{
+}
+
+void opt::AttributeColumns::remove(const std::string& name)
+{
+	m_columns.erase(name);
+}
+
+bool opt::AttributeColumns::contains(const std::string& name) const
+{
+	return m_columns.find(name) != m_columns.end();
+}
+
+void opt::AttributeColumns::resize(std::size_t size)
+{
+	for (auto& [nom, colonne] : m_columns)
+		colonne->resize(size);
+	m_size = size;
+}
+
+void opt::AttributeColumns::append(const AttributeColumns& other, std::size_t count)
+{
+	for (auto& [nom, colonne] : m_columns)
+	{
+		const auto source{ other.m_columns.find(nom) };
+		if (source != other.m_columns.end() && source->second->type() == colonne->type())
+			colonne->append(*source->second, count);
+		else
+			colonne->resize(m_size + count);
+	}
+	m_size += count;
+}
@@ -0,0 +1,171 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+
+#ifndef ATTRIBUTECOLUMNS_H
+#define ATTRIBUTECOLUMNS_H
+
+#include "OptTile.h"
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace opt
+{
+	/// <summary>
+	/// Colonnes d'attributs nommées, une valeur par tuile, rangées de façon contiguë et indexées par l'index de la tuile ///
+	/// Named attribute columns, one value per tile, stored contiguously and indexed by the tile index
+	/// </summary>
+	class OPTTILE_API AttributeColumns {
+	private:
+		struct ColumnBase {
+			virtual ~ColumnBase() = default;
+			virtual std::type_index type() const = 0;
+			virtual void resize(std::size_t size) = 0;
+			// Ajoute count valeurs copiées du début d'une colonne de même type /// Adds count values copied from the beginning of a column of same type
+			virtual void append(const ColumnBase& other, std::size_t count) = 0;
+		};
+
+		template <class T>
+		struct Column : ColumnBase {
+			std::vector<T> values;
+
+			std::type_index type() const override { return typeid(T); }
+			void resize(std::size_t size) override { values.resize(size); }
+			void append(const ColumnBase& other, std::size_t count) override
+			{
+				const std::size_t debut{ values.size() };
+				values.resize(debut + count);
+				// La source peut être cette colonne : les valeurs sont lues après l'agrandissement ///
+				// The source may be this column: the values are read after the growth
+				const std::vector<T>& source{ static_cast<const Column<T>&>(other).values };
+				for (std::size_t i{ 0 }; i < count; ++i)
+					values[debut + i] = source[i];
+			}
+		};
+
+		std::unordered_map<std::string, std::unique_ptr<ColumnBase>> m_columns;
+		// Nombre de tuiles, donc de valeurs de chaque colonne /// Number of tiles, so of values of each column
+		std::size_t m_size;
+
+		template <class T>
+		Column<T>* find(const std::string& name) const;
+
+	public:
+		AttributeColumns();
+
+		AttributeColumns(const AttributeColumns&) = delete;
+
+		AttributeColumns& operator=(const AttributeColumns&) = delete;
+
+		AttributeColumns(AttributeColumns&&) noexcept = default;
+
+		AttributeColumns& operator=(AttributeColumns&&) noexcept = default;
+
+		/// <summary>
+		/// Ajoute une colonne, remplie de valeurs par défaut. Une colonne existante du même type est gardée ///
+		/// Adds a column, filled with default values. An existing column of the same type is kept
+		/// </summary>
+		/// <typeparam name="T">Type des valeurs /// Type of the values</typeparam>
+		/// <param name="name">Nom de la colonne /// Name of the column</param>
+		/// <returns>Valeurs de la colonne; vide si le nom est déjà pris par un autre type /// Values of the column; empty if the name is already used by another type</returns>
+		template <class T>
+		std::span<T> add(const std::string& name);
+
+		/// <summary>
+		/// Retourne les valeurs d'une colonne. Les valeurs restent valides jusqu'au prochain ajout de tuile ///
+		/// Returns the values of a column. The values stay valid until the next tile addition
+		/// </summary>
+		/// <typeparam name="T">Type des valeurs /// Type of the values</typeparam>
+		/// <param name="name">Nom de la colonne /// Name of the column</param>
+		/// <returns>Si vide, la colonne n'existe pas ou n'est pas de ce type /// If empty, the column does not exist or is not this type</returns>
+		template <class T>
+		std::span<T> get(const std::string& name);
+
+		template <class T>
+		std::span<const T> get(const std::string& name) const;
+
+		/// <summary>
+		/// Retire une colonne ///
+		/// Removes a column
+		/// </summary>
+		/// <param name="name">Nom de la colonne /// Name of the column</param>
+		void remove(const std::string& name);
+
+		/// <summary>
+		/// Indique si une colonne existe ///
+		/// Tells if a column exists
+		/// </summary>
+		/// <param name="name">Nom de la colonne /// Name of the column</param>
+		bool contains(const std::string& name) const;
+
+		/// <summary>
+		/// Change le nombre de valeurs de toutes les colonnes ///
+		/// Changes the number of values of every column
+		/// </summary>
+		/// <param name="size">Nombre de tuiles /// Number of tiles</param>
+		void resize(std::size_t size);
+
+		/// <summary>
+		/// Ajoute les valeurs des count premières tuiles d'une autre table (peut être cette table). Les colonnes sans équivalent de même nom et de même type
+		/// reçoivent des valeurs par défaut ///
+		/// Adds the values of the count first tiles of another table (may be this table). The columns without a match of same name and same type
+		/// receive default values
+		/// </summary>
+		/// <param name="other">Table source /// Source table</param>
+		/// <param name="count">Nombre de tuiles ajoutées /// Number of added tiles</param>
+		void append(const AttributeColumns& other, std::size_t count);
+	};
+
+	template <class T>
+	inline AttributeColumns::Column<T>* AttributeColumns::find(const std::string& name) const
+	{
+		const auto colonne{ m_columns.find(name) };
+		if (colonne == m_columns.end() || colonne->second->type() != typeid(T))
+			return nullptr;
+		return static_cast<Column<T>*>(colonne->second.get());
+	}
+
+	template <class T>
+	inline std::span<T> AttributeColumns::add(const std::string& name)
+	{
+		static_assert(!std::is_same_v<T, bool>, "std::vector<bool> is not contiguous: use std::uint8_t");
+		std::unique_ptr<ColumnBase>& colonne{ m_columns[name] };
+		if (!colonne)
+		{
+			auto nouvelle{ std::make_unique<Column<T>>() };
+			nouvelle->values.resize(m_size);
+			colonne = std::move(nouvelle);
+		}
+		return get<T>(name);
+	}
+
+	template <class T>
+	inline std::span<T> AttributeColumns::get(const std::string& name)
+	{
+		Column<T>* colonne{ find<T>(name) };
+		return colonne ? std::span<T>(colonne->values) : std::span<T>();
+	}
+
+	template <class T>
+	inline std::span<const T> AttributeColumns::get(const std::string& name) const
+	{
+		const Column<T>* colonne{ find<T>(name) };
+		return colonne ? std::span<const T>(colonne->values) : std::span<const T>();
+	}
+}
+
+#endif // !ATTRIBUTECOLUMNS_H
@@ -0,0 +1,176 @@
+#include "pch.h"
+#include "Autotiler.h"
+#include "Level.h"
+#include "Tile.h"
+#include <algorithm>
+
+namespace
+{
+	// Bits des voisins /// Neighbour bits
+	constexpr std::uint8_t north{ 1 }, northEast{ 2 }, east{ 4 }, southEast{ 8 }, south{ 16 }, southWest{ 32 }, west{ 64 }, northWest{ 128 };
+
+	// Décalages des voisins, dans l'ordre des bits /// Neighbour offsets, in bit order
+	constexpr int voisinsX[8]{ 0, 1, 1, 1, 0, -1, -1, -1 };
+	constexpr int voisinsY[8]{ -1, -1, 0, 1, 1, 1, 0, -1 };
+}
+
+opt::AutotileRules::AutotileRules()
+{
+	m_subTextures.fill(-1);
+}
+
+opt::AutotileRules opt::AutotileRules::edges16(int first)
+{
+	AutotileRules regles;
+	for (unsigned masque{ 0 }; masque < 256; ++masque)
+	{
+		const int bords{ (masque & north ? 1 : 0) | (masque & east ? 2 : 0) | (masque & south ? 4 : 0) | (masque & west ? 8 : 0) };
+		regles.m_subTextures[masque] = first + bords;
+	}
+	return regles;
+}
+
+opt::AutotileRules opt::AutotileRules::blob47(int first)
+{
+	// Rang de chaque masque réduit parmi les 47 /// Rank of each reduced mask among the 47
+	std::array<int, 256> rangs;
+	rangs.fill(-1);
+	int rang{ 0 };
+	for (unsigned masque{ 0 }; masque < 256; ++masque)
+		if (reduce(static_cast<std::uint8_t>(masque)) == masque)
+			rangs[masque] = rang++;
+
+	AutotileRules regles;
+	for (unsigned masque{ 0 }; masque < 256; ++masque)
+		regles.m_subTextures[masque] = first + rangs[reduce(static_cast<std::uint8_t>(masque))];
+	return regles;
+}
+
+std::uint8_t opt::AutotileRules::reduce(std::uint8_t neighbours)
+{
+	std::uint8_t masque{ static_cast<std::uint8_t>(neighbours & (north | east | south | west)) };
+	if ((neighbours & northEast) && (neighbours & north) && (neighbours & east))
+		masque |= northEast;
+	if ((neighbours & southEast) && (neighbours & south) && (neighbours & east))
+		masque |= southEast;
+	if ((neighbours & southWest) && (neighbours & south) && (neighbours & west))
+		masque |= southWest;
+	if ((neighbours & northWest) && (neighbours & north) && (neighbours & west))
+		masque |= northWest;
+	return masque;
+}
+
+void opt::AutotileRules::set(std::uint8_t neighbours, int subTexture)
+{
+	m_subTextures[neighbours] = subTexture;
+}
+
+int opt::AutotileRules::subTexture(std::uint8_t neighbours) const
+{
+	return m_subTextures[neighbours];
+}
+
+opt::Autotiler::Autotiler(Level& level, unsigned columns, unsigned rows, std::size_t firstTile) :
+	m_level{ &level }, m_firstTile{ firstTile }, m_columns{ columns }, m_rows{ rows },
+	m_terrains(static_cast<std::size_t>(columns) * rows, 0), m_isDirty(static_cast<std::size_t>(columns) * rows, false),
+	m_bordersMatch{ true }
+{
+}
+
+void opt::Autotiler::setRules(std::uint8_t terrain, const AutotileRules& rules)
+{
+	m_rules[terrain] = rules;
+}
+
+void opt::Autotiler::bordersMatch(bool match)
+{
+	m_bordersMatch = match;
+}
+
+void opt::Autotiler::markDirty(unsigned x, unsigned y)
+{
+	const std::size_t cellule{ static_cast<std::size_t>(y) * m_columns + x };
+	if (!m_isDirty[cellule])
+	{
+		m_isDirty[cellule] = true;
+		m_dirty.push_back(cellule);
+	}
+}
+
+void opt::Autotiler::paint(unsigned x, unsigned y, std::uint8_t terrain)
+{
+	if (x >= m_columns || y >= m_rows)
+		return;
+	std::uint8_t& actuel{ m_terrains[static_cast<std::size_t>(y) * m_columns + x] };
+	if (actuel == terrain)
+		return;
+	actuel = terrain;
+	// La cellule et ses 8 voisines sont les seules dont le masque change ///
+	// The cell and its 8 neighbours are the only ones whose mask changes
+	const unsigned gauche{ x > 0 ? x - 1 : 0 }, droite{ x + 1 < m_columns ? x + 1 : x };
+	const unsigned haut{ y > 0 ? y - 1 : 0 }, bas{ y + 1 < m_rows ? y + 1 : y };
+	for (unsigned j{ haut }; j <= bas; ++j)
+		for (unsigned i{ gauche }; i <= droite; ++i)
+			markDirty(i, j);
+}
+
+void opt::Autotiler::paint(const sf::IntRect& area, std::uint8_t terrain)
+{
+	const int gauche{ std::max(area.left, 0) }, haut{ std::max(area.top, 0) };
+	const int droite{ std::min(area.left + area.width, static_cast<int>(m_columns)) };
+	const int bas{ std::min(area.top + area.height, static_cast<int>(m_rows)) };
+	for (int y{ haut }; y < bas; ++y)
+		for (int x{ gauche }; x < droite; ++x)
+			paint(static_cast<unsigned>(x), static_cast<unsigned>(y), terrain);
+}
+
+std::uint8_t opt::Autotiler::terrain(unsigned x, unsigned y) const
+{
+	return m_terrains[static_cast<std::size_t>(y) * m_columns + x];
+}
+
+void opt::Autotiler::refreshAll()
+{
+	m_dirty.clear();
+	m_dirty.reserve(m_terrains.size());
+	for (std::size_t cellule{ 0 }; cellule < m_terrains.size(); ++cellule)
+	{
+		m_isDirty[cellule] = true;
+		m_dirty.push_back(cellule);
+	}
+}
+
+std::uint8_t opt::Autotiler::neighbours(unsigned x, unsigned y) const
+{
+	const std::uint8_t terrain{ m_terrains[static_cast<std::size_t>(y) * m_columns + x] };
+	std::uint8_t masque{ 0 };
+	for (int bit{ 0 }; bit < 8; ++bit)
+	{
+		const long long i{ static_cast<long long>(x) + voisinsX[bit] }, j{ static_cast<long long>(y) + voisinsY[bit] };
+		const bool dedans{ i >= 0 && j >= 0 && i < m_columns && j < m_rows };
+		if (dedans ? m_terrains[static_cast<std::size_t>(j) * m_columns + static_cast<std::size_t>(i)] == terrain : m_bordersMatch)
+			masque |= static_cast<std::uint8_t>(1u << bit);
+	}
+	return masque;
+}
+
+std::size_t opt::Autotiler::apply()
+{
+	std::vector<std::pair<std::size_t, int>> changements;
+	const std::size_t tuiles{ m_level->size() };
+	for (std::size_t cellule : m_dirty)
+	{
+		m_isDirty[cellule] = false;
+		const auto regles{ m_rules.find(m_terrains[cellule]) };
+		const std::size_t tuile{ m_firstTile + cellule };
+		if (regles == m_rules.end() || tuile >= tuiles)
+			continue;
+		const unsigned x{ static_cast<unsigned>(cellule % m_columns) }, y{ static_cast<unsigned>(cellule / m_columns) };
+		const int sousTexture{ regles->second.subTexture(neighbours(x, y)) };
+		if (sousTexture >= 0 && sousTexture != (*m_level)[static_cast<int>(tuile)].subTextureIndex())
+			changements.emplace_back(tuile, sousTexture);
+	}
+	m_dirty.clear();
+	m_level->changeTextureRects(changements);
+	return changements.size();
+}
@@ -0,0 +1,185 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+
+#ifndef AUTOTILER_H
+#define AUTOTILER_H
+
+#include "OptTile.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	class Level;
+
+	/// <summary>
+	/// Règles d'auto-pavage : associe le masque des 8 voisins de même terrain à une sous-texture.
+	/// Bits du masque : nord 1, nord-est 2, est 4, sud-est 8, sud 16, sud-ouest 32, ouest 64, nord-ouest 128 ///
+	/// Autotile rules: maps the mask of the 8 neighbours of same terrain to a subtexture.
+	/// Mask bits: north 1, north-east 2, east 4, south-east 8, south 16, south-west 32, west 64, north-west 128
+	/// </summary>
+	class OPTTILE_API AutotileRules {
+	private:
+		// Sous-texture de chaque masque, -1 pour garder la sous-texture actuelle ///
+		// Subtexture of each mask, -1 to keep the current subtexture
+		std::array<int, 256> m_subTextures;
+
+	public:
+		/// <summary>
+		/// Règles vides : aucune tuile n'est changée ///
+		/// Empty rules: no tile is changed
+		/// </summary>
+		AutotileRules();
+
+		/// <summary>
+		/// Jeu de 16 bords : seuls les voisins nord, est, sud et ouest comptent.
+		/// La sous-texture est first + (nord 1 | est 2 | sud 4 | ouest 8) ///
+		/// 16-edge set: only the north, east, south and west neighbours count.
+		/// The subtexture is first + (north 1 | east 2 | south 4 | west 8)
+		/// </summary>
+		/// <param name="first">Première des 16 sous-textures consécutives /// First of the 16 consecutive subtextures</param>
+		static AutotileRules edges16(int first);
+
+		/// <summary>
+		/// Jeu de 47 blobs : un coin ne compte que si ses deux bords voisins sont de même terrain.
+		/// Les 47 masques réduits sont numérotés dans l'ordre croissant à partir de first ///
+		/// 47-blob set: a corner only counts if both of its neighbouring edges are of same terrain.
+		/// The 47 reduced masks are numbered in increasing order from first
+		/// </summary>
+		/// <param name="first">Première des 47 sous-textures consécutives /// First of the 47 consecutive subtextures</param>
+		static AutotileRules blob47(int first);
+
+		/// <summary>
+		/// Réduit un masque de 8 voisins aux coins entourés de leurs deux bords ///
+		/// Reduces a mask of 8 neighbours to the corners surrounded by their two edges
+		/// </summary>
+		/// <param name="neighbours">Masque des 8 voisins /// Mask of the 8 neighbours</param>
+		static std::uint8_t reduce(std::uint8_t neighbours);
+
+		/// <summary>
+		/// Associe un masque exact à une sous-texture ///
+		/// Maps an exact mask to a subtexture
+		/// </summary>
+		/// <param name="neighbours">Masque des 8 voisins /// Mask of the 8 neighbours</param>
+		/// <param name="subTexture">Sous-texture, -1 pour garder l'actuelle /// Subtexture, -1 to keep the current one</param>
+		void set(std::uint8_t neighbours, int subTexture);
+
+		/// <summary>
+		/// Retourne la sous-texture d'un masque, -1 si elle n'est pas changée ///
+		/// Returns the subtexture of a mask, -1 if it is not changed
+		/// </summary>
+		/// <param name="neighbours">Masque des 8 voisins /// Mask of the 8 neighbours</param>
+		int subTexture(std::uint8_t neighbours) const;
+	};
+
+	/// <summary>
+	/// Auto-pavage incrémental d'un niveau aligné sur une grille. Peindre une cellule ne marque que cette cellule et ses 8 voisines,
+	/// et apply() ne réévalue que les cellules marquées, puis change leurs sous-textures en une seule mise à jour ///
+	/// Incremental autotiling of a grid-aligned level. Painting a cell only marks this cell and its 8 neighbours,
+	/// and apply() only evaluates the marked cells again, then changes their subtextures in a single update
+	/// </summary>
+	class OPTTILE_API Autotiler {
+	private:
+		Level* m_level;
+		// Tuile de la cellule (0, 0); les cellules suivent en rangées ///
+		// Tile of the cell (0, 0); the cells follow in rows
+		std::size_t m_firstTile;
+		unsigned m_columns;
+		unsigned m_rows;
+		// Terrain de chaque cellule, en rangées ///
+		// Terrain of each cell, in rows
+		std::vector<std::uint8_t> m_terrains;
+		std::unordered_map<std::uint8_t, AutotileRules> m_rules;
+		// Cellules à réévaluer, sans doublon grâce à m_isDirty ///
+		// Cells to evaluate again, without duplicate thanks to m_isDirty
+		std::vector<std::size_t> m_dirty;
+		std::vector<bool> m_isDirty;
+		// Les cellules hors de la grille sont du même terrain que leur voisine ///
+		// The cells outside of the grid are of the same terrain as their neighbour
+		bool m_bordersMatch;
+
+		void markDirty(unsigned x, unsigned y);
+		std::uint8_t neighbours(unsigned x, unsigned y) const;
+
+	public:
+		/// <summary>
+		/// Attache l'auto-pavage à un niveau dont les tuiles [firstTile, firstTile + columns * rows) forment la grille, rangée par rangée.
+		/// Toutes les cellules commencent sur le terrain 0 ///
+		/// Attaches the autotiling to a level whose tiles [firstTile, firstTile + columns * rows) form the grid, row by row.
+		/// Every cell starts on the terrain 0
+		/// </summary>
+		/// <param name="level">Niveau à modifier, qui doit survivre à l'auto-pavage /// Level to modify, which must outlive the autotiling</param>
+		/// <param name="columns">Nombre de colonnes /// Number of columns</param>
+		/// <param name="rows">Nombre de rangées /// Number of rows</param>
+		/// <param name="firstTile">Index de la tuile de la cellule (0, 0) /// Index of the tile of the cell (0, 0)</param>
+		Autotiler(Level& level, unsigned columns, unsigned rows, std::size_t firstTile = 0);
+
+		/// <summary>
+		/// Donne des règles à un terrain. Les cellules d'un terrain sans règles ne sont jamais changées ///
+		/// Gives rules to a terrain. The cells of a terrain without rules are never changed
+		/// </summary>
+		/// <param name="terrain">Terrain /// Terrain</param>
+		/// <param name="rules">Règles du terrain /// Rules of the terrain</param>
+		void setRules(std::uint8_t terrain, const AutotileRules& rules);
+
+		/// <summary>
+		/// Choisit si le bord de la grille continue le terrain (vrai par défaut) ou le termine ///
+		/// Chooses whether the border of the grid continues the terrain (true by default) or ends it
+		/// </summary>
+		/// <param name="match">Le bord continue le terrain /// The border continues the terrain</param>
+		void bordersMatch(bool match);
+
+		/// <summary>
+		/// Peint une cellule. Coût constant : seules la cellule et ses 8 voisines sont marquées ///
+		/// Paints a cell. Constant cost: only the cell and its 8 neighbours are marked
+		/// </summary>
+		/// <param name="x">Colonne /// Column</param>
+		/// <param name="y">Rangée /// Row</param>
+		/// <param name="terrain">Nouveau terrain /// New terrain</param>
+		void paint(unsigned x, unsigned y, std::uint8_t terrain);
+
+		/// <summary>
+		/// Peint un rectangle de cellules (un coup de pinceau). Le coût dépend de la taille du pinceau, pas de celle de la grille ///
+		/// Paints a rectangle of cells (a brush stamp). The cost depends on the size of the brush, not on the size of the grid
+		/// </summary>
+		/// <param name="area">Cellules peintes, coupées à la grille /// Painted cells, clipped to the grid</param>
+		/// <param name="terrain">Nouveau terrain /// New terrain</param>
+		void paint(const sf::IntRect& area, std::uint8_t terrain);
+
+		/// <summary>
+		/// Retourne le terrain d'une cellule ///
+		/// Returns the terrain of a cell
+		/// </summary>
+		/// <param name="x">Colonne /// Column</param>
+		/// <param name="y">Rangée /// Row</param>
+		std::uint8_t terrain(unsigned x, unsigned y) const;
+
+		/// <summary>
+		/// Marque toutes les cellules, par exemple après un changement de règles ///
+		/// Marks every cell, for example after a change of rules
+		/// </summary>
+		void refreshAll();
+
+		/// <summary>
+		/// Réévalue les cellules marquées et change leurs sous-textures en une seule mise à jour du niveau ///
+		/// Evaluates the marked cells again and changes their subtextures in a single update of the level
+		/// </summary>
+		/// <returns>Nombre de tuiles changées /// Number of changed tiles</returns>
+		std::size_t apply();
+	};
+}
+
+#endif // !AUTOTILER_H
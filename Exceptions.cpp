@@ -39,4 +39,14 @@ opt::ParseException::ParseException() : Exception("A parsing error occured while
 opt::ParseException::ParseException(const std::string& fautiveString) : Exception("A parsing error occured while parsing this string: " + fautiveString)
 {
 	
-}
\ No newline at end of file
+}
+
+opt::AtlasException::AtlasException() : Exception("A subtexture does not exist inside the level's atlas")
+{
+
+}
+
+opt::AtlasException::AtlasException(int subTexture) : Exception("This subtexture has no equivalent inside the level's atlas: " + std::to_string(subTexture))
+{
+
+}
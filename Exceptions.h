@@ -33,7 +33,7 @@ namespace opt
 		virtual ~Exception() = 0;
 	};
 
-	class OPTTILE_API LoadException : Exception
+	class OPTTILE_API LoadException : public Exception
 	{
 	public:
 		/// <summary>
@@ -50,13 +50,29 @@ namespace opt
 		LoadException(const std::string& path);
 	};
 
-	class OPTTILE_API ParseException : Exception {
+	class OPTTILE_API ParseException : public Exception {
 	public:
 
 		ParseException();
 
 		ParseException(const std::string& fautiveString);
 	};
+
+	class OPTTILE_API AtlasException : public Exception {
+	public:
+		/// <summary>
+		/// Indique qu'une sous-texture n'existe pas dans l'atlas du niveau ///
+		/// Indicates that a subtexture does not exist inside the level's atlas
+		/// </summary>
+		AtlasException();
+
+		/// <summary>
+		/// Indique que la sous-texture d'un autre niveau n'a pas d'quivalent dans l'atlas du niveau ///
+		/// Indicates that the subtexture of another level has no equivalent inside the level's atlas
+		/// </summary>
+		/// <param name="subTexture">Index de la sous-texture dans l'autre niveau /// Subtexture index inside the other level</param>
+		AtlasException(int subTexture);
+	};
 }
 
 #endif // !LOADEXCEPTION_H
@@ -0,0 +1,89 @@
+#include "pch.h"
+#include "GlFunctions.h"
+#include <SFML/Window/Context.hpp>
+
+namespace
+{
+	// Essaie le nom du cœur d'OpenGL, puis celui de l'extension ARB ///
+	// Tries the OpenGL core name, then the ARB extension name
+	template <typename Function>
+	void load(Function& function, const char* name, const char* arbName = nullptr)
+	{
+		function = reinterpret_cast<Function>(sf::Context::getFunction(name));
+		if (!function && arbName)
+			function = reinterpret_cast<Function>(sf::Context::getFunction(arbName));
+	}
+
+	GLenum factor(sf::BlendMode::Factor facteur)
+	{
+		switch (facteur)
+		{
+		case sf::BlendMode::Zero: return GL_ZERO;
+		case sf::BlendMode::One: return GL_ONE;
+		case sf::BlendMode::SrcColor: return GL_SRC_COLOR;
+		case sf::BlendMode::OneMinusSrcColor: return GL_ONE_MINUS_SRC_COLOR;
+		case sf::BlendMode::DstColor: return GL_DST_COLOR;
+		case sf::BlendMode::OneMinusDstColor: return GL_ONE_MINUS_DST_COLOR;
+		case sf::BlendMode::SrcAlpha: return GL_SRC_ALPHA;
+		case sf::BlendMode::OneMinusSrcAlpha: return GL_ONE_MINUS_SRC_ALPHA;
+		case sf::BlendMode::DstAlpha: return GL_DST_ALPHA;
+		case sf::BlendMode::OneMinusDstAlpha: return GL_ONE_MINUS_DST_ALPHA;
+		}
+		return GL_ZERO;
+	}
+
+	GLenum equation(sf::BlendMode::Equation equation)
+	{
+		switch (equation)
+		{
+		case sf::BlendMode::Subtract: return 0x800A;
+		case sf::BlendMode::ReverseSubtract: return 0x800B;
+		default: return 0x8006;
+		}
+	}
+}
+
+bool opt::GlFunctions::hasBuffers() const
+{
+	return genBuffers && deleteBuffers && bindBuffer && bufferData && bufferSubData && getAttribLocation
+		&& enableVertexAttribArray && disableVertexAttribArray && vertexAttribPointer;
+}
+
+bool opt::GlFunctions::hasInstancing() const
+{
+	return hasBuffers() && vertexAttribDivisor && drawArraysInstanced;
+}
+
+void opt::GlFunctions::applyBlendMode(const sf::BlendMode& mode) const
+{
+	glEnable(GL_BLEND);
+	if (blendFuncSeparate)
+		blendFuncSeparate(factor(mode.colorSrcFactor), factor(mode.colorDstFactor), factor(mode.alphaSrcFactor), factor(mode.alphaDstFactor));
+	else
+		glBlendFunc(factor(mode.colorSrcFactor), factor(mode.colorDstFactor));
+	if (blendEquationSeparate)
+		blendEquationSeparate(equation(mode.colorEquation), equation(mode.alphaEquation));
+}
+
+const opt::GlFunctions& opt::glFunctions()
+{
+	static const GlFunctions fonctions{ []() {
+		sf::Context contexte;
+		GlFunctions chargees;
+		load(chargees.genBuffers, "glGenBuffers", "glGenBuffersARB");
+		load(chargees.deleteBuffers, "glDeleteBuffers", "glDeleteBuffersARB");
+		load(chargees.bindBuffer, "glBindBuffer", "glBindBufferARB");
+		load(chargees.bufferData, "glBufferData", "glBufferDataARB");
+		load(chargees.bufferSubData, "glBufferSubData", "glBufferSubDataARB");
+		load(chargees.getAttribLocation, "glGetAttribLocation", "glGetAttribLocationARB");
+		load(chargees.enableVertexAttribArray, "glEnableVertexAttribArray", "glEnableVertexAttribArrayARB");
+		load(chargees.disableVertexAttribArray, "glDisableVertexAttribArray", "glDisableVertexAttribArrayARB");
+		load(chargees.vertexAttribPointer, "glVertexAttribPointer", "glVertexAttribPointerARB");
+		load(chargees.vertexAttribDivisor, "glVertexAttribDivisor", "glVertexAttribDivisorARB");
+		load(chargees.drawArraysInstanced, "glDrawArraysInstanced", "glDrawArraysInstancedARB");
+		load(chargees.blendFuncSeparate, "glBlendFuncSeparate", "glBlendFuncSeparateEXT");
+		load(chargees.blendEquationSeparate, "glBlendEquationSeparate", "glBlendEquationSeparateEXT");
+		return chargees;
+	}() };
+	return fonctions;
+}
@@ -0,0 +1,74 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef GLFUNCTIONS_H
+#define GLFUNCTIONS_H
+
+#include <cstddef>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/OpenGL.hpp>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+namespace opt
+{
+	/// <summary>
+	/// Fonctions OpenGL plus récentes que la version 1.1 exposée par SFML/OpenGL.hpp, chargées par sf::Context::getFunction. Usage interne seulement ///
+	/// OpenGL functions newer than the 1.1 version exposed by SFML/OpenGL.hpp, loaded through sf::Context::getFunction. Internal use only
+	/// </summary>
+	struct GlFunctions {
+		static constexpr GLenum arrayBuffer{ 0x8892 };
+		static constexpr GLenum staticDraw{ 0x88E4 };
+		static constexpr GLenum dynamicDraw{ 0x88E8 };
+
+		void (APIENTRY* genBuffers)(GLsizei, GLuint*) { nullptr };
+		void (APIENTRY* deleteBuffers)(GLsizei, const GLuint*) { nullptr };
+		void (APIENTRY* bindBuffer)(GLenum, GLuint) { nullptr };
+		void (APIENTRY* bufferData)(GLenum, std::ptrdiff_t, const void*, GLenum) { nullptr };
+		void (APIENTRY* bufferSubData)(GLenum, std::ptrdiff_t, std::ptrdiff_t, const void*) { nullptr };
+		GLint (APIENTRY* getAttribLocation)(GLuint, const char*) { nullptr };
+		void (APIENTRY* enableVertexAttribArray)(GLuint) { nullptr };
+		void (APIENTRY* disableVertexAttribArray)(GLuint) { nullptr };
+		void (APIENTRY* vertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) { nullptr };
+		void (APIENTRY* vertexAttribDivisor)(GLuint, GLuint) { nullptr };
+		void (APIENTRY* drawArraysInstanced)(GLenum, GLint, GLsizei, GLsizei) { nullptr };
+		void (APIENTRY* blendFuncSeparate)(GLenum, GLenum, GLenum, GLenum) { nullptr };
+		void (APIENTRY* blendEquationSeparate)(GLenum, GLenum) { nullptr };
+
+		/// <summary>
+		/// Indique si les fonctions de tampons et d'attributs sont disponibles ///
+		/// Indicates if the buffer and attribute functions are available
+		/// </summary>
+		bool hasBuffers() const;
+
+		/// <summary>
+		/// Indique si le dessin instancié est disponible ///
+		/// Indicates if instanced drawing is available
+		/// </summary>
+		bool hasInstancing() const;
+
+		/// <summary>
+		/// Applique un mode de fusion de SFML lorsque le dessin ne passe pas par sf::RenderTarget::draw ///
+		/// Applies an SFML blend mode when drawing does not go through sf::RenderTarget::draw
+		/// </summary>
+		void applyBlendMode(const sf::BlendMode& mode) const;
+	};
+
+	/// <summary>
+	/// Retourne les fonctions chargées. Le chargement a lieu au premier appel et nécessite un contexte actif ///
+	/// Returns the loaded functions. Loading happens at the first call and needs an active context
+	/// </summary>
+	const GlFunctions& glFunctions();
+}
+
+#endif // !GLFUNCTIONS_H
@@ -0,0 +1,163 @@
+#include "pch.h"
+#include "GridImport.h"
+#include "Exceptions.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <thread>
+
+namespace
+{
+	// Taille minimale d'un bloc analysé par un fil /// Minimal size of a block parsed by one thread
+	constexpr std::size_t minBlockSize{ 256 * 1024 };
+
+	struct Block {
+		const char* begin;
+		const char* end;
+		// Index de la première rangée du bloc /// Index of the first row of the block
+		std::size_t firstRow{ 0 };
+		std::vector<opt::TileRecord> tiles{};
+		std::exception_ptr error{};
+	};
+
+	std::size_t countRows(const char* debut, const char* fin)
+	{
+		std::size_t rangees{ 0 };
+		for (const char* ligne{ debut }; ligne < fin; ++rangees)
+		{
+			const char* finLigne{ static_cast<const char*>(std::memchr(ligne, '\n', fin - ligne)) };
+			ligne = finLigne ? finLigne + 1 : fin;
+		}
+		return rangees;
+	}
+
+	bool isBlank(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	void parseBlock(Block& bloc, const sf::Vector2f& cellSize, const opt::GridImportOptions& options)
+	{
+		std::size_t rangee{ bloc.firstRow };
+		for (const char* curseur{ bloc.begin }; curseur < bloc.end; ++rangee)
+		{
+			const char* finLigne{ static_cast<const char*>(std::memchr(curseur, '\n', bloc.end - curseur)) };
+			if (!finLigne)
+				finLigne = bloc.end;
+			const float y{ options.origin.y + static_cast<float>(rangee) * cellSize.y };
+			for (std::size_t colonne{ 0 };; ++colonne)
+			{
+				while (curseur < finLigne && isBlank(*curseur))
+					++curseur;
+				if (curseur < finLigne && *curseur != options.separator)
+				{
+					int identifiant;
+					const std::from_chars_result lu{ std::from_chars(curseur, finLigne, identifiant) };
+					const char* suite{ lu.ptr };
+					while (suite < finLigne && isBlank(*suite))
+						++suite;
+					if (lu.ec != std::errc() || (suite < finLigne && *suite != options.separator))
+					{
+						const char* finCellule{ std::find(curseur, finLigne, options.separator) };
+						throw opt::ParseException("row " + std::to_string(rangee) + ", column " + std::to_string(colonne) + ": "
+							+ std::string(curseur, finCellule));
+					}
+					curseur = suite;
+					identifiant += options.idOffset;
+					if (identifiant != options.emptyId)
+					{
+						opt::TileRecord tuile;
+						tuile.rect = sf::FloatRect(options.origin.x + static_cast<float>(colonne) * cellSize.x, y, cellSize.x, cellSize.y);
+						tuile.subTexture = identifiant;
+						tuile.textureRule = options.textureRule;
+						bloc.tiles.push_back(tuile);
+					}
+				}
+				if (curseur >= finLigne)
+					break;
+				// Passe le séparateur /// Skips the separator
+				++curseur;
+			}
+			curseur = finLigne + (finLigne < bloc.end);
+		}
+	}
+}
+
+std::vector<opt::TileRecord> opt::GridImport::parse(const char* begin, const char* end, const sf::Vector2f& cellSize,
+	const GridImportOptions& options)
+{
+	// Marque d'ordre des octets UTF-8 /// UTF-8 byte order mark
+	if (end - begin >= 3 && std::memcmp(begin, "\xEF\xBB\xBF", 3) == 0)
+		begin += 3;
+	if (begin >= end)
+		return {};
+	const std::size_t taille{ static_cast<std::size_t>(end - begin) };
+	// Un nombre de fils imposé est respecté même pour un petit texte; sinon, chaque fil reçoit au moins minBlockSize ///
+	// A forced thread count is honoured even for a small text; otherwise, each thread receives at least minBlockSize
+	const std::size_t nbFils{ options.threads ? std::min<std::size_t>(options.threads, taille)
+		: std::max<std::size_t>(1, std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), taille / minBlockSize)) };
+
+	// Blocs coupés juste après une fin de ligne /// Blocks cut right after a line end
+	std::vector<Block> blocs;
+	for (const char* debut{ begin }; debut < end;)
+	{
+		const char* fin{ blocs.size() + 1 < nbFils ? begin + taille * (blocs.size() + 1) / nbFils : end };
+		if (fin < debut)
+			fin = debut;
+		const char* finLigne{ static_cast<const char*>(std::memchr(fin, '\n', end - fin)) };
+		fin = finLigne ? finLigne + 1 : end;
+		blocs.push_back(Block{ debut, fin });
+		debut = fin;
+	}
+
+	const auto executer{ [&](auto&& travail) {
+		std::vector<std::thread> fils;
+		for (std::size_t i{ 1 }; i < blocs.size(); ++i)
+			fils.emplace_back(travail, std::ref(blocs[i]));
+		travail(blocs[0]);
+		for (std::thread& fil : fils)
+			fil.join();
+		for (const Block& bloc : blocs)
+			if (bloc.error)
+				std::rethrow_exception(bloc.error);
+	} };
+
+	// Premier passage : rangées de chaque bloc, pour connaître la première rangée des suivants ///
+	// First pass: rows of each block, to know the first row of the following ones
+	std::vector<std::size_t> rangees(blocs.size());
+	executer([&](Block& bloc) {
+		rangees[&bloc - blocs.data()] = countRows(bloc.begin, bloc.end);
+	});
+	for (std::size_t i{ 1 }; i < blocs.size(); ++i)
+		blocs[i].firstRow = blocs[i - 1].firstRow + rangees[i - 1];
+
+	executer([&](Block& bloc) {
+		try
+		{
+			parseBlock(bloc, cellSize, options);
+		}
+		catch (...)
+		{
+			bloc.error = std::current_exception();
+		}
+	});
+
+	if (blocs.size() == 1)
+		return std::move(blocs[0].tiles);
+	std::size_t nbTuiles{ 0 };
+	for (const Block& bloc : blocs)
+		nbTuiles += bloc.tiles.size();
+	std::vector<TileRecord> tuiles;
+	tuiles.reserve(nbTuiles);
+	for (const Block& bloc : blocs)
+		tuiles.insert(tuiles.end(), bloc.tiles.begin(), bloc.tiles.end());
+	return tuiles;
+}
+
+std::vector<opt::TileRecord> opt::GridImport::read(const std::string& path, const sf::Vector2f& cellSize, const GridImportOptions& options)
+{
+	const MappedFile fichier{ path };
+	return parse(fichier.data(), fichier.data() + fichier.size(), cellSize, options);
+}
@@ -0,0 +1,70 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef GRIDIMPORT_H
+#define GRIDIMPORT_H
+
+#include "OptTile.h"
+#include "LevelFile.h"
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	/// <summary>
+	/// Options de lecture d'une grille CSV d'identifiants de sous-textures ///
+	/// Reading options of a CSV grid of subtexture ids
+	/// </summary>
+	struct OPTTILE_API GridImportOptions {
+		// Coin supérieur gauche de la première cellule /// Top left corner of the first cell
+		sf::Vector2f origin{ 0.f, 0.f };
+		// Ajouté à chaque identifiant lu, par exemple -1 pour des identifiants commençant à 1 /// Added to every id read, for example -1 for ids starting at 1
+		int idOffset{ 0 };
+		// Identifiant, après décalage, d'une cellule vide. Les cellules sans texte sont aussi vides /// Id, after offset, of an empty cell. Cells without text are empty too
+		int emptyId{ -1 };
+		char separator{ ',' };
+		TextureRule textureRule{ TextureRule::repeat_texture };
+		// Nombre de fils d'analyse, 0 pour un par cœur sur un texte assez grand /// Number of parsing threads, 0 for one per core on a large enough text
+		unsigned threads{ 0 };
+	};
+
+	/// <summary>
+	/// Lecture de grilles CSV exportées par des éditeurs de cartes : une ligne de texte par rangée de cellules ///
+	/// Reading of CSV grids exported by map editors: one text line per row of cells
+	/// </summary>
+	class OPTTILE_API GridImport {
+	public:
+		/// <summary>
+		/// Analyse une grille déjà en mémoire. Le texte est découpé en blocs de lignes analysés en parallèle ///
+		/// Parses a grid already in memory. The text is split into blocks of lines parsed in parallel
+		/// </summary>
+		/// <param name="begin">Début du texte /// Text beginning</param>
+		/// <param name="end">Fin du texte /// Text end</param>
+		/// <param name="cellSize">Taille d'une cellule /// Cell size</param>
+		/// <param name="options">Options de lecture /// Reading options</param>
+		/// <returns>Une tuile par cellule non vide, rangée par rangée /// One tile per non-empty cell, row by row</returns>
+		/// <exception cref="ParseException">Une cellule n'est pas un entier /// A cell is not an integer</exception>
+		static std::vector<TileRecord> parse(const char* begin, const char* end, const sf::Vector2f& cellSize,
+			const GridImportOptions& options = GridImportOptions());
+
+		/// <summary>
+		/// Projette un fichier en mémoire puis l'analyse (voir parse) ///
+		/// Maps a file into memory then parses it (see parse)
+		/// </summary>
+		/// <exception cref="LoadException">Le fichier ne peut pas être ouvert /// The file cannot be opened</exception>
+		/// <exception cref="ParseException">Une cellule n'est pas un entier /// A cell is not an integer</exception>
+		static std::vector<TileRecord> read(const std::string& path, const sf::Vector2f& cellSize,
+			const GridImportOptions& options = GridImportOptions());
+	};
+}
+
+#endif // !GRIDIMPORT_H
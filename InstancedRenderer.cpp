@@ -0,0 +1,247 @@
+#include "pch.h"
+#include "InstancedRenderer.h"
+#include "Exceptions.h"
+#include "GlFunctions.h"
+#include <SFML/Window/Context.hpp>
+#include <algorithm>
+#include <cstddef>
+
+namespace
+{
+	const char* const vertexShader{ R"(
+#version 120
+attribute vec2 corner;
+attribute vec4 tileRect;
+attribute vec4 textureRect;
+attribute vec2 cellSize;
+attribute float flags;
+attribute vec4 colour;
+
+uniform mat4 transform;
+
+varying vec2 localPosition;
+varying vec2 tileSize;
+varying vec4 subTexture;
+varying vec2 repetition;
+varying float tileFlags;
+varying vec4 tileColour;
+
+void main()
+{
+	localPosition = corner * tileRect.zw;
+	tileSize = tileRect.zw;
+	subTexture = textureRect;
+	repetition = cellSize;
+	tileFlags = flags;
+	tileColour = colour;
+	gl_Position = transform * vec4(tileRect.xy + localPosition, 0.0, 1.0);
+}
+)" };
+
+	// Reproduit les coordonnées de texture de Tile::intializeVertexes : une répétition complète couvre la largeur de la sous-texture moins 1
+	// et sa hauteur à partir de 0; une répétition coupée au bord couvre la taille restante de la tuile ///
+	// Reproduces the texture coordinates of Tile::intializeVertexes: a full repetition spans the subtexture width minus 1
+	// and its height starting at 0; a repetition clipped at the edge spans the remaining size of the tile
+	const char* const fragmentShader{ R"(
+#version 120
+uniform sampler2D atlas;
+uniform vec2 atlasSize;
+
+varying vec2 localPosition;
+varying vec2 tileSize;
+varying vec4 subTexture;
+varying vec2 repetition;
+varying float tileFlags;
+varying vec4 tileColour;
+
+void main()
+{
+	if (tileFlags >= 16.0)
+	{
+		gl_FragColor = tileColour * texture2D(atlas, vec2(0.0, 0.0));
+		return;
+	}
+	vec2 cellStart = floor(localPosition / repetition) * repetition;
+	vec2 cellExtent = min(repetition, tileSize - cellStart);
+	vec2 span = vec2(cellExtent.x < repetition.x ? cellExtent.x : subTexture.z - 1.0,
+		cellExtent.y < repetition.y ? cellExtent.y : subTexture.w);
+	vec2 texel = vec2(subTexture.x, 0.0) + (localPosition - cellStart) / cellExtent * span;
+	gl_FragColor = tileColour * texture2D(atlas, texel / atlasSize);
+}
+)" };
+
+	const float corners[12]{ 0.f, 0.f, 0.f, 1.f, 1.f, 0.f, 0.f, 1.f, 1.f, 0.f, 1.f, 1.f };
+
+	struct Attribute {
+		const char* name;
+		GLint size;
+		GLenum type;
+		GLboolean normalized;
+		std::size_t offset;
+	};
+
+	const Attribute instanceAttributes[]{
+		{ "tileRect", 4, GL_FLOAT, GL_FALSE, offsetof(opt::TileInstance, tileRect) },
+		{ "textureRect", 4, GL_FLOAT, GL_FALSE, offsetof(opt::TileInstance, textureRect) },
+		{ "cellSize", 2, GL_FLOAT, GL_FALSE, offsetof(opt::TileInstance, cellSize) },
+		{ "flags", 1, GL_FLOAT, GL_FALSE, offsetof(opt::TileInstance, flags) },
+		{ "colour", 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(opt::TileInstance, colour) }
+	};
+}
+
+void opt::InstancedRenderer::createResources()
+{
+	const GlFunctions& gl{ glFunctions() };
+	if (!m_instanceBuffer)
+	{
+		GLuint tampons[2]{};
+		gl.genBuffers(2, tampons);
+		m_instanceBuffer = tampons[0];
+		m_cornerBuffer = tampons[1];
+		gl.bindBuffer(GlFunctions::arrayBuffer, m_cornerBuffer);
+		gl.bufferData(GlFunctions::arrayBuffer, sizeof(corners), corners, GlFunctions::staticDraw);
+		gl.bindBuffer(GlFunctions::arrayBuffer, 0);
+		m_capacity = 0;
+	}
+	if (!m_shaderLoaded)
+	{
+		if (!m_shader.loadFromMemory(vertexShader, fragmentShader))
+			throw opt::LoadException("instanced rendering shader");
+		m_shaderLoaded = true;
+	}
+}
+
+bool opt::InstancedRenderer::isAvailable()
+{
+	return sf::Shader::isAvailable() && glFunctions().hasInstancing();
+}
+
+opt::InstancedRenderer::InstancedRenderer() : m_dirtyBegin{ 0 }, m_dirtyEnd{ 0 }, m_instanceBuffer{ 0 }, m_cornerBuffer{ 0 },
+	m_capacity{ 0 }, m_shaderLoaded{ false }
+{
+}
+
+opt::InstancedRenderer::~InstancedRenderer()
+{
+	if (m_instanceBuffer)
+	{
+		sf::Context contexte;
+		const GLuint tampons[2]{ m_instanceBuffer, m_cornerBuffer };
+		glFunctions().deleteBuffers(2, tampons);
+	}
+}
+
+void opt::InstancedRenderer::resize(std::size_t count)
+{
+	m_instances.resize(count);
+	m_dirtyBegin = std::min(m_dirtyBegin, count);
+	m_dirtyEnd = std::min(m_dirtyEnd, count);
+}
+
+void opt::InstancedRenderer::set(std::size_t index, const TileInstance& instance)
+{
+	if (index >= m_instances.size())
+		m_instances.resize(index + 1);
+	m_instances[index] = instance;
+	if (m_dirtyBegin >= m_dirtyEnd)
+	{
+		m_dirtyBegin = index;
+		m_dirtyEnd = index + 1;
+	}
+	else
+	{
+		m_dirtyBegin = std::min(m_dirtyBegin, index);
+		m_dirtyEnd = std::max(m_dirtyEnd, index + 1);
+	}
+}
+
+std::size_t opt::InstancedRenderer::size() const
+{
+	return m_instances.size();
+}
+
+std::size_t opt::InstancedRenderer::upload()
+{
+	const GlFunctions& gl{ glFunctions() };
+	gl.bindBuffer(GlFunctions::arrayBuffer, m_instanceBuffer);
+	if (m_capacity < m_instances.size())
+	{
+		// Le tampon grandit de moitié pour que les ajouts successifs ne le recréent pas à chaque fois ///
+		// The buffer grows by half so successive additions do not re-create it every time
+		m_capacity = std::max(m_instances.size(), m_capacity + m_capacity / 2);
+		gl.bufferData(GlFunctions::arrayBuffer, m_capacity * sizeof(TileInstance), nullptr, GlFunctions::dynamicDraw);
+		m_dirtyBegin = 0;
+		m_dirtyEnd = m_instances.size();
+	}
+	std::size_t octets{ 0 };
+	if (m_dirtyBegin < m_dirtyEnd)
+	{
+		octets = (m_dirtyEnd - m_dirtyBegin) * sizeof(TileInstance);
+		gl.bufferSubData(GlFunctions::arrayBuffer, m_dirtyBegin * sizeof(TileInstance), octets, m_instances.data() + m_dirtyBegin);
+		m_dirtyBegin = m_dirtyEnd = 0;
+	}
+	gl.bindBuffer(GlFunctions::arrayBuffer, 0);
+	return octets;
+}
+
+std::size_t opt::InstancedRenderer::draw(sf::RenderTarget& target, const sf::RenderStates& states, const sf::Texture& texture)
+{
+	if (m_instances.empty() || !target.setActive(true))
+		return 0;
+	createResources();
+	const std::size_t octets{ upload() };
+	const GlFunctions& gl{ glFunctions() };
+
+	sf::Transform matrice{ target.getView().getTransform() };
+	matrice *= states.transform;
+	m_shader.setUniform("transform", sf::Glsl::Mat4(matrice));
+	m_shader.setUniform("atlas", texture);
+	m_shader.setUniform("atlasSize", sf::Glsl::Vec2(static_cast<float>(std::max(1u, texture.getSize().x)), static_cast<float>(std::max(1u, texture.getSize().y))));
+
+	const sf::IntRect vue{ target.getViewport(target.getView()) };
+	glViewport(vue.left, static_cast<GLint>(target.getSize().y) - (vue.top + vue.height), vue.width, vue.height);
+	gl.applyBlendMode(states.blendMode);
+	sf::Shader::bind(&m_shader);
+
+	const GLuint programme{ m_shader.getNativeHandle() };
+	const GLint coin{ gl.getAttribLocation(programme, "corner") };
+	gl.bindBuffer(GlFunctions::arrayBuffer, m_cornerBuffer);
+	gl.enableVertexAttribArray(coin);
+	gl.vertexAttribPointer(coin, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+	GLint emplacements[std::size(instanceAttributes)]{};
+	gl.bindBuffer(GlFunctions::arrayBuffer, m_instanceBuffer);
+	for (std::size_t i{ 0 }; i < std::size(instanceAttributes); ++i)
+	{
+		const Attribute& attribut{ instanceAttributes[i] };
+		emplacements[i] = gl.getAttribLocation(programme, attribut.name);
+		if (emplacements[i] < 0)
+			continue;
+		gl.enableVertexAttribArray(emplacements[i]);
+		gl.vertexAttribPointer(emplacements[i], attribut.size, attribut.type, attribut.normalized, sizeof(TileInstance),
+			reinterpret_cast<const void*>(attribut.offset));
+		gl.vertexAttribDivisor(emplacements[i], 1);
+	}
+
+	gl.drawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(m_instances.size()));
+
+	for (GLint emplacement : emplacements)
+	{
+		if (emplacement < 0)
+			continue;
+		gl.vertexAttribDivisor(emplacement, 0);
+		gl.disableVertexAttribArray(emplacement);
+	}
+	gl.disableVertexAttribArray(coin);
+	gl.bindBuffer(GlFunctions::arrayBuffer, 0);
+	sf::Shader::bind(nullptr);
+	// SFML garde un cache des états OpenGL; il doit être réinitialisé après des appels directs ///
+	// SFML keeps a cache of the OpenGL states; it has to be reset after direct calls
+	target.resetGLStates();
+	return octets;
+}
+
+std::size_t opt::InstancedRenderer::gpuBytes() const
+{
+	return m_capacity * sizeof(TileInstance) + (m_cornerBuffer ? sizeof(corners) : 0);
+}
@@ -0,0 +1,107 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef INSTANCEDRENDERER_H
+#define INSTANCEDRENDERER_H
+
+#include "OptTile.h"
+#include <cstddef>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	/// <summary>
+	/// Données d'une tuile pour le rendu instancié. Le quadrilatère et ses répétitions de texture sont reconstruits par les nuanceurs ///
+	/// Data of a tile for instanced rendering. The quad and its texture repetitions are rebuilt by the shaders
+	/// </summary>
+	struct OPTTILE_API TileInstance {
+		// Position et taille de la tuile /// Position and size of the tile
+		float tileRect[4];
+		// Rectangle de la sous-texture dans la texture /// Subtexture rectangle inside the texture
+		float textureRect[4];
+		// Taille d'une répétition de la texture dans le monde (taille de la sous-texture multipliée par l'échelle) ///
+		// Size of one texture repetition in the world (subtexture size multiplied by the scale)
+		float cellSize[2];
+		// Règle de texture, plus 16 si la tuile n'a pas de sous-texture /// Texture rule, plus 16 when the tile has no subtexture
+		float flags;
+		// Couleur de la tuile /// Tile colour
+		sf::Uint8 colour[4];
+	};
+
+	/// <summary>
+	/// Rendu instancié d'un niveau : une instance de 48 octets par tuile dans un tampon OpenGL, au lieu de 6 sommets de 20 octets par répétition de texture ///
+	/// Instanced rendering of a level: one 48-byte instance per tile inside an OpenGL buffer, instead of 6 vertexes of 20 bytes per texture repetition
+	/// </summary>
+	class OPTTILE_API InstancedRenderer {
+	private:
+		std::vector<TileInstance> m_instances;
+		// Intervalle d'instances à téléverser [début, fin[ /// Range of instances to upload [begin, end[
+		std::size_t m_dirtyBegin;
+		std::size_t m_dirtyEnd;
+		// Tampon d'instances et tampon des coins du quadrilatère /// Instance buffer and quad corner buffer
+		unsigned m_instanceBuffer;
+		unsigned m_cornerBuffer;
+		// Nombre d'instances que le tampon peut contenir /// Number of instances the buffer can hold
+		std::size_t m_capacity;
+		sf::Shader m_shader;
+		bool m_shaderLoaded;
+
+		void createResources();
+
+	public:
+		/// <summary>
+		/// Indique si la carte graphique permet le rendu instancié (nuanceurs, tampons et instanciation) ///
+		/// Indicates if the graphics card allows instanced rendering (shaders, buffers and instancing)
+		/// </summary>
+		static bool isAvailable();
+
+		InstancedRenderer();
+
+		InstancedRenderer(const InstancedRenderer&) = delete;
+
+		InstancedRenderer& operator=(const InstancedRenderer&) = delete;
+
+		~InstancedRenderer();
+
+		/// <summary>
+		/// Change le nombre d'instances ///
+		/// Changes the number of instances
+		/// </summary>
+		void resize(std::size_t count);
+
+		/// <summary>
+		/// Remplace une instance et la marque comme étant à téléverser. Le tableau grandit au besoin ///
+		/// Replaces an instance and marks it for upload. The array grows if needed
+		/// </summary>
+		void set(std::size_t index, const TileInstance& instance);
+
+		std::size_t size() const;
+
+		/// <summary>
+		/// Téléverse les instances modifiées. Nécessite un contexte actif ///
+		/// Uploads the modified instances. Needs an active context
+		/// </summary>
+		/// <returns>Nombre d'octets téléversés /// Number of uploaded bytes</returns>
+		std::size_t upload();
+
+		/// <summary>
+		/// Dessine toutes les instances sur la cible en un seul appel ///
+		/// Draws every instance on the target in a single call
+		/// </summary>
+		/// <returns>Octets téléversés avant le dessin /// Bytes uploaded before drawing</returns>
+		std::size_t draw(sf::RenderTarget& target, const sf::RenderStates& states, const sf::Texture& texture);
+
+		std::size_t gpuBytes() const;
+	};
+}
+
+#endif // !INSTANCEDRENDERER_H
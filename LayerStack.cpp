@@ -0,0 +1,377 @@
+#include "pch.h"
+#include "LayerStack.h"
+#include <algorithm>
+
+namespace
+{
+	// Emplacement vide ou tuile sans couche /// Empty slot or tile without layer
+	constexpr std::size_t noTile{ static_cast<std::size_t>(-1) };
+}
+
+std::size_t opt::LayerStack::Layer::slotEnd(std::size_t slot) const
+{
+	return slot + 1 < begins.size() ? begins[slot + 1] : vertexes.size();
+}
+
+opt::LayerStack::LayerStack() : m_uploadedBytes{ 0 }
+{
+}
+
+bool opt::LayerStack::active() const
+{
+	return !m_layers.empty();
+}
+
+std::size_t opt::LayerStack::add(const std::string& name)
+{
+	const std::size_t existante{ find(name) };
+	if (existante != noTile)
+		return existante;
+	m_layers.push_back(std::make_unique<Layer>());
+	m_layers.back()->name = name;
+	return m_layers.size() - 1;
+}
+
+std::size_t opt::LayerStack::find(const std::string& name) const
+{
+	for (std::size_t i{ 0 }; i < m_layers.size(); ++i)
+		if (m_layers[i]->name == name)
+			return i;
+	return noTile;
+}
+
+const std::string& opt::LayerStack::name(std::size_t layer) const
+{
+	return m_layers[layer]->name;
+}
+
+void opt::LayerStack::setVisible(std::size_t layer, bool visible)
+{
+	m_layers[layer]->visible = visible;
+}
+
+bool opt::LayerStack::isVisible(std::size_t layer) const
+{
+	return m_layers[layer]->visible;
+}
+
+void opt::LayerStack::setYSorted(std::size_t layer, bool sorted)
+{
+	Layer& couche{ *m_layers[layer] };
+	if (couche.ySorted == sorted)
+		return;
+	couche.ySorted = sorted;
+	if (!sorted)
+		return;
+	// Tri complet une seule fois; les trous sont retirés d'abord ///
+	// Full sort only once; holes are removed first
+	if (couche.holeVertexes)
+		compact(layer);
+	std::vector<std::size_t> ordre(couche.tiles.size());
+	for (std::size_t i{ 0 }; i < ordre.size(); ++i)
+		ordre[i] = i;
+	std::stable_sort(ordre.begin(), ordre.end(), [&couche](std::size_t a, std::size_t b) { return couche.keys[a] < couche.keys[b]; });
+	std::vector<sf::Vertex> sommets;
+	sommets.reserve(couche.vertexes.size());
+	std::vector<std::size_t> tuiles(ordre.size()), debuts(ordre.size());
+	std::vector<float> cles(ordre.size());
+	for (std::size_t i{ 0 }; i < ordre.size(); ++i)
+	{
+		debuts[i] = sommets.size();
+		sommets.insert(sommets.end(), couche.vertexes.begin() + couche.begins[ordre[i]], couche.vertexes.begin() + couche.slotEnd(ordre[i]));
+		tuiles[i] = couche.tiles[ordre[i]];
+		cles[i] = couche.keys[ordre[i]];
+		m_slotOf[tuiles[i]] = i;
+	}
+	couche.vertexes.swap(sommets);
+	couche.tiles.swap(tuiles);
+	couche.begins.swap(debuts);
+	couche.keys.swap(cles);
+	couche.dirty.clear();
+	couche.recreate = true;
+}
+
+bool opt::LayerStack::isYSorted(std::size_t layer) const
+{
+	return m_layers[layer]->ySorted;
+}
+
+void opt::LayerStack::markDirty(Layer& layer, std::size_t begin, std::size_t end)
+{
+	if (begin >= end)
+		return;
+	if (layer.vertexes.size() > layer.capacity)
+	{
+		// Capacité doublée : un ajout coûte en moyenne la taille de la tuile ///
+		// Doubled capacity: an addition costs on average the size of the tile
+		layer.capacity = std::max(layer.vertexes.size(), layer.capacity * 2);
+		layer.recreate = true;
+	}
+	if (!layer.recreate)
+		layer.dirty.emplace_back(begin, end);
+}
+
+void opt::LayerStack::place(std::size_t tile, std::size_t layer, const sf::Vertex* vertexes, std::size_t count, float key)
+{
+	if (tile >= m_layerOf.size())
+	{
+		m_layerOf.resize(tile + 1, noTile);
+		m_slotOf.resize(tile + 1, noTile);
+	}
+	Layer& couche{ *m_layers[layer] };
+	const std::size_t debut{ couche.vertexes.size() };
+	m_layerOf[tile] = layer;
+	m_slotOf[tile] = couche.tiles.size();
+	couche.tiles.push_back(tile);
+	couche.begins.push_back(debut);
+	couche.keys.push_back(key);
+	couche.vertexes.insert(couche.vertexes.end(), vertexes, vertexes + count);
+	markDirty(couche, debut, couche.vertexes.size());
+	if (couche.ySorted)
+		repair(tile);
+}
+
+void opt::LayerStack::erase(std::size_t tile)
+{
+	const std::size_t layer{ m_layerOf[tile] };
+	Layer& couche{ *m_layers[layer] };
+	const std::size_t emplacement{ m_slotOf[tile] };
+	const std::size_t debut{ couche.begins[emplacement] }, fin{ couche.slotEnd(emplacement) };
+	// Des sommets tous à l'origine forment des triangles vides, qui ne coûtent aucun pixel ///
+	// Vertexes all at the origin form empty triangles, which cost no pixel
+	std::fill(couche.vertexes.begin() + debut, couche.vertexes.begin() + fin, sf::Vertex());
+	markDirty(couche, debut, fin);
+	couche.tiles[emplacement] = noTile;
+	couche.holeVertexes += fin - debut;
+	m_layerOf[tile] = noTile;
+	m_slotOf[tile] = noTile;
+	if (couche.holeVertexes * 2 > couche.vertexes.size())
+		compact(layer);
+}
+
+void opt::LayerStack::compact(std::size_t layer)
+{
+	Layer& couche{ *m_layers[layer] };
+	std::vector<sf::Vertex> sommets;
+	sommets.reserve(couche.vertexes.size() - couche.holeVertexes);
+	std::size_t emplacements{ 0 };
+	for (std::size_t i{ 0 }; i < couche.tiles.size(); ++i)
+	{
+		if (couche.tiles[i] == noTile)
+			continue;
+		const std::size_t debut{ sommets.size() };
+		sommets.insert(sommets.end(), couche.vertexes.begin() + couche.begins[i], couche.vertexes.begin() + couche.slotEnd(i));
+		couche.tiles[emplacements] = couche.tiles[i];
+		couche.begins[emplacements] = debut;
+		couche.keys[emplacements] = couche.keys[i];
+		m_slotOf[couche.tiles[i]] = emplacements++;
+	}
+	couche.tiles.resize(emplacements);
+	couche.begins.resize(emplacements);
+	couche.keys.resize(emplacements);
+	couche.vertexes.swap(sommets);
+	couche.holeVertexes = 0;
+	couche.dirty.clear();
+	couche.recreate = true;
+}
+
+void opt::LayerStack::update(std::size_t tile, const sf::Vertex* vertexes, std::size_t count, float key)
+{
+	if (tile >= m_layerOf.size() || m_layerOf[tile] == noTile)
+	{
+		place(tile, 0, vertexes, count, key);
+		return;
+	}
+	Layer& couche{ *m_layers[m_layerOf[tile]] };
+	const std::size_t emplacement{ m_slotOf[tile] };
+	const std::size_t debut{ couche.begins[emplacement] }, fin{ couche.slotEnd(emplacement) };
+	couche.keys[emplacement] = key;
+	if (fin - debut == count)
+	{
+		std::copy(vertexes, vertexes + count, couche.vertexes.begin() + debut);
+		markDirty(couche, debut, fin);
+		if (couche.ySorted)
+			repair(tile);
+		return;
+	}
+	// Nombre de sommets différent : la suite de la couche est décalée ///
+	// Different vertex count: the rest of the layer is shifted
+	couche.vertexes.erase(couche.vertexes.begin() + debut, couche.vertexes.begin() + fin);
+	couche.vertexes.insert(couche.vertexes.begin() + debut, vertexes, vertexes + count);
+	for (std::size_t i{ emplacement + 1 }; i < couche.begins.size(); ++i)
+		couche.begins[i] = couche.begins[i] + count - (fin - debut);
+	markDirty(couche, debut, couche.vertexes.size());
+	if (couche.ySorted)
+		repair(tile);
+}
+
+void opt::LayerStack::swapSlots(Layer& layer, std::size_t slot)
+{
+	const std::size_t debut{ layer.begins[slot] }, milieu{ layer.begins[slot + 1] }, fin{ layer.slotEnd(slot + 1) };
+	std::rotate(layer.vertexes.begin() + debut, layer.vertexes.begin() + milieu, layer.vertexes.begin() + fin);
+	layer.begins[slot + 1] = debut + (fin - milieu);
+	std::swap(layer.tiles[slot], layer.tiles[slot + 1]);
+	std::swap(layer.keys[slot], layer.keys[slot + 1]);
+	if (layer.tiles[slot] != noTile)
+		m_slotOf[layer.tiles[slot]] = slot;
+	if (layer.tiles[slot + 1] != noTile)
+		m_slotOf[layer.tiles[slot + 1]] = slot + 1;
+	markDirty(layer, debut, fin);
+}
+
+void opt::LayerStack::repair(std::size_t tile)
+{
+	Layer& couche{ *m_layers[m_layerOf[tile]] };
+	const float cle{ couche.keys[m_slotOf[tile]] };
+	// Vers le bas de l'ordre : la tuile passe sous les trous et sous les tuiles dont le bord est plus bas ///
+	// Towards the beginning of the order: the tile goes past the holes and under the tiles whose edge is lower
+	for (std::size_t emplacement{ m_slotOf[tile] }; emplacement > 0; )
+	{
+		std::size_t precedent{ emplacement - 1 };
+		while (precedent > 0 && couche.tiles[precedent] == noTile)
+			--precedent;
+		if (couche.tiles[precedent] == noTile || couche.keys[precedent] <= cle)
+			break;
+		for (; emplacement > precedent; --emplacement)
+			swapSlots(couche, emplacement - 1);
+	}
+	// Vers la fin de l'ordre /// Towards the end of the order
+	for (std::size_t emplacement{ m_slotOf[tile] }; emplacement + 1 < couche.tiles.size(); )
+	{
+		std::size_t suivant{ emplacement + 1 };
+		while (suivant + 1 < couche.tiles.size() && couche.tiles[suivant] == noTile)
+			++suivant;
+		if (couche.tiles[suivant] == noTile || couche.keys[suivant] >= cle)
+			break;
+		for (; emplacement < suivant; ++emplacement)
+			swapSlots(couche, emplacement);
+	}
+}
+
+void opt::LayerStack::moveTile(std::size_t tile, std::size_t layer, const sf::Vertex* vertexes, std::size_t count, float key)
+{
+	if (tile < m_layerOf.size() && m_layerOf[tile] != noTile)
+		erase(tile);
+	place(tile, layer, vertexes, count, key);
+}
+
+std::size_t opt::LayerStack::layerOf(std::size_t tile) const
+{
+	return tile < m_layerOf.size() ? m_layerOf[tile] : noTile;
+}
+
+const std::vector<sf::Vertex>& opt::LayerStack::vertexes(std::size_t layer) const
+{
+	return m_layers[layer]->vertexes;
+}
+
+void opt::LayerStack::clearTiles()
+{
+	for (auto& couche : m_layers)
+	{
+		couche->vertexes.clear();
+		couche->tiles.clear();
+		couche->begins.clear();
+		couche->keys.clear();
+		couche->holeVertexes = 0;
+		couche->dirty.clear();
+		couche->recreate = false;
+	}
+	m_layerOf.clear();
+	m_slotOf.clear();
+}
+
+void opt::LayerStack::truncate(std::size_t count)
+{
+	for (std::size_t i{ count }; i < m_layerOf.size(); ++i)
+		if (m_layerOf[i] != noTile)
+			erase(i);
+	if (m_layerOf.size() > count)
+	{
+		m_layerOf.resize(count);
+		m_slotOf.resize(count);
+	}
+}
+
+void opt::LayerStack::upload(Layer& layer)
+{
+	if (layer.recreate)
+	{
+		layer.capacity = std::max(layer.capacity, layer.vertexes.size());
+		layer.buffer.create(layer.capacity);
+		if (!layer.vertexes.empty())
+			layer.buffer.update(layer.vertexes.data(), layer.vertexes.size(), 0);
+		m_uploadedBytes += layer.vertexes.size() * sizeof(sf::Vertex);
+		layer.recreate = false;
+		layer.dirty.clear();
+		return;
+	}
+	if (layer.dirty.empty())
+		return;
+	// Plages triées puis fusionnées lorsqu'elles se touchent ///
+	// Ranges sorted then merged when they touch
+	std::sort(layer.dirty.begin(), layer.dirty.end());
+	std::size_t debut{ layer.dirty[0].first }, fin{ layer.dirty[0].second };
+	for (std::size_t i{ 1 }; i <= layer.dirty.size(); ++i)
+	{
+		if (i < layer.dirty.size() && layer.dirty[i].first <= fin)
+		{
+			fin = std::max(fin, layer.dirty[i].second);
+			continue;
+		}
+		fin = std::min(fin, layer.vertexes.size());
+		if (debut < fin)
+		{
+			layer.buffer.update(layer.vertexes.data() + debut, fin - debut, static_cast<unsigned>(debut));
+			m_uploadedBytes += (fin - debut) * sizeof(sf::Vertex);
+		}
+		if (i < layer.dirty.size())
+		{
+			debut = layer.dirty[i].first;
+			fin = layer.dirty[i].second;
+		}
+	}
+	layer.dirty.clear();
+}
+
+std::size_t opt::LayerStack::draw(sf::RenderTarget& target, sf::RenderStates states, std::size_t& submitted)
+{
+	std::size_t appels{ 0 };
+	submitted = 0;
+	for (auto& couche : m_layers)
+	{
+		// Une couche cachée garde ses modifications pour le jour où elle sera montrée ///
+		// A hidden layer keeps its changes until it is shown
+		if (!couche->visible || couche->vertexes.empty())
+			continue;
+		upload(*couche);
+		target.draw(couche->buffer, 0, couche->vertexes.size(), states);
+		submitted += couche->vertexes.size();
+		++appels;
+	}
+	return appels;
+}
+
+std::size_t opt::LayerStack::takeUploadedBytes()
+{
+	const std::size_t octets{ m_uploadedBytes };
+	m_uploadedBytes = 0;
+	return octets;
+}
+
+std::size_t opt::LayerStack::cpuBytes() const
+{
+	std::size_t octets{ (m_layerOf.capacity() + m_slotOf.capacity()) * sizeof(std::size_t) };
+	for (const auto& couche : m_layers)
+		octets += sizeof(Layer) + couche->vertexes.capacity() * sizeof(sf::Vertex) + (couche->tiles.capacity() + couche->begins.capacity()) * sizeof(std::size_t)
+			+ couche->keys.capacity() * sizeof(float);
+	return octets;
+}
+
+std::size_t opt::LayerStack::gpuBytes() const
+{
+	std::size_t octets{ 0 };
+	for (const auto& couche : m_layers)
+		octets += couche->capacity * sizeof(sf::Vertex);
+	return octets;
+}
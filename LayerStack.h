@@ -0,0 +1,209 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+
+#ifndef LAYERSTACK_H
+#define LAYERSTACK_H
+
+#include "OptTile.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	/// <summary>
+	/// Couches nommées d'un niveau, dessinées dans l'ordre de leur création. Chaque couche garde sa propre copie des sommets de ses tuiles,
+	/// dans l'ordre de dessin, et son propre tampon graphique. Une tuile retirée laisse un trou dégénéré, compacté lorsque les trous occupent la moitié de la couche ///
+	/// Named layers of a level, drawn in their creation order. Each layer keeps its own copy of the vertexes of its tiles,
+	/// in draw order, and its own GPU buffer. A removed tile leaves a degenerate hole, compacted when holes take half of the layer
+	/// </summary>
+	class OPTTILE_API LayerStack {
+	private:
+		struct Layer {
+			std::string name;
+			bool visible{ true };
+			// Les tuiles sont gardées triées selon leur bord bas /// Tiles are kept sorted by their bottom edge
+			bool ySorted{ false };
+			// Sommets des tuiles dans l'ordre de dessin /// Vertexes of the tiles in draw order
+			std::vector<sf::Vertex> vertexes;
+			// Tuile de chaque emplacement, noTile pour un trou /// Tile of each slot, noTile for a hole
+			std::vector<std::size_t> tiles;
+			// Premier sommet de chaque emplacement /// First vertex of each slot
+			std::vector<std::size_t> begins;
+			// Bord bas de chaque emplacement, clé du tri /// Bottom edge of each slot, sort key
+			std::vector<float> keys;
+			std::size_t holeVertexes{ 0 };
+			sf::VertexBuffer buffer{ sf::Triangles, sf::VertexBuffer::Dynamic };
+			// Nombre de sommets que le tampon peut contenir /// Number of vertexes the buffer can hold
+			std::size_t capacity{ 0 };
+			// Le tampon doit être recréé et rempli en entier /// The buffer has to be created again and filled entirely
+			bool recreate{ false };
+			// Plages [début, fin) à téléverser au prochain dessin /// Ranges [begin, end) to upload at the next draw
+			std::vector<std::pair<std::size_t, std::size_t>> dirty;
+
+			std::size_t slotEnd(std::size_t slot) const;
+		};
+
+		std::vector<std::unique_ptr<Layer>> m_layers;
+		// Couche et emplacement de chaque tuile /// Layer and slot of each tile
+		std::vector<std::size_t> m_layerOf;
+		std::vector<std::size_t> m_slotOf;
+		// Octets téléversés depuis le dernier appel à takeUploadedBytes /// Bytes uploaded since the last call to takeUploadedBytes
+		std::size_t m_uploadedBytes;
+
+		void markDirty(Layer& layer, std::size_t begin, std::size_t end);
+
+		/// <summary>
+		/// Ajoute une tuile à la fin d'une couche, donc par-dessus ses autres tuiles ///
+		/// Adds a tile at the end of a layer, so over its other tiles
+		/// </summary>
+		void place(std::size_t tile, std::size_t layer, const sf::Vertex* vertexes, std::size_t count, float key);
+
+		/// <summary>
+		/// Retire une tuile de sa couche en laissant un trou dégénéré ///
+		/// Removes a tile from its layer, leaving a degenerate hole
+		/// </summary>
+		void erase(std::size_t tile);
+
+		void compact(std::size_t layer);
+
+		/// <summary>
+		/// Échange deux emplacements voisins, en ne réécrivant que leurs sommets ///
+		/// Swaps two neighbouring slots, rewriting only their vertexes
+		/// </summary>
+		/// <param name="layer">Couche /// Layer</param>
+		/// <param name="slot">Premier des deux emplacements /// First of the two slots</param>
+		void swapSlots(Layer& layer, std::size_t slot);
+
+		/// <summary>
+		/// Remet une tuile à sa place dans une couche triée, par échanges avec ses voisines. Le coût dépend du déplacement dans l'ordre, pas de la taille de la couche ///
+		/// Puts a tile back at its place inside a sorted layer, by swaps with its neighbours. The cost depends on the displacement in the order, not on the size of the layer
+		/// </summary>
+		void repair(std::size_t tile);
+
+		void upload(Layer& layer);
+
+	public:
+		LayerStack();
+
+		LayerStack(const LayerStack&) = delete;
+
+		LayerStack& operator=(const LayerStack&) = delete;
+
+		LayerStack(LayerStack&&) noexcept = default;
+
+		LayerStack& operator=(LayerStack&&) noexcept = default;
+
+		/// <summary>
+		/// Indique si au moins une couche existe ///
+		/// Indicates if at least one layer exists
+		/// </summary>
+		bool active() const;
+
+		/// <summary>
+		/// Ajoute une couche vide par-dessus les autres, ou retourne le numéro de la couche qui a déjà ce nom ///
+		/// Adds an empty layer over the others, or returns the number of the layer which already has this name
+		/// </summary>
+		/// <param name="name">Nom de la couche /// Name of the layer</param>
+		std::size_t add(const std::string& name);
+
+		/// <summary>
+		/// Retourne le numéro d'une couche, ou -1 si elle n'existe pas ///
+		/// Returns the number of a layer, or -1 if it does not exist
+		/// </summary>
+		/// <param name="name">Nom de la couche /// Name of the layer</param>
+		std::size_t find(const std::string& name) const;
+
+		const std::string& name(std::size_t layer) const;
+
+		void setVisible(std::size_t layer, bool visible);
+
+		bool isVisible(std::size_t layer) const;
+
+		/// <summary>
+		/// Garde les tuiles d'une couche triées selon leur bord bas. L'activation trie la couche une fois; ensuite, chaque tuile modifiée est remise en place par échanges ///
+		/// Keeps the tiles of a layer sorted by their bottom edge. Enabling sorts the layer once; then, each modified tile is put back in place by swaps
+		/// </summary>
+		void setYSorted(std::size_t layer, bool sorted);
+
+		bool isYSorted(std::size_t layer) const;
+
+		/// <summary>
+		/// Copie les sommets d'une tuile dans sa couche. Une tuile sans couche est ajoutée à la couche 0 ///
+		/// Copies the vertexes of a tile into its layer. A tile without layer is added to the layer 0
+		/// </summary>
+		/// <param name="tile">Index de la tuile /// Tile index</param>
+		/// <param name="vertexes">Sommets de la tuile /// Vertexes of the tile</param>
+		/// <param name="count">Nombre de sommets /// Number of vertexes</param>
+		/// <param name="key">Bord bas de la tuile /// Bottom edge of the tile</param>
+		void update(std::size_t tile, const sf::Vertex* vertexes, std::size_t count, float key);
+
+		/// <summary>
+		/// Déplace une tuile à la fin d'une couche (par-dessus ses autres tuiles, ou à sa place si la couche est triée), en coût proportionnel à la tuile ///
+		/// Moves a tile to the end of a layer (over its other tiles, or at its place if the layer is sorted), with a cost proportional to the tile
+		/// </summary>
+		/// <param name="tile">Index de la tuile /// Tile index</param>
+		/// <param name="layer">Couche de destination /// Destination layer</param>
+		/// <param name="vertexes">Sommets de la tuile /// Vertexes of the tile</param>
+		/// <param name="count">Nombre de sommets /// Number of vertexes</param>
+		/// <param name="key">Bord bas de la tuile /// Bottom edge of the tile</param>
+		void moveTile(std::size_t tile, std::size_t layer, const sf::Vertex* vertexes, std::size_t count, float key);
+
+		/// <summary>
+		/// Retourne la couche d'une tuile ///
+		/// Returns the layer of a tile
+		/// </summary>
+		std::size_t layerOf(std::size_t tile) const;
+
+		/// <summary>
+		/// Retourne les sommets d'une couche, trous compris ///
+		/// Returns the vertexes of a layer, holes included
+		/// </summary>
+		const std::vector<sf::Vertex>& vertexes(std::size_t layer) const;
+
+		/// <summary>
+		/// Retire les tuiles de toutes les couches, en gardant les couches ///
+		/// Removes the tiles from every layer, keeping the layers
+		/// </summary>
+		void clearTiles();
+
+		/// <summary>
+		/// Retire de leur couche les tuiles à partir de count, en laissant des trous ///
+		/// Removes from their layer the tiles from count onwards, leaving holes
+		/// </summary>
+		/// <param name="count">Nombre de tuiles gardées /// Number of kept tiles</param>
+		void truncate(std::size_t count);
+
+		/// <summary>
+		/// Téléverse les plages modifiées, puis dessine les couches visibles ///
+		/// Uploads the modified ranges, then draws the visible layers
+		/// </summary>
+		/// <param name="submitted">Reçoit le nombre de sommets soumis /// Receives the number of submitted vertexes</param>
+		/// <returns>Nombre d'appels de dessin /// Number of draw calls</returns>
+		std::size_t draw(sf::RenderTarget& target, sf::RenderStates states, std::size_t& submitted);
+
+		/// <summary>
+		/// Retourne les octets téléversés depuis le dernier appel et remet le compte à 0 ///
+		/// Returns the bytes uploaded since the last call and resets the count to 0
+		/// </summary>
+		std::size_t takeUploadedBytes();
+
+		std::size_t cpuBytes() const;
+
+		std::size_t gpuBytes() const;
+	};
+}
+
+#endif // !LAYERSTACK_H
@@ -14,10 +14,28 @@
 
 #include "OptTile.h"
 #include <memory>
+#include <optional>
+#include <span>
+#include <utility>
 #include <string>
 #include <vector>
 #include <SFML/Graphics.hpp>
 #include "Tile.h"
+#include "LevelStats.h"
+#include "StaticCache.h"
+#include "InstancedRenderer.h"
+#include "PackedVertexBuffer.h"
+#include "MutationQueue.h"
+#include "SubTextureIndex.h"
+#include "AttributeColumns.h"
+#include "OcclusionIndex.h"
+#include "SpatialGrid.h"
+#include "LayerStack.h"
+#include "LevelFile.h"
+#include "GridImport.h"
+#include "LevelBundle.h"
+#include "LevelSnapshot.h"
+#include "AtlasDescriptor.h"
 
 namespace opt
 {
@@ -137,6 +155,7 @@ namespace opt
 	};
 
 	class OPTTILE_API Level : public sf::Drawable {
+		friend class LevelBuilder;
 	private:
 		std::vector<std::unique_ptr<Tile>> m_tiles;
 		// Texture utilisée pour toutes les cases ///
@@ -151,12 +170,117 @@ namespace opt
 		// Indique les sous-textures possibles ///
 		// Indicates every possible subtextures
 		std::vector<sf::FloatRect> m_subTextures;
-		// Sert à faire le rendu des sommets ///
-		// Allows to make the render
-		sf::VertexBuffer m_renderVertexes;
+		// Sert à faire le rendu des sommets. Modifiable dans draw, qui téléverse les tuiles en attente ///
+		// Allows to make the render. Mutable so draw can upload the pending tiles
+		mutable sf::VertexBuffer m_renderVertexes;
 		// Indique si à chaque changement de tuile, il faut mettre à jour le buffer ///
 		// Indicates if at each Tile change, it has to be updated.
 		bool m_autoUpdate;
+		// Compteurs de performance. Modifiables dans draw, qui est constante ///
+		// Performance counters. Mutable so draw, which is const, can update them
+		mutable LevelStats m_stats;
+		// Indique si le niveau est dessiné à partir du cache de rendu statique ///
+		// Indicates if the level is drawn from the static render cache
+		bool m_useStaticCache;
+		// Cache de rendu statique, mis à jour dans draw ///
+		// Static render cache, updated inside draw
+		mutable StaticCache m_staticCache;
+		// Indique si le niveau est dessiné par le rendu instancié ///
+		// Indicates if the level is drawn by the instanced renderer
+		bool m_useInstanced;
+		// Rendu instancié, une instance par tuile ///
+		// Instanced renderer, one instance per tile
+		mutable InstancedRenderer m_instanced;
+		// Indique si le tampon de sommets compacts remplace le sf::VertexBuffer ///
+		// Indicates if the packed vertex buffer replaces the sf::VertexBuffer
+		bool m_usePacked;
+		// Tampon de sommets compacts de 12 octets ///
+		// Buffer of 12-byte packed vertexes
+		mutable PackedVertexBuffer m_packed;
+		// Octets téléversables par image. 0 téléverse chaque modification immédiatement ///
+		// Bytes that can be uploaded per frame. 0 uploads every change immediately
+		std::size_t m_uploadBudget;
+		// Tuiles modifiées qui attendent d'être téléversées ///
+		// Modified tiles waiting to be uploaded
+		mutable std::vector<std::size_t> m_pendingUploads;
+		// Indique, pour chaque tuile, si elle est déjà dans m_pendingUploads ///
+		// Indicates, for each tile, if it is already inside m_pendingUploads
+		mutable std::vector<bool> m_isPending;
+		// Modifications envoyées par d'autres fils, appliquées par applyMutations ///
+		// Changes sent by other threads, applied by applyMutations
+		MutationQueue m_mutations;
+		// Tuiles de chaque sous-texture, mis à jour par updateTile ///
+		// Tiles of each subtexture, updated by updateTile
+		SubTextureIndex m_tilesBySubTexture;
+		// Indique si les tuiles sont rangées de nouveau selon la courbe de Morton lorsque assez d'entre elles ont bougé ///
+		// Indicates if tiles are stored again along the Morton curve when enough of them have moved
+		bool m_autoLayout;
+		// Nombre de tuiles ajoutées ou déplacées depuis le dernier rangement ///
+		// Number of tiles added or moved since the last layout
+		std::size_t m_layoutChanges;
+		// Les tuiles se suivent dans le tampon dans l'ordre de leur index : vrai jusqu'au premier rangement selon la courbe de Morton ///
+		// Tiles follow each other inside the buffer in the order of their index: true until the first layout along the Morton curve
+		bool m_indexOrder;
+		// Indique si draw ne soumet que les tuiles visibles dans la vue ///
+		// Indicates if draw only submits the tiles visible inside the view
+		bool m_culling;
+		// Tuiles rangées par cellule pour l'élimination hors de la vue, tenue à jour tant que culling ou le cache statique est actif ///
+		// Tiles stored by cell for culling outside the view, kept up to date while culling or the static cache is enabled
+		SpatialGrid m_cullingGrid;
+		// Données de jeu ajoutées par l'utilisateur, une valeur par tuile ///
+		// Gameplay data added by the user, one value per tile
+		AttributeColumns m_columns;
+		// Indique si les tuiles cachées par des tuiles opaques ne sont pas dessinées ///
+		// Indicates if the tiles hidden by opaque tiles are not drawn
+		bool m_useOcclusion;
+		// Passe d'occlusion, réévaluée dans draw ///
+		// Occlusion pass, evaluated again inside draw
+		mutable OcclusionIndex m_occlusion;
+		// Sous-textures sans pixel transparent, détectées au chargement de la texture ///
+		// Subtextures without any transparent pixel, detected when the texture is loaded
+		std::vector<bool> m_opaqueSubTextures;
+		// Opacité imposée par tuile : 0 détectée, 1 opaque, 2 transparente ///
+		// Opacity forced per tile: 0 detected, 1 opaque, 2 transparent
+		std::vector<std::uint8_t> m_forcedOpacity;
+		// Couches nommées, chacune avec sa copie des sommets et son tampon. Modifiables dans draw, qui téléverse les plages modifiées ///
+		// Named layers, each one with its copy of the vertexes and its buffer. Mutable so draw can upload the modified ranges
+		mutable LayerStack m_layers;
+		// Tuiles cachées par setVisible; le tampon graphique reçoit des sommets dégénérés à leur place ///
+		// Tiles hidden by setVisible; the GPU buffer receives degenerate vertexes in their place
+		std::vector<bool> m_hidden;
+		std::size_t m_hiddenCount;
+		// Copie des sommets où les tuiles cachées sont dégénérées, utilisée pour téléverser ///
+		// Copy of the vertexes where hidden tiles are degenerate, used to upload
+		mutable std::vector<sf::Vertex> m_visibleVertexes;
+		// Plages des tuiles montrées, recalculées lorsque la visibilité ou le rangement change ///
+		// Ranges of the shown tiles, computed again when visibility or layout changes
+		mutable std::vector<std::pair<std::size_t, std::size_t>> m_shownRanges;
+		mutable bool m_shownRangesDirty;
+		// Nombre de sommets lors de la dernière modification d'une tuile : une tuile ne déplace les plages que si elle change ce nombre ///
+		// Number of vertexes at the last change of a tile: a tile only moves the ranges if it changes this number
+		std::size_t m_shownVertexCount;
+		// Morceaux de l'état courant, partagés avec la dernière photo prise ou rendue ///
+		// Chunks of the current state, shared with the last snapshot taken or restored
+		mutable LevelSnapshot m_snapshotState;
+		// Morceaux modifiés depuis, en plus de tous ceux qui suivent m_dirtyFromTile et m_dirtyFromVertex ///
+		// Chunks modified since, on top of every chunk following m_dirtyFromTile and m_dirtyFromVertex
+		mutable std::vector<bool> m_dirtyTileChunks;
+		mutable std::vector<bool> m_dirtyVertexChunks;
+		mutable std::size_t m_dirtyFromTile;
+		mutable std::size_t m_dirtyFromVertex;
+		// Nombre de sommets lors de la dernière modification suivie, pour détecter les décalages ///
+		// Number of vertexes at the last tracked change, to detect shifts
+		mutable std::size_t m_trackedVertexCount;
+		// Les modifications ne sont suivies qu'après la première photo /// Changes are only tracked after the first snapshot
+		mutable bool m_snapshotTracking;
+		// Tuiles modifiées ou ajoutées depuis le dernier enregistrement du journal ///
+		// Tiles modified or added since the last journal save
+		std::vector<bool> m_isJournaled;
+		std::vector<std::size_t> m_journaledTiles;
+		bool m_journaling;
+		// Les tuiles ont été vidées : le prochain enregistrement du journal réécrit tout le fichier ///
+		// Tiles were emptied: the next journal save writes the whole file again
+		bool m_journalReset;
 
 		/// <summary>
 		/// Indique si on continue de mettre à jour les sommets ///
@@ -166,6 +290,168 @@ namespace opt
 		/// <param name="itterator">Index dans la liste générique de sommets /// Index inside the vector of vertexes</param>
 		bool continueUpdate(std::size_t index, std::size_t itterator);
 
+		/// <summary>
+		/// Retourne l'index suivant le dernier sommet de la tuile ///
+		/// Returns the index following the last vertex of the tile
+		/// </summary>
+		/// <param name="index">Index de la tuile /// Tile index</param>
+		std::size_t tileEnd(std::size_t index) const;
+
+		/// <summary>
+		/// Range les plages de sommets des tuiles selon la courbe de Morton du centre des tuiles, sans téléverser ///
+		/// Stores the vertex ranges of the tiles along the Morton curve of the tile centres, without uploading
+		/// </summary>
+		void sortLayout();
+
+		/// <summary>
+		/// Indique si une tuile cache ce qui est dessous : opacité imposée, sinon sous-texture sans transparence et couleur opaque ///
+		/// Tells if a tile hides what is under it: forced opacity, otherwise subtexture without transparency and opaque colour
+		/// </summary>
+		/// <param name="index">Index de la tuile /// Tile index</param>
+		bool isOpaque(std::size_t index) const;
+
+		/// <summary>
+		/// Détecte les sous-textures opaques à partir de l'alpha de la texture, puis enregistre toutes les tuiles dans la passe d'occlusion ///
+		/// Detects the opaque subtextures from the alpha of the texture, then records every tile inside the occlusion pass
+		/// </summary>
+		void refreshOcclusion();
+
+		/// <summary>
+		/// Retourne les plages de sommets à dessiner, sans les tuiles cachées lorsque la passe d'occlusion est active ///
+		/// Returns the vertex ranges to draw, without the hidden tiles when the occlusion pass is enabled
+		/// </summary>
+		/// <param name="area">Zone visible; toutes les tuiles si absente /// Visible area; every tile if absent</param>
+		std::vector<std::pair<std::size_t, std::size_t>> drawnRanges(const std::optional<sf::FloatRect>& area) const;
+
+		/// <summary>
+		/// Applique les conséquences de la modification d'une tuile : invalidation du cache et mise à jour du tampon ///
+		/// Applies the consequences of a tile change: cache invalidation and buffer update
+		/// </summary>
+		/// <param name="index">Index de la tuile modifiée /// Index of the modified tile</param>
+		/// <param name="previousBounds">Rectangle occupé par la tuile avant la modification /// Rectangle covered by the tile before the change</param>
+		void updateTile(std::size_t index, const sf::FloatRect& previousBounds);
+
+		/// <summary>
+		/// Applique les conséquences d'un changement touchant toutes les tuiles (par exemple, une nouvelle texture) ///
+		/// Applies the consequences of a change touching every tile (for example, a new texture)
+		/// </summary>
+		void updateAllTiles();
+
+		/// <summary>
+		/// Enregistre les tuiles ajoutées en bloc à partir de firstTile dans les index, caches et couches, puis téléverse une fois ///
+		/// Records the tiles added as a block from firstTile inside the indexes, caches and layers, then uploads once
+		/// </summary>
+		/// <param name="firstTile">Index de la première tuile ajoutée /// Index of the first added tile</param>
+		/// <param name="shifted">Des sommets ont été ajoutés /// Vertexes were added</param>
+		void registerAdded(std::size_t firstTile, bool shifted);
+
+		/// <summary>
+		/// Remplace le tampon graphique par un tampon déjà rempli avec tous les sommets, sans téléverser ///
+		/// Replaces the GPU buffer with a buffer already filled with every vertex, without uploading
+		/// </summary>
+		void adoptBuffer(sf::VertexBuffer& buffer);
+
+		/// <summary>
+		/// Met à jour les index, caches et couches d'une tuile dont le contenu a été remplacé, sans téléverser ///
+		/// Updates the indexes, caches and layers of a tile whose content was replaced, without uploading
+		/// </summary>
+		void refreshTile(std::size_t index);
+
+		/// <summary>
+		/// Retire les tuiles à partir de count, qui doivent occuper la fin des sommets dans l'ordre des index, sans téléverser ///
+		/// Removes the tiles from count onwards, which must take the end of the vertexes in index order, without uploading
+		/// </summary>
+		/// <param name="count">Nombre de tuiles gardées /// Number of kept tiles</param>
+		void truncateTiles(std::size_t count);
+
+		/// <summary>
+		/// Marque les morceaux de la tuile comme modifiés pour la prochaine photo. Si le nombre de sommets a changé,
+		/// tous les morceaux qui suivent la tuile le sont ///
+		/// Marks the chunks of the tile as modified for the next snapshot. If the vertex count changed,
+		/// every chunk following the tile is
+		/// </summary>
+		void markSnapshotTile(std::size_t index) const;
+
+		void markSnapshotFrom(std::size_t index) const;
+
+		void markSnapshotAll() const;
+
+		/// <summary>
+		/// Ajoute la tuile au journal, si celui-ci est actif ///
+		/// Adds the tile to the journal, if it is enabled
+		/// </summary>
+		void journalTile(std::size_t index);
+
+		/// <summary>
+		/// Retourne la description d'une tuile ///
+		/// Returns the description of a tile
+		/// </summary>
+		TileRecord tileRecord(std::size_t index) const;
+
+		/// <summary>
+		/// Indique si le tampon de sommets est utilisé pour dessiner le niveau ///
+		/// Indicates if the vertex buffer is used to draw the level
+		/// </summary>
+		bool usesVertexBuffer() const;
+
+		/// <summary>
+		/// Indique si la grille d'élimination est tenue à jour : pour l'élimination hors de la vue ou pour le cache statique ///
+		/// Indicates if the culling grid is kept up to date: for culling outside the view or for the static cache
+		/// </summary>
+		bool usesCullingGrid() const;
+
+		/// <summary>
+		/// Remplit ou vide la grille d'élimination après un changement de culling ou du cache statique ///
+		/// Fills or empties the culling grid after a change of culling or of the static cache
+		/// </summary>
+		/// <param name="wasUsed">La grille était tenue à jour avant le changement /// The grid was kept up to date before the change</param>
+		void refreshCullingGrid(bool wasUsed);
+
+		/// <summary>
+		/// Construit l'instance de rendu d'une tuile ///
+		/// Builds the render instance of a tile
+		/// </summary>
+		TileInstance instanceOf(const Tile& tile) const;
+
+		/// <summary>
+		/// Ajoute une tuile à la file des téléversements si elle n'y est pas déjà ///
+		/// Adds a tile to the upload queue if it is not already there
+		/// </summary>
+		void queueUpload(std::size_t index);
+
+		/// <summary>
+		/// Téléverse des tuiles en attente dans le tampon, en regroupant les tuiles voisines en un seul appel ///
+		/// Uploads pending tiles inside the buffer, merging neighbouring tiles into a single call
+		/// </summary>
+		/// <param name="indexes">Index des tuiles à téléverser, triés par la méthode /// Indexes of the tiles to upload, sorted by the method</param>
+		void uploadTiles(std::vector<std::size_t>& indexes) const;
+
+		bool isHidden(std::size_t index) const;
+
+		/// <summary>
+		/// Retourne les sommets d'une plage à téléverser : ceux du niveau, ou une copie où les tuiles cachées sont dégénérées ///
+		/// Returns the vertexes of a range to upload: the level's ones, or a copy where hidden tiles are degenerate
+		/// </summary>
+		/// <param name="begin">Premier sommet /// First vertex</param>
+		/// <param name="end">Sommet suivant le dernier /// Vertex following the last one</param>
+		/// <param name="tiles">Tuiles de la plage /// Tiles of the range</param>
+		const sf::Vertex* uploadSource(std::size_t begin, std::size_t end, const std::size_t* tiles, std::size_t tileCount) const;
+
+		/// <summary>
+		/// Téléverse les tuiles en attente les plus prioritaires sans dépasser le budget : d'abord celles visibles dans la vue, puis par distance au centre de la vue ///
+		/// Uploads the pending tiles with the highest priority without exceeding the budget: first the ones visible in the view, then by distance to the view centre
+		/// </summary>
+		/// <param name="view">Vue de la cible du dessin /// View of the drawing target</param>
+		void flushUploads(const sf::View& view) const;
+
+		/// <summary>
+		/// Met à jour le tampon après un lot de modifications faites sans mise à jour automatique ///
+		/// Updates the buffer after a batch of changes done without automatic update
+		/// </summary>
+		/// <param name="indexes">Tuiles modifiées /// Modified tiles</param>
+		/// <param name="shifted">Vrai si des sommets ont changé de place dans le tampon /// True if vertexes changed place inside the buffer</param>
+		void syncTiles(std::vector<std::size_t>& indexes, bool shifted);
+
 		/// <summary>
 		/// Indique l'emplacement de l'objet Tile ayant un changement dans ses sommets s'il y en a un
 		/// </summary>
@@ -318,7 +604,9 @@ namespace opt
 		/// Reloads the global texture at the indicated path as well as the subtexture's rectangles
 		/// </summary>
 		/// <param name="path">Chemin de texture /// Texture path</param>
-		/// <param name="subTexturePath">Chemin de la sous-texture. Le formattage est ainsi : "left,top,width,height" /// Subtexture path. The subtexture rectangle must be formatted this way: "left,top,width,height"</param>
+		/// <param name="subTexturePath">Chemin de la sous-texture. Le formattage est ainsi : "left,top,width,height", les lignes blanches sont ignorées /// Subtexture path. The subtexture rectangle must be formatted this way: "left,top,width,height", blank lines are skipped</param>
+		/// <exception cref="LoadException">Un des fichiers ne peut pas être lu, ou aucune sous-texture /// One of the files cannot be read, or no subtexture</exception>
+		/// <exception cref="ParseException">Une ligne a moins de quatre champs /// A line has fewer than four fields</exception>
 		void loadTexture(const std::string& path, const std::string& subTexturePath);
 
 		/// <summary>
@@ -342,9 +630,29 @@ namespace opt
 		/// Reloads the global from an already present texture insie memory and reads dimensions of subtexture's rectangles from a file
 		/// </summary>
 		/// <param name="texture">Référence de texture utilisée /// Texture reference used to copy</param>
-		/// <param name="subTexturePath">Chemin du fichier de sous-textures. Le formattage doit se faire ainsi: "left,top,width,height" /// Subtexture file path. The file must be formatted that way: "left,top,width,height"</param>
+		/// <param name="subTexturePath">Chemin du fichier de sous-textures. Le formattage doit se faire ainsi: "left,top,width,height", les lignes blanches sont ignorées /// Subtexture file path. The file must be formatted that way: "left,top,width,height", blank lines are skipped</param>
+		/// <exception cref="LoadException">Le fichier ne peut pas être lu, ou aucune sous-texture /// The file cannot be read, or no subtexture</exception>
+		/// <exception cref="ParseException">Une ligne a moins de quatre champs /// A line has fewer than four fields</exception>
 		void loadTexture(const sf::Texture& texture, const std::string& subTexturePath);
 
+		/// <summary>
+		/// Recharge la texture globale au chemin indiqué et prend les sous-textures d'un atlas décrit à la compilation, sans lire de fichier ///
+		/// Reloads the global texture at the indicated path and takes the subtextures of an atlas described at compile time, without reading any file
+		/// </summary>
+		/// <param name="path">Chemin de la texture /// Texture path</param>
+		/// <param name="atlas">Atlas généré par opttile_atlasgen /// Atlas generated by opttile_atlasgen</param>
+		template <typename Id, std::size_t N>
+		void loadTexture(const std::string& path, const AtlasDescriptor<Id, N>& atlas);
+
+		/// <summary>
+		/// Recharge la texture globale à la texture indiquée et prend les sous-textures d'un atlas décrit à la compilation, sans lire de fichier ///
+		/// Reloads the global texture from the indicated texture and takes the subtextures of an atlas described at compile time, without reading any file
+		/// </summary>
+		/// <param name="texture">Nouvelle texture globale /// New global texture</param>
+		/// <param name="atlas">Atlas généré par opttile_atlasgen /// Atlas generated by opttile_atlasgen</param>
+		template <typename Id, std::size_t N>
+		void loadTexture(const sf::Texture& texture, const AtlasDescriptor<Id, N>& atlas);
+
 		/// <summary>
 		/// Change le facteur d'agrandissement de la tuile indiquée en paramètre ///
 		/// Changes the zoom of the Tile indicated in parameter
@@ -521,6 +829,444 @@ namespace opt
 		/// </summary>
 		/// <param name="autoUpdate">Doit être mis à jour à chaque changement /// Must update at each change</param>
 		void bufferAutoUpdate(bool autoUpdate);
+
+		/// <summary>
+		/// Indique si le tampon est mis à jour à chaque modification ///
+		/// Indicates if the buffer is updated at each modification
+		/// </summary>
+		bool bufferAutoUpdate() const;
+
+		/// <summary>
+		/// Retourne les compteurs de performance du niveau ainsi que la mémoire occupée. Les compteurs restent à 0 si OPTTILE_ENABLE_STATS n'est pas défini ///
+		/// Returns the performance counters of the level as well as the memory it holds. Counters stay at 0 unless OPTTILE_ENABLE_STATS is defined
+		/// </summary>
+		LevelStats stats() const;
+
+		/// <summary>
+		/// Remet les compteurs de performance à 0. À appeler à chaque image pour obtenir des compteurs par image ///
+		/// Resets the performance counters to 0. Call it at each frame to get per-frame counters
+		/// </summary>
+		void resetStats();
+
+		/// <summary>
+		/// Active le cache de rendu statique : le niveau est rendu une fois dans des textures en cellules, puis dessiné comme quelques quadrilatères.
+		/// Toute modification ne rend de nouveau que les cellules touchées. Le cache a une résolution d'un pixel par unité du monde ///
+		/// Enables the static render cache: the level is rendered once into cell textures, then drawn as a few quads.
+		/// Any change only renders again the touched cells. The cache has a resolution of one pixel per world unit
+		/// </summary>
+		/// <param name="enabled">Active ou désactive le cache /// Enables or disables the cache</param>
+		/// <param name="cellSize">Taille d'une cellule en unités du monde /// Size of a cell in world units</param>
+		void staticCache(bool enabled, unsigned cellSize = 1024u);
+
+		/// <summary>
+		/// Invalide tout le cache de rendu statique. À appeler après avoir modifié directement les sommets ///
+		/// Invalidates the whole static render cache. Call it after modifying the vertexes directly
+		/// </summary>
+		void invalidateCache();
+
+		/// <summary>
+		/// Active le rendu instancié : chaque tuile devient une instance de 48 octets et le quadrilatère, répétitions comprises, est construit par les nuanceurs.
+		/// Une modification ne téléverse que l'instance de la tuile. Si la carte graphique ne le permet pas, le niveau reste dessiné par le tampon de sommets ///
+		/// Enables instanced rendering: each tile becomes a 48-byte instance and the quad, repetitions included, is built by the shaders.
+		/// A change only uploads the tile's instance. If the graphics card does not allow it, the level keeps being drawn from the vertex buffer
+		/// </summary>
+		/// <param name="enabled">Active ou désactive le rendu instancié /// Enables or disables instanced rendering</param>
+		/// <returns>Vrai si le rendu instancié est utilisé /// True if instanced rendering is used</returns>
+		bool instancedRendering(bool enabled);
+
+		/// <summary>
+		/// Téléverse les sommets dans un format compact de 12 octets au lieu des 20 octets d'un sf::Vertex. La conversion est faite au téléversement,
+		/// les tuiles et le tableau de sommets ne changent pas. Si la carte graphique ne le permet pas, ou dès qu'un morceau de sommets s'étend sur plus de
+		/// 65532 unités (les positions entières ne seraient plus exactes), le sf::VertexBuffer est utilisé ///
+		/// Uploads the vertexes in a packed 12-byte format instead of the 20 bytes of an sf::Vertex. The conversion is done when uploading,
+		/// the tiles and the vertex array do not change. If the graphics card does not allow it, or as soon as a chunk of vertexes spans more than
+		/// 65532 units (integer positions would no longer be exact), the sf::VertexBuffer is used
+		/// </summary>
+		/// <param name="enabled">Active ou désactive le format compact /// Enables or disables the packed format</param>
+		/// <returns>Vrai si le format compact est utilisé /// True if the packed format is used</returns>
+		bool packedVertexes(bool enabled);
+
+		/// <summary>
+		/// Limite les octets téléversés à chaque dessin. Les tuiles modifiées sont mises en file et draw téléverse d'abord celles à l'écran,
+		/// puis les plus proches du centre de la vue; le reste attend les images suivantes. Une modification qui change le nombre de sommets
+		/// recharge encore tout le tampon. S'applique au sf::VertexBuffer seulement ///
+		/// Limits the bytes uploaded at each draw. Modified tiles are queued and draw first uploads the ones on screen,
+		/// then the closest to the view centre; the rest waits for the next frames. A change of the vertex count
+		/// still reloads the whole buffer. Applies to the sf::VertexBuffer only
+		/// </summary>
+		/// <param name="bytesPerFrame">Octets par image, 0 pour désactiver /// Bytes per frame, 0 to disable</param>
+		void uploadBudget(std::size_t bytesPerFrame);
+
+		/// <summary>
+		/// Téléverse immédiatement toutes les tuiles en attente, sans tenir compte du budget ///
+		/// Immediately uploads every pending tile, regardless of the budget
+		/// </summary>
+		void flushAll();
+
+		/// <summary>
+		/// Nombre de tuiles qui attendent d'être téléversées ///
+		/// Number of tiles waiting to be uploaded
+		/// </summary>
+		std::size_t pendingUploads() const;
+
+		/// <summary>
+		/// Demande un déplacement de tuile. Peut être appelée par n'importe quel fil; la tuile change au prochain applyMutations ///
+		/// Requests a tile movement. Can be called by any thread; the tile changes at the next applyMutations
+		/// </summary>
+		/// <param name="offset">Mouvement à effectuer /// Movement to do</param>
+		/// <param name="index">Index de la tuile /// Tile index</param>
+		void enqueueMove(const sf::Vector2f& offset, std::size_t index);
+
+		/// <summary>
+		/// Demande une nouvelle position de tuile. Peut être appelée par n'importe quel fil ///
+		/// Requests a new tile position. Can be called by any thread
+		/// </summary>
+		/// <param name="position">Nouvelle position de la tuile /// New tile position</param>
+		/// <param name="index">Index de la tuile /// Tile index</param>
+		void enqueueSetPosition(const sf::Vector2f& position, std::size_t index);
+
+		/// <summary>
+		/// Demande une nouvelle taille de tuile. Peut être appelée par n'importe quel fil ///
+		/// Requests a new tile size. Can be called by any thread
+		/// </summary>
+		/// <param name="size">Nouvelle taille de la tuile /// New tile size</param>
+		/// <param name="index">Index de la tuile /// Tile index</param>
+		void enqueueResize(const sf::Vector2f& size, std::size_t index);
+
+		/// <summary>
+		/// Demande une nouvelle couleur de tuile. Peut être appelée par n'importe quel fil ///
+		/// Requests a new tile colour. Can be called by any thread
+		/// </summary>
+		/// <param name="color">Nouvelle couleur /// New colour</param>
+		/// <param name="index">Index de la tuile /// Tile index</param>
+		void enqueueSetColour(const sf::Color& color, std::size_t index);
+
+		/// <summary>
+		/// Demande une nouvelle sous-texture de tuile. Peut être appelée par n'importe quel fil ///
+		/// Requests a new tile subtexture. Can be called by any thread
+		/// </summary>
+		/// <param name="numberTexture">Index de la sous-texture /// Subtexture index</param>
+		/// <param name="index">Index de la tuile /// Tile index</param>
+		void enqueueChangeTexture(int numberTexture, std::size_t index);
+
+		/// <summary>
+		/// Demande l'ajout d'une tuile à la fin du niveau. Peut être appelée par n'importe quel fil ///
+		/// Requests the addition of a tile at the end of the level. Can be called by any thread
+		/// </summary>
+		/// <param name="size">Taille de la tuile /// Tile size</param>
+		/// <param name="position">Position de la tuile /// Tile position</param>
+		/// <param name="numberSubTexture">Index de la sous-texture /// Subtexture index</param>
+		/// <param name="textureRule">Règle de texture /// Texture rule</param>
+		void enqueueAdd(const sf::Vector2f& size, const sf::Vector2f& position, int numberSubTexture, TextureRule textureRule);
+
+		/// <summary>
+		/// Applique en un seul lot les modifications en file, à appeler par le fil de rendu avant draw. Les ajouts sont faits en premier, dans l'ordre;
+		/// les modifications d'une même tuile sont ensuite fusionnées (les déplacements s'additionnent, la dernière position, taille, couleur ou sous-texture l'emporte)
+		/// et le tampon n'est mis à jour qu'une fois. Les index hors du niveau sont ignorés ///
+		/// Applies in a single batch the queued changes, to be called by the render thread before draw. Additions are done first, in order;
+		/// the changes of a same tile are then merged (movements add up, the last position, size, colour or subtexture wins)
+		/// and the buffer is updated only once. Indexes outside of the level are ignored
+		/// </summary>
+		/// <returns>Nombre de modifications retirées de la file /// Number of changes popped from the queue</returns>
+		std::size_t applyMutations();
+
+		/// <summary>
+		/// Retourne les tuiles utilisant une sous-texture, sans ordre particulier. Les changements faits directement sur une tuile par operator[] ne sont pas suivis ///
+		/// Returns the tiles using a subtexture, in no particular order. Changes done directly on a tile through operator[] are not tracked
+		/// </summary>
+		/// <param name="subTexture">Index de la sous-texture /// Subtexture index</param>
+		const std::vector<std::size_t>& tilesUsing(int subTexture) const;
+
+		/// <summary>
+		/// Donne une autre sous-texture à toutes les tuiles qui en utilisent une (par exemple, l'herbe devient de la neige).
+		/// Les sous-textures de même taille ne font que décaler les coordonnées de texture, et le tout est téléversé en une fois ///
+		/// Gives another subtexture to every tile using one (for example, grass becomes snow).
+		/// Subtextures of the same size only offset the texture coordinates, and everything is uploaded at once
+		/// </summary>
+		/// <param name="from">Sous-texture remplacée /// Replaced subtexture</param>
+		/// <param name="to">Nouvelle sous-texture /// New subtexture</param>
+		/// <returns>Nombre de tuiles modifiées /// Number of modified tiles</returns>
+		std::size_t replaceSubTexture(int from, int to);
+
+		/// <summary>
+		/// Change la sous-texture de plusieurs tuiles en une fois. Le tampon n'est téléversé qu'une fois, en plages fusionnées ///
+		/// Changes the subtexture of many tiles at once. The buffer is uploaded only once, in merged ranges
+		/// </summary>
+		/// <param name="changes">Paires (index de la tuile, nouvelle sous-texture) /// Pairs (tile index, new subtexture)</param>
+		void changeTextureRects(const std::vector<std::pair<std::size_t, int>>& changes);
+
+		/// <summary>
+		/// Ajoute toutes les tuiles d'un autre niveau, décalées. Les sommets sont copiés en un bloc au lieu d'être reconstruits, et le tampon n'est téléversé qu'une fois.
+		/// Les sous-textures de l'autre niveau sont associées aux sous-textures de même rectangle dans ce niveau ///
+		/// Adds every tile of another level, offset. Vertexes are copied as one block instead of being rebuilt, and the buffer is uploaded only once.
+		/// The subtextures of the other level are matched with the subtextures of same rectangle inside this level
+		/// </summary>
+		/// <param name="other">Niveau à ajouter (peut être ce niveau) /// Level to add (may be this level)</param>
+		/// <param name="offset">Décalage appliqué aux tuiles ajoutées /// Offset applied to the added tiles</param>
+		/// <exception cref="AtlasException">Une sous-texture utilisée n'existe pas dans ce niveau; rien n'est ajouté /// A used subtexture does not exist inside this level; nothing is added</exception>
+		void append(const Level& other, const sf::Vector2f& offset);
+
+		/// <summary>
+		/// Ajoute des tuiles décrites sans sommets. Les sommets sont construits en un bloc et le tampon n'est téléversé qu'une fois ///
+		/// Adds tiles described without vertexes. Vertexes are built as one block and the buffer is uploaded only once
+		/// </summary>
+		/// <param name="tiles">Tuiles à ajouter /// Tiles to add</param>
+		/// <exception cref="AtlasException">Une sous-texture utilisée n'existe pas dans ce niveau; rien n'est ajouté /// A used subtexture does not exist inside this level; nothing is added</exception>
+		void add(std::span<const TileRecord> tiles);
+
+		/// <summary>
+		/// Retourne la description de chaque tuile, dans l'ordre des index ///
+		/// Returns the description of every tile, in index order
+		/// </summary>
+		std::vector<TileRecord> records() const;
+
+		/// <summary>
+		/// Enregistre les tuiles dans un fichier (voir LevelFile). La texture et les sous-textures ne sont pas enregistrées ///
+		/// Saves the tiles into a file (see LevelFile). The texture and the subtextures are not saved
+		/// </summary>
+		/// <param name="path">Chemin du fichier /// File path</param>
+		/// <param name="encoding">Encodage des tuiles /// Tiles encoding</param>
+		void save(const std::string& path, LevelFile::Encoding encoding = LevelFile::Encoding::compact) const;
+
+		/// <summary>
+		/// Remplace les tuiles par celles d'un fichier écrit par save. La texture doit déjà être chargée ///
+		/// Replaces the tiles with those of a file written by save. The texture must already be loaded
+		/// </summary>
+		/// <param name="path">Chemin du fichier /// File path</param>
+		void load(const std::string& path);
+
+		/// <summary>
+		/// Active ou désactive le journal des tuiles modifiées et ajoutées, vidé dans les deux cas. À activer juste après save ou load
+		/// du fichier qui recevra le journal. Une tuile modifiée plusieurs fois n'y figure qu'une fois, avec son dernier état ///
+		/// Enables or disables the journal of the modified and added tiles, emptied in both cases. To enable right after save or load
+		/// of the file that will receive the journal. A tile modified several times appears only once, with its last state
+		/// </summary>
+		/// <param name="enabled">Activer le journal /// Enable the journal</param>
+		void journal(bool enabled);
+
+		/// <summary>
+		/// Retourne le nombre de tuiles en attente dans le journal ///
+		/// Returns the number of tiles waiting inside the journal
+		/// </summary>
+		std::size_t journalSize() const;
+
+		/// <summary>
+		/// Ajoute le journal à la fin du fichier (voir LevelFile::appendChanges), puis le vide : le coût dépend des tuiles modifiées,
+		/// pas de la taille du niveau. load rejoue ensuite les journaux en un seul ajout. Si les tuiles ont été vidées depuis
+		/// (resetTiles, load, loadTexture, restore d'un autre nombre de tuiles), le fichier est réécrit en entier.
+		/// Les modifications faites directement par operator[] ne sont pas suivies ///
+		/// Appends the journal at the end of the file (see LevelFile::appendChanges), then empties it: the cost depends on the modified tiles,
+		/// not on the level size. load then replays the journals as a single addition. If the tiles were emptied since
+		/// (resetTiles, load, loadTexture, restore of another tile count), the file is written again entirely.
+		/// Changes made straight through operator[] are not tracked
+		/// </summary>
+		/// <param name="path">Fichier écrit par save, à jour au moment de l'activation du journal /// File written by save, up to date when the journal was enabled</param>
+		/// <param name="encoding">Encodage si le fichier est réécrit /// Encoding if the file is written again</param>
+		void saveJournal(const std::string& path, LevelFile::Encoding encoding = LevelFile::Encoding::compact);
+
+		/// <summary>
+		/// Enregistre l'image de l'atlas, les sous-textures et les tuiles dans un seul paquet .optb (voir LevelBundle) ///
+		/// Saves the atlas image, the subtextures and the tiles inside a single .optb bundle (see LevelBundle)
+		/// </summary>
+		/// <param name="path">Chemin du paquet /// Bundle path</param>
+		/// <param name="imagePath">Fichier image de la texture, copié tel quel /// Image file of the texture, copied as is</param>
+		/// <param name="encoding">Encodage des tuiles /// Tiles encoding</param>
+		void saveBundle(const std::string& path, const std::string& imagePath, LevelFile::Encoding encoding = LevelFile::Encoding::compact) const;
+
+		/// <summary>
+		/// Remplace la texture, les sous-textures et les tuiles par celles d'un paquet. La texture est décodée directement depuis la projection du fichier ///
+		/// Replaces the texture, the subtextures and the tiles with those of a bundle. The texture is decoded straight from the file mapping
+		/// </summary>
+		/// <param name="path">Chemin du paquet /// Bundle path</param>
+		/// <exception cref="LoadException">Le paquet ou son image ne peut pas être lu; le niveau est intact /// The bundle or its image cannot be read; the level is untouched</exception>
+		/// <exception cref="ParseException">Le paquet n'est pas valide; le niveau est intact /// The bundle is not valid; the level is untouched</exception>
+		void loadBundle(const std::string& path);
+
+		/// <summary>
+		/// Prend une photo des tuiles et des sommets (voir LevelSnapshot). Seuls les morceaux modifiés depuis la photo précédente sont copiés ///
+		/// Takes a snapshot of the tiles and vertexes (see LevelSnapshot). Only the chunks modified since the previous snapshot are copied
+		/// </summary>
+		LevelSnapshot snapshot() const;
+
+		/// <summary>
+		/// Rend les tuiles et les sommets d'une photo. Si les tuiles communes n'ont pas changé de place, seuls les morceaux différents
+		/// sont recopiés et seules les tuiles différentes sont téléversées; les tuiles ajoutées depuis la photo sont retirées, et celles
+		/// retirées depuis sont ajoutées. Sinon, le niveau est reconstruit et les objets dérivés de Tile redeviennent des Tile.
+		/// Dans les deux cas, les tuiles communes gardent leurs colonnes d'attributs, leur couche et leur opacité imposée ///
+		/// Gives back the tiles and vertexes of a snapshot. If the common tiles did not change their place, only the differing chunks
+		/// are copied back and only the differing tiles are uploaded; the tiles added since the snapshot are removed, and the ones
+		/// removed since are added. Otherwise, the level is rebuilt and objects derived from Tile become Tile again.
+		/// In both cases, the common tiles keep their attribute columns, their layer and their forced opacity
+		/// </summary>
+		/// <param name="snapshot">Photo prise par ce niveau, avec les mêmes sous-textures /// Snapshot taken by this level, with the same subtextures</param>
+		void restore(const LevelSnapshot& snapshot);
+
+		/// <summary>
+		/// Ajoute une tuile par cellule non vide d'une grille CSV d'identifiants de sous-textures (voir GridImport).
+		/// Le fichier est projeté en mémoire et analysé en parallèle, puis les sommets sont construits en un bloc et téléversés une fois ///
+		/// Adds one tile per non-empty cell of a CSV grid of subtexture ids (see GridImport).
+		/// The file is mapped into memory and parsed in parallel, then vertexes are built as one block and uploaded once
+		/// </summary>
+		/// <param name="path">Chemin du fichier /// File path</param>
+		/// <param name="cellSize">Taille d'une cellule /// Cell size</param>
+		/// <param name="options">Options de lecture /// Reading options</param>
+		/// <exception cref="AtlasException">Un identifiant n'existe pas dans l'atlas; rien n'est ajouté /// An id does not exist inside the atlas; nothing is added</exception>
+		void importGrid(const std::string& path, const sf::Vector2f& cellSize, const GridImportOptions& options = GridImportOptions());
+
+		/// <summary>
+		/// Range les sommets des tuiles selon la courbe de Morton (ordre Z) du centre des tuiles, pour que les tuiles proches soient voisines dans le tampon.
+		/// Les index des tuiles ne changent pas; seul l'ordre de dessin des tuiles qui se chevauchent peut changer ///
+		/// Stores the vertexes of the tiles along the Morton curve (Z-order) of the tile centres, so close tiles are neighbours inside the buffer.
+		/// Tile indexes do not change; only the drawing order of overlapping tiles may change
+		/// </summary>
+		void optimizeLayout();
+
+		/// <summary>
+		/// Active le rangement automatique : reloadBuffer appelle optimizeLayout lorsque plus d'une tuile sur huit a été ajoutée ou déplacée depuis le dernier rangement ///
+		/// Enables the automatic layout: reloadBuffer calls optimizeLayout when more than one tile out of eight has been added or moved since the last layout
+		/// </summary>
+		void autoOptimizeLayout(bool enabled);
+
+		/// <summary>
+		/// Retourne les plages de sommets [début, nombre] des tuiles qui touchent la zone, triées et fusionnées lorsqu'elles se suivent dans le tampon.
+		/// Les tuiles cachées par la passe d'occlusion sont omises. Tant que culling est actif, les tuiles sont cherchées dans une grille de cellules plutôt que dans tout le niveau ///
+		/// Returns the vertex ranges [begin, count] of the tiles touching the area, sorted and merged when they follow each other inside the buffer.
+		/// The tiles hidden by the occlusion pass are left out. While culling is enabled, the tiles are searched inside a grid of cells instead of going through the whole level
+		/// </summary>
+		/// <param name="area">Zone dans les coordonnées du niveau /// Area in level coordinates</param>
+		std::vector<std::pair<std::size_t, std::size_t>> vertexRanges(const sf::FloatRect& area) const;
+
+		/// <summary>
+		/// Ne dessine que les tuiles visibles dans la vue de la cible, en un appel par plage de sommets contiguë (sf::VertexBuffer seulement; la rotation de la vue est ignorée).
+		/// Les tuiles sont rangées dans une grille de cellules tant que l'option est active, pour ne chercher que dans les cellules de la vue ///
+		/// Only draws the tiles visible inside the target's view, with one call per contiguous vertex range (sf::VertexBuffer only; view rotation is ignored).
+		/// Tiles are stored inside a grid of cells while the option is enabled, to only search the cells of the view
+		/// </summary>
+		void culling(bool enabled);
+
+		/// <summary>
+		/// Ajoute une colonne d'attributs (type de collision, vie, propriétaire...), une valeur par tuile rangée de façon contiguë.
+		/// La colonne suit les ajouts de tuiles et remplace un type dérivé de Tile lu par derivedPointer ///
+		/// Adds an attribute column (collision type, health, owner...), one value per tile stored contiguously.
+		/// The column follows the tile additions and replaces a type derived from Tile read through derivedPointer
+		/// </summary>
+		/// <typeparam name="T">Type des valeurs (bool n'est pas permis, utiliser std::uint8_t) /// Type of the values (bool is not allowed, use std::uint8_t)</typeparam>
+		/// <param name="name">Nom de la colonne /// Name of the column</param>
+		/// <returns>Valeurs indexées par tuile; vide si le nom est déjà pris par un autre type /// Values indexed by tile; empty if the name is already used by another type</returns>
+		template <class T>
+		std::span<T> addColumn(const std::string& name);
+
+		/// <summary>
+		/// Retourne les valeurs d'une colonne d'attributs, indexées par tuile. Valides jusqu'au prochain ajout de tuile ///
+		/// Returns the values of an attribute column, indexed by tile. Valid until the next tile addition
+		/// </summary>
+		/// <typeparam name="T">Type des valeurs /// Type of the values</typeparam>
+		/// <param name="name">Nom de la colonne /// Name of the column</param>
+		/// <returns>Si vide, la colonne n'existe pas ou n'est pas de ce type /// If empty, the column does not exist or is not this type</returns>
+		template <class T>
+		std::span<T> column(const std::string& name);
+
+		template <class T>
+		std::span<const T> column(const std::string& name) const;
+
+		/// <summary>
+		/// Retire une colonne d'attributs ///
+		/// Removes an attribute column
+		/// </summary>
+		/// <param name="name">Nom de la colonne /// Name of the column</param>
+		void removeColumn(const std::string& name);
+
+		/// <summary>
+		/// Active la passe d'occlusion : les tuiles entièrement couvertes par une tuile opaque dessinée après elles ne sont pas dessinées (sf::VertexBuffer seulement).
+		/// Les sous-textures opaques sont détectées à partir de l'alpha de la texture, et seules les tuiles touchées par un changement sont réévaluées ///
+		/// Enables the occlusion pass: the tiles entirely covered by an opaque tile drawn after them are not drawn (sf::VertexBuffer only).
+		/// Opaque subtextures are detected from the alpha of the texture, and only the tiles touched by a change are evaluated again
+		/// </summary>
+		void occlusionCulling(bool enabled);
+
+		/// <summary>
+		/// Impose l'opacité d'une tuile, au lieu de celle détectée à partir de la texture ///
+		/// Forces the opacity of a tile, instead of the one detected from the texture
+		/// </summary>
+		/// <param name="opaque">La tuile cache ce qui est dessous /// The tile hides what is under it</param>
+		/// <param name="index">Index de la tuile /// Tile index</param>
+		void setOpaque(bool opaque, std::size_t index);
+
+		/// <summary>
+		/// Redonne à une tuile l'opacité détectée à partir de la texture ///
+		/// Gives back to a tile the opacity detected from the texture
+		/// </summary>
+		/// <param name="index">Index de la tuile /// Tile index</param>
+		void resetOpaque(std::size_t index);
+
+		/// <summary>
+		/// Indique si la passe d'occlusion cache une tuile ///
+		/// Tells if the occlusion pass hides a tile
+		/// </summary>
+		/// <param name="index">Index de la tuile /// Tile index</param>
+		bool isOccluded(std::size_t index) const;
+
+		/// <summary>
+		/// Ajoute une couche nommée par-dessus les autres. La première couche ajoutée crée aussi la couche "base", qui reçoit toutes les tuiles existantes et ajoutées.
+		/// Une fois les couches créées, le niveau est dessiné couche par couche, sauf avec le cache statique ou le rendu instancié ///
+		/// Adds a named layer over the others. The first added layer also creates the "base" layer, which receives every existing and added tile.
+		/// Once layers are created, the level is drawn layer by layer, except with the static cache or instanced rendering
+		/// </summary>
+		/// <param name="name">Nom de la couche /// Name of the layer</param>
+		void addLayer(const std::string& name);
+
+		/// <summary>
+		/// Déplace une tuile au-dessus des autres tuiles d'une couche. Le coût dépend de la taille de la tuile seulement. Une couche inconnue est ignorée ///
+		/// Moves a tile over the other tiles of a layer. The cost depends only on the size of the tile. An unknown layer is ignored
+		/// </summary>
+		/// <param name="layer">Nom de la couche /// Name of the layer</param>
+		/// <param name="index">Index de la tuile /// Tile index</param>
+		void setLayer(const std::string& layer, std::size_t index);
+
+		/// <summary>
+		/// Montre ou cache une couche, sans toucher à ses sommets ///
+		/// Shows or hides a layer, without touching its vertexes
+		/// </summary>
+		/// <param name="layer">Nom de la couche /// Name of the layer</param>
+		/// <param name="visible">La couche est dessinée /// The layer is drawn</param>
+		void layerVisible(const std::string& layer, bool visible);
+
+		/// <summary>
+		/// Garde les tuiles d'une couche triées selon bottomLeftCorner().y, pour les vues de dessus où les objets plus bas passent devant.
+		/// Après move ou setPosition, seule la tuile déplacée est remise en place par échanges avec ses voisines, et seules les plages échangées sont téléversées ///
+		/// Keeps the tiles of a layer sorted by bottomLeftCorner().y, for top-down views where lower objects go in front.
+		/// After move or setPosition, only the moved tile is put back in place by swaps with its neighbours, and only the swapped ranges are uploaded
+		/// </summary>
+		/// <param name="layer">Nom de la couche /// Name of the layer</param>
+		/// <param name="sorted">La couche est triée /// The layer is sorted</param>
+		void layerYSorted(const std::string& layer, bool sorted);
+
+		/// <summary>
+		/// Retourne le nom de la couche d'une tuile, vide s'il n'y a pas de couches ///
+		/// Returns the name of the layer of a tile, empty if there are no layers
+		/// </summary>
+		/// <param name="index">Index de la tuile /// Tile index</param>
+		std::string layerOf(std::size_t index) const;
+
+		/// <summary>
+		/// Montre ou cache une tuile sans toucher à ses sommets (brouillard de guerre). Le tampon graphique reçoit des sommets dégénérés pour la tuile,
+		/// et draw choisit à chaque image entre un dessin unique et un dessin par plage de tuiles montrées, selon ce qui soumet le moins de sommets ///
+		/// Shows or hides a tile without touching its vertexes (fog of war). The GPU buffer receives degenerate vertexes for the tile,
+		/// and draw chooses at each frame between a single draw and one draw per range of shown tiles, whichever submits fewer vertexes
+		/// </summary>
+		/// <param name="index">Index de la tuile /// Tile index</param>
+		/// <param name="visible">La tuile est dessinée /// The tile is drawn</param>
+		void setVisible(std::size_t index, bool visible);
+
+		/// <summary>
+		/// Montre ou cache plusieurs tuiles, avec un seul téléversement pour l'ensemble ///
+		/// Shows or hides several tiles, with a single upload for the whole set
+		/// </summary>
+		/// <param name="indexes">Index des tuiles /// Tile indexes</param>
+		/// <param name="visible">Les tuiles sont dessinées /// The tiles are drawn</param>
+		void setVisible(std::span<const std::size_t> indexes, bool visible);
+
+		bool isVisible(std::size_t index) const;
 	};
 
 	template <class T>
@@ -528,6 +1274,38 @@ namespace opt
 	{
 		return dynamic_cast<T*>(m_tiles[index].get());
 	}
+
+	template <typename Id, std::size_t N>
+	inline void opt::Level::loadTexture(const std::string& path, const AtlasDescriptor<Id, N>& atlas)
+	{
+		std::vector<sf::FloatRect> sousTextures{ atlas.subTextures() };
+		loadTexture(path, sousTextures);
+	}
+
+	template <typename Id, std::size_t N>
+	inline void opt::Level::loadTexture(const sf::Texture& texture, const AtlasDescriptor<Id, N>& atlas)
+	{
+		std::vector<sf::FloatRect> sousTextures{ atlas.subTextures() };
+		loadTexture(texture, sousTextures);
+	}
+
+	template <class T>
+	inline std::span<T> opt::Level::addColumn(const std::string& name)
+	{
+		return m_columns.add<T>(name);
+	}
+
+	template <class T>
+	inline std::span<T> opt::Level::column(const std::string& name)
+	{
+		return m_columns.get<T>(name);
+	}
+
+	template <class T>
+	inline std::span<const T> opt::Level::column(const std::string& name) const
+	{
+		return m_columns.get<T>(name);
+	}
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "pch.h"
+#include "LevelBuilder.h"
+#include "Level.h"
+#include "Exceptions.h"
+#include <algorithm>
+#include <span>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Sommets par tampon d'aperçu, et par tranche du téléversement final ///
+	// Vertexes per preview buffer, and per slice of the final upload
+	constexpr std::size_t segmentVertexes{ 65536 };
+	// Taille de la première tranche, avant toute mesure ///
+	// Size of the first slice, before any measure
+	constexpr std::size_t firstSlice{ 256 };
+	// Une tranche plus petite coûte surtout en mesures d'horloge ///
+	// A smaller slice mostly costs clock reads
+	constexpr std::size_t minimumSlice{ 64 };
+}
+
+opt::LevelBuilder::LevelBuilder(Level& level, std::vector<TileRecord> tiles) : m_level{ level }, m_tiles{ std::move(tiles) }, m_nextTile{ 0 }, m_firstVertex{ level.m_vertexes.size() }, m_autoUpdate{ level.m_autoUpdate }, m_done{ false }, m_nsPerTile{ 0.0 }, m_previewVertexes{ 0 }, m_final{ sf::Triangles, sf::VertexBuffer::Dynamic }, m_finalVertexes{ 0 }, m_finalCreated{ false }
+{
+	// Les sous-textures sont vérifiées avant toute modification, et les vecteurs du niveau ne sont agrandis qu'une fois :
+	// une réallocation au milieu de la construction coûterait une copie de tout le niveau dans une seule tranche ///
+	// Subtextures are checked before any change, and the vectors of the level grow only once:
+	// a reallocation in the middle of the construction would cost a copy of the whole level inside a single slice
+	std::size_t sommets{ 0 };
+	for (const TileRecord& tuile : m_tiles)
+	{
+		const sf::FloatRect* sousTexture{ nullptr };
+		if (tuile.rect.getSize() != sf::Vector2f())
+		{
+			if (tuile.subTexture < 0 || tuile.subTexture >= static_cast<int>(m_level.m_subTextures.size()))
+				throw AtlasException(tuile.subTexture);
+			sousTexture = &m_level.m_subTextures[tuile.subTexture];
+		}
+		sommets += Tile::vertexCount(tuile.rect, sousTexture, Tile::resolvedScale(tuile.rect, sousTexture, tuile.textureRule, tuile.scale));
+	}
+	m_level.m_vertexes.reserve(m_firstVertex + sommets);
+	m_level.m_beginTileIndex.reserve(m_level.m_tiles.size() + m_tiles.size());
+	m_level.m_tiles.reserve(m_level.m_tiles.size() + m_tiles.size());
+	m_level.m_autoUpdate = false;
+}
+
+opt::LevelBuilder::~LevelBuilder()
+{
+	if (m_done)
+		return;
+	m_level.m_autoUpdate = m_autoUpdate;
+	if (m_autoUpdate && m_level.usesVertexBuffer() && m_nextTile)
+	{
+		m_level.reloadBuffer();
+		if (m_level.m_useStaticCache)
+			m_level.m_staticCache.invalidate();
+	}
+}
+
+bool opt::LevelBuilder::step(std::chrono::microseconds budget)
+{
+	if (m_done)
+		return true;
+	const Clock::time_point debut{ Clock::now() };
+	const Clock::time_point fin{ debut + budget };
+
+	while (m_nextTile < m_tiles.size())
+	{
+		const Clock::time_point maintenant{ Clock::now() };
+		if (maintenant >= fin)
+			break;
+		std::size_t tranche{ firstSlice };
+		if (m_nsPerTile > 0.0)
+		{
+			const double restant{ std::chrono::duration<double, std::nano>(fin - maintenant).count() };
+			tranche = std::max(minimumSlice, static_cast<std::size_t>(restant / m_nsPerTile));
+		}
+		tranche = std::min(tranche, m_tiles.size() - m_nextTile);
+
+		m_level.add(std::span<const TileRecord>(m_tiles).subspan(m_nextTile, tranche));
+		m_nextTile += tranche;
+
+		// Moyenne mobile : une tranche lente isolée ne fait pas s'effondrer les suivantes ///
+		// Moving average: a single slow slice does not make the next ones collapse
+		const double mesure{ std::chrono::duration<double, std::nano>(Clock::now() - maintenant).count() / static_cast<double>(tranche) };
+		m_nsPerTile = m_nsPerTile > 0.0 ? m_nsPerTile * 0.75 + mesure * 0.25 : mesure;
+	}
+	uploadPreview();
+	if (m_nextTile < m_tiles.size())
+		return false;
+
+	if (!m_autoUpdate || !m_level.usesVertexBuffer())
+	{
+		finish();
+		return true;
+	}
+	// Ces modes ne dessinent pas directement les sommets du niveau : leur tampon est rechargé d'un coup ///
+	// These modes do not draw the level's vertexes directly: their buffer is reloaded at once
+	if (m_level.m_usePacked || m_level.m_hiddenCount || m_level.m_autoLayout || !sf::VertexBuffer::isAvailable())
+	{
+		m_level.reloadBuffer();
+		finish();
+		return true;
+	}
+
+	const std::size_t total{ m_level.m_vertexes.size() };
+	if (!m_finalCreated)
+	{
+		m_final.setUsage(m_level.m_renderVertexes.getUsage());
+		m_final.create(total);
+		m_finalCreated = true;
+	}
+	while (m_finalVertexes < total && Clock::now() < fin)
+	{
+		const std::size_t nombre{ std::min(segmentVertexes, total - m_finalVertexes) };
+		m_final.update(m_level.m_vertexes.data() + m_finalVertexes, nombre, static_cast<unsigned>(m_finalVertexes));
+		m_finalVertexes += nombre;
+		OPTTILE_STAT(m_level.m_stats.uploadedVertexes += nombre);
+		OPTTILE_STAT(m_level.m_stats.uploadedBytes += nombre * sizeof(sf::Vertex));
+	}
+	if (m_finalVertexes < total)
+		return false;
+
+	m_level.adoptBuffer(m_final);
+	finish();
+	return true;
+}
+
+void opt::LevelBuilder::uploadPreview()
+{
+	if (!m_level.usesVertexBuffer() || !sf::VertexBuffer::isAvailable())
+		return;
+	const std::size_t construits{ m_level.m_vertexes.size() - m_firstVertex };
+	while (m_previewVertexes < construits)
+	{
+		const std::size_t segment{ m_previewVertexes / segmentVertexes };
+		const std::size_t decalage{ m_previewVertexes % segmentVertexes };
+		if (segment == m_preview.size())
+		{
+			m_preview.emplace_back(sf::Triangles, sf::VertexBuffer::Stream);
+			m_preview.back().create(segmentVertexes);
+		}
+		const std::size_t nombre{ std::min(segmentVertexes - decalage, construits - m_previewVertexes) };
+		m_preview[segment].update(m_level.m_vertexes.data() + m_firstVertex + m_previewVertexes, nombre, static_cast<unsigned>(decalage));
+		m_previewVertexes += nombre;
+		OPTTILE_STAT(m_level.m_stats.uploadedVertexes += nombre);
+		OPTTILE_STAT(m_level.m_stats.uploadedBytes += nombre * sizeof(sf::Vertex));
+	}
+}
+
+void opt::LevelBuilder::finish()
+{
+	m_level.m_autoUpdate = m_autoUpdate;
+	// Les cellules rendues pendant la construction l'ont été à partir de l'ancien tampon ///
+	// The cells rendered during the construction were rendered from the old buffer
+	if (m_level.m_useStaticCache)
+		m_level.m_staticCache.invalidate();
+	m_preview.clear();
+	m_previewVertexes = 0;
+	m_final = sf::VertexBuffer(sf::Triangles, sf::VertexBuffer::Dynamic);
+	m_done = true;
+}
+
+bool opt::LevelBuilder::done() const
+{
+	return m_done;
+}
+
+std::size_t opt::LevelBuilder::builtTiles() const
+{
+	return m_nextTile;
+}
+
+std::size_t opt::LevelBuilder::totalTiles() const
+{
+	return m_tiles.size();
+}
+
+void opt::LevelBuilder::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	states.texture = &m_level.m_texture;
+	std::size_t restants{ m_previewVertexes };
+	for (const sf::VertexBuffer& tampon : m_preview)
+	{
+		const std::size_t nombre{ std::min(restants, segmentVertexes) };
+		target.draw(tampon, 0, nombre, states);
+		OPTTILE_STAT(++m_level.m_stats.drawCalls);
+		OPTTILE_STAT(m_level.m_stats.submittedVertexes += nombre);
+		restants -= nombre;
+	}
+}
@@ -0,0 +1,107 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef LEVELBUILDER_H
+#define LEVELBUILDER_H
+
+#include "OptTile.h"
+#include "LevelFile.h"
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	class Level;
+
+	/// <summary>
+	/// Construction d'un niveau répartie sur plusieurs images. Chaque appel à step ajoute des tuiles et construit leurs sommets
+	/// jusqu'à épuiser son budget de temps, puis téléverse seulement les nouveaux sommets dans un aperçu dessinable.
+	/// Une fois toutes les tuiles ajoutées, le tampon final du niveau est lui aussi rempli par tranches, puis échangé d'un coup.
+	/// Le niveau ne doit pas être modifié pendant la construction ///
+	/// Construction of a level spread over several frames. Each call to step adds tiles and builds their vertexes
+	/// until its time budget is spent, then uploads only the new vertexes into a drawable preview.
+	/// Once every tile is added, the final buffer of the level is filled by slices too, then swapped at once.
+	/// The level must not be modified during the construction
+	/// </summary>
+	class OPTTILE_API LevelBuilder : public sf::Drawable {
+	private:
+		Level& m_level;
+		std::vector<TileRecord> m_tiles;
+		// Prochaine tuile à ajouter /// Next tile to add
+		std::size_t m_nextTile;
+		// Premier sommet construit par ce constructeur dans le niveau /// First vertex built by this builder inside the level
+		std::size_t m_firstVertex;
+		// Mise à jour automatique du tampon du niveau, suspendue pendant la construction ///
+		// Automatic update of the level's buffer, suspended during the construction
+		bool m_autoUpdate;
+		bool m_done;
+		// Estimation du temps d'ajout d'une tuile, ajustée à chaque tranche /// Estimate of the time to add one tile, adjusted at each slice
+		double m_nsPerTile;
+		// Aperçu : tampons de taille fixe remplis l'un après l'autre, jamais recréés /// Preview: fixed-size buffers filled one after the other, never created again
+		std::vector<sf::VertexBuffer> m_preview;
+		std::size_t m_previewVertexes;
+		// Tampon final du niveau et nombre de sommets déjà téléversés dedans /// Final buffer of the level and number of vertexes already uploaded into it
+		sf::VertexBuffer m_final;
+		std::size_t m_finalVertexes;
+		bool m_finalCreated;
+
+		void uploadPreview();
+
+		/// <summary>
+		/// Termine la construction : rend la mise à jour automatique au niveau et libère l'aperçu ///
+		/// Ends the construction: gives back automatic update to the level and frees the preview
+		/// </summary>
+		void finish();
+
+	public:
+		/// <summary>
+		/// Prépare la construction, sans rien ajouter au niveau ///
+		/// Prepares the construction, without adding anything to the level
+		/// </summary>
+		/// <param name="level">Niveau qui reçoit les tuiles, qui doit vivre plus longtemps que le constructeur /// Level receiving the tiles, which must outlive the builder</param>
+		/// <param name="tiles">Tuiles à ajouter, dans l'ordre /// Tiles to add, in order</param>
+		/// <exception cref="AtlasException">Une sous-texture utilisée n'existe pas dans ce niveau; rien n'est ajouté /// A used subtexture does not exist inside this level; nothing is added</exception>
+		LevelBuilder(Level& level, std::vector<TileRecord> tiles);
+
+		LevelBuilder(const LevelBuilder&) = delete;
+
+		LevelBuilder& operator=(const LevelBuilder&) = delete;
+
+		/// <summary>
+		/// Une construction interrompue garde les tuiles déjà ajoutées et téléverse le niveau une fois ///
+		/// An interrupted construction keeps the tiles already added and uploads the level once
+		/// </summary>
+		~LevelBuilder();
+
+		/// <summary>
+		/// Avance la construction pendant au plus le budget donné. Une tranche commencée est toujours terminée ///
+		/// Moves the construction forward for at most the given budget. A started slice is always finished
+		/// </summary>
+		/// <returns>Vrai lorsque la construction est terminée /// True when the construction is over</returns>
+		bool step(std::chrono::microseconds budget);
+
+		bool done() const;
+
+		std::size_t builtTiles() const;
+
+		std::size_t totalTiles() const;
+
+		/// <summary>
+		/// Dessine les tuiles déjà construites qui ne sont pas encore dans le tampon du niveau. À dessiner juste après le niveau ///
+		/// Draws the tiles already built which are not inside the level's buffer yet. To draw right after the level
+		/// </summary>
+		virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+	};
+}
+
+#endif // !LEVELBUILDER_H
@@ -0,0 +1,141 @@
+#include "pch.h"
+#include "LevelBundle.h"
+#include "Exceptions.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+
+namespace
+{
+	constexpr char magic[4]{ 'O', 'P', 'T', 'B' };
+	constexpr std::uint32_t version{ 1 };
+	// Image, sous-textures, tuiles /// Image, subtextures, tiles
+	constexpr std::size_t sectionCount{ 3 };
+	constexpr std::size_t headerSize{ 8 + sectionCount * 16 };
+	constexpr std::size_t subTextureSize{ 16 };
+
+	void putU32(std::vector<char>& sortie, std::uint32_t valeur)
+	{
+		for (int i{ 0 }; i < 4; ++i)
+			sortie.push_back(static_cast<char>((valeur >> (8 * i)) & 0xFF));
+	}
+
+	void putU64(std::vector<char>& sortie, std::uint64_t valeur)
+	{
+		putU32(sortie, static_cast<std::uint32_t>(valeur));
+		putU32(sortie, static_cast<std::uint32_t>(valeur >> 32));
+	}
+
+	std::uint32_t getU32(const char* donnees)
+	{
+		std::uint32_t valeur{ 0 };
+		for (int i{ 0 }; i < 4; ++i)
+			valeur |= static_cast<std::uint32_t>(static_cast<unsigned char>(donnees[i])) << (8 * i);
+		return valeur;
+	}
+
+	std::uint64_t getU64(const char* donnees)
+	{
+		return getU32(donnees) | (static_cast<std::uint64_t>(getU32(donnees + 4)) << 32);
+	}
+}
+
+opt::LevelBundle::LevelBundle(const std::string& path) : m_file{ path }
+{
+	// Tout le fichier sert : le lire d'un bloc évite une lecture par page sur un disque lent ou un partage réseau ///
+	// The whole file is used: reading it as one block avoids one read per page on a slow disk or a network share
+	m_file.prefetch();
+	const char* donnees{ m_file.data() };
+	const std::size_t taille{ m_file.size() };
+	if (taille < headerSize || !std::equal(std::begin(magic), std::end(magic), donnees))
+		throw ParseException("bundle header");
+	if (getU32(donnees + 4) != version)
+		throw ParseException("bundle version " + std::to_string(getU32(donnees + 4)));
+
+	std::span<const char>* sections[sectionCount]{ &m_image, &m_subTextures, &m_tiles };
+	for (std::size_t i{ 0 }; i < sectionCount; ++i)
+	{
+		const std::uint64_t debut{ getU64(donnees + 8 + i * 16) };
+		const std::uint64_t longueur{ getU64(donnees + 16 + i * 16) };
+		if (debut > taille || longueur > taille - debut)
+			throw ParseException("bundle section " + std::to_string(i));
+		*sections[i] = std::span<const char>(donnees + debut, static_cast<std::size_t>(longueur));
+	}
+	if (m_subTextures.size() % subTextureSize)
+		throw ParseException("bundle subtextures");
+}
+
+std::span<const char> opt::LevelBundle::image() const
+{
+	return m_image;
+}
+
+std::vector<sf::FloatRect> opt::LevelBundle::subTextures() const
+{
+	std::vector<sf::FloatRect> sousTextures(m_subTextures.size() / subTextureSize);
+	for (std::size_t i{ 0 }; i < sousTextures.size(); ++i)
+	{
+		const char* donnees{ m_subTextures.data() + i * subTextureSize };
+		sousTextures[i] = sf::FloatRect(std::bit_cast<float>(getU32(donnees)), std::bit_cast<float>(getU32(donnees + 4)),
+			std::bit_cast<float>(getU32(donnees + 8)), std::bit_cast<float>(getU32(donnees + 12)));
+	}
+	return sousTextures;
+}
+
+std::vector<opt::TileRecord> opt::LevelBundle::tiles() const
+{
+	std::vector<TileRecord> tuiles{ LevelFile::read(m_tiles) };
+	const int nbSousTextures{ static_cast<int>(m_subTextures.size() / subTextureSize) };
+	for (const TileRecord& tuile : tuiles)
+		if (tuile.rect.getSize() != sf::Vector2f() && (tuile.subTexture < 0 || tuile.subTexture >= nbSousTextures))
+			throw AtlasException(tuile.subTexture);
+	return tuiles;
+}
+
+void opt::LevelBundle::write(std::ostream& stream, std::span<const char> image, const std::vector<sf::FloatRect>& subTextures,
+	const std::vector<TileRecord>& tiles, LevelFile::Encoding encoding)
+{
+	std::ostringstream niveau;
+	LevelFile::write(niveau, tiles, encoding);
+	const std::string tuiles{ niveau.str() };
+
+	std::vector<char> sousTextures;
+	sousTextures.reserve(subTextures.size() * subTextureSize);
+	for (const sf::FloatRect& rectangle : subTextures)
+	{
+		putU32(sousTextures, std::bit_cast<std::uint32_t>(rectangle.left));
+		putU32(sousTextures, std::bit_cast<std::uint32_t>(rectangle.top));
+		putU32(sousTextures, std::bit_cast<std::uint32_t>(rectangle.width));
+		putU32(sousTextures, std::bit_cast<std::uint32_t>(rectangle.height));
+	}
+
+	std::vector<char> entete(std::begin(magic), std::end(magic));
+	putU32(entete, version);
+	const std::size_t tailles[sectionCount]{ image.size(), sousTextures.size(), tuiles.size() };
+	std::uint64_t position{ headerSize };
+	for (std::size_t taille : tailles)
+	{
+		putU64(entete, position);
+		putU64(entete, taille);
+		position += taille;
+	}
+
+	stream.write(entete.data(), static_cast<std::streamsize>(entete.size()));
+	stream.write(image.data(), static_cast<std::streamsize>(image.size()));
+	stream.write(sousTextures.data(), static_cast<std::streamsize>(sousTextures.size()));
+	stream.write(tuiles.data(), static_cast<std::streamsize>(tuiles.size()));
+}
+
+void opt::LevelBundle::save(const std::string& path, std::span<const char> image, const std::vector<sf::FloatRect>& subTextures,
+	const std::vector<TileRecord>& tiles, LevelFile::Encoding encoding)
+{
+	std::ofstream fichier{ path, std::ios::binary | std::ios::trunc };
+	if (!fichier)
+		throw LoadException(path);
+	write(fichier, image, subTextures, tiles, encoding);
+	if (!fichier)
+		throw LoadException(path);
+}
@@ -0,0 +1,88 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef LEVELBUNDLE_H
+#define LEVELBUNDLE_H
+
+#include "OptTile.h"
+#include "LevelFile.h"
+#include "MappedFile.h"
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	/// <summary>
+	/// Paquet .optb : l'image compressée de l'atlas, la table des sous-textures et les tuiles (voir LevelFile) dans un seul fichier.
+	/// Un en-tête ("OPTB", version, puis position et taille de chaque section) est suivi des sections dans leur ordre de lecture,
+	/// pour que le chargement soit une seule lecture séquentielle. Le fichier est projeté en mémoire et lu sans copie intermédiaire ///
+	/// .optb bundle: the compressed atlas image, the subtexture table and the tiles (see LevelFile) inside a single file.
+	/// A header ("OPTB", version, then offset and size of each section) is followed by the sections in reading order,
+	/// so that loading is a single sequential read. The file is mapped into memory and read without intermediate copy
+	/// </summary>
+	class OPTTILE_API LevelBundle {
+	private:
+		MappedFile m_file;
+		std::span<const char> m_image;
+		std::span<const char> m_subTextures;
+		std::span<const char> m_tiles;
+
+	public:
+		/// <summary>
+		/// Projette un paquet et demande au système de le lire en entier d'avance ///
+		/// Maps a bundle and asks the system to read it entirely ahead
+		/// </summary>
+		/// <exception cref="LoadException">Le fichier ne peut pas être ouvert /// The file cannot be opened</exception>
+		/// <exception cref="ParseException">Le fichier n'est pas un paquet valide /// The file is not a valid bundle</exception>
+		LevelBundle(const std::string& path);
+
+		LevelBundle(const LevelBundle&) = delete;
+
+		LevelBundle& operator=(const LevelBundle&) = delete;
+
+		/// <summary>
+		/// Octets de l'image compressée, tels que dans le fichier d'origine, à passer à sf::Texture::loadFromMemory ///
+		/// Bytes of the compressed image, as inside the original file, to give to sf::Texture::loadFromMemory
+		/// </summary>
+		std::span<const char> image() const;
+
+		std::vector<sf::FloatRect> subTextures() const;
+
+		/// <summary>
+		/// Décode les tuiles directement depuis la projection ///
+		/// Decodes the tiles straight from the mapping
+		/// </summary>
+		/// <exception cref="ParseException">Les tuiles ne sont pas valides /// The tiles are not valid</exception>
+		/// <exception cref="AtlasException">Une tuile utilise une sous-texture absente du paquet /// A tile uses a subtexture missing from the bundle</exception>
+		std::vector<TileRecord> tiles() const;
+
+		/// <summary>
+		/// Écrit un paquet dans un flux binaire ///
+		/// Writes a bundle into a binary stream
+		/// </summary>
+		/// <param name="image">Fichier image compressé (PNG, JPEG...), copié tel quel /// Compressed image file (PNG, JPEG...), copied as is</param>
+		static void write(std::ostream& stream, std::span<const char> image, const std::vector<sf::FloatRect>& subTextures,
+			const std::vector<TileRecord>& tiles, LevelFile::Encoding encoding = LevelFile::Encoding::compact);
+
+		/// <summary>
+		/// Écrit un paquet dans un fichier, remplacé s'il existe ///
+		/// Writes a bundle into a file, replaced if it exists
+		/// </summary>
+		/// <exception cref="LoadException">Le fichier ne peut pas être ouvert /// The file cannot be opened</exception>
+		static void save(const std::string& path, std::span<const char> image, const std::vector<sf::FloatRect>& subTextures,
+			const std::vector<TileRecord>& tiles, LevelFile::Encoding encoding = LevelFile::Encoding::compact);
+	};
+}
+
+#endif // !LEVELBUNDLE_H
@@ -0,0 +1,700 @@
+#include "pch.h"
+#include "LevelFile.h"
+#include "Exceptions.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <istream>
+#include <ostream>
+
+namespace
+{
+	constexpr char magic[4]{ 'O', 'P', 'T', 'L' };
+	constexpr std::uint32_t version{ 1 };
+	constexpr std::size_t headerSize{ 20 };
+	constexpr std::size_t rawRecordSize{ 33 };
+	// Les tuiles brutes sont lues par blocs, pour ne jamais allouer plus que ce que le flux contient vraiment ///
+	// Raw tiles are read in blocks, to never allocate more than what the stream really holds
+	constexpr std::size_t readBlock{ 65536 };
+
+	constexpr char journalMagic[4]{ 'O', 'P', 'T', 'J' };
+	constexpr std::uint32_t journalVersion{ 1 };
+	constexpr std::size_t journalHeaderSize{ 24 };
+	// Champs présents dans une entrée de journal /// Fields present in a journal entry
+	enum ChangeField : std::uint8_t { positionField = 1, sizeField = 2, subTextureField = 4, ruleField = 8, scaleField = 16, colourField = 32 };
+
+	void putU32(std::vector<char>& sortie, std::uint32_t valeur)
+	{
+		for (int i{ 0 }; i < 4; ++i)
+			sortie.push_back(static_cast<char>((valeur >> (8 * i)) & 0xFF));
+	}
+
+	void putF32(std::vector<char>& sortie, float valeur)
+	{
+		putU32(sortie, std::bit_cast<std::uint32_t>(valeur));
+	}
+
+	std::uint32_t getU32(const char* donnees)
+	{
+		std::uint32_t valeur{ 0 };
+		for (int i{ 0 }; i < 4; ++i)
+			valeur |= static_cast<std::uint32_t>(static_cast<unsigned char>(donnees[i])) << (8 * i);
+		return valeur;
+	}
+
+	float getF32(const char* donnees)
+	{
+		return std::bit_cast<float>(getU32(donnees));
+	}
+
+	std::uint64_t getU64(const char* donnees)
+	{
+		return getU32(donnees) | (static_cast<std::uint64_t>(getU32(donnees + 4)) << 32);
+	}
+
+	// Colonnes de l'encodage compact, dans l'ordre d'écriture /// Columns of the compact encoding, in writing order
+	enum Column : unsigned { subTextureColumn, ruleColumn, leftColumn, topColumn, widthColumn, heightColumn, scaleXColumn, scaleYColumn, colourColumn };
+
+	void putVarint(std::vector<char>& sortie, std::uint64_t valeur)
+	{
+		while (valeur >= 0x80)
+		{
+			sortie.push_back(static_cast<char>(valeur | 0x80));
+			valeur >>= 7;
+		}
+		sortie.push_back(static_cast<char>(valeur));
+	}
+
+	std::uint64_t getVarint(const char*& curseur, const char* fin)
+	{
+		std::uint64_t valeur{ 0 };
+		for (int decalage{ 0 }; decalage < 64; decalage += 7)
+		{
+			if (curseur == fin)
+				throw opt::ParseException("truncated compact level");
+			const std::uint8_t octet{ static_cast<std::uint8_t>(*curseur++) };
+			valeur |= static_cast<std::uint64_t>(octet & 0x7F) << decalage;
+			if (!(octet & 0x80))
+				return valeur;
+		}
+		throw opt::ParseException("compact level varint");
+	}
+
+	std::uint64_t zigzag(std::int64_t valeur)
+	{
+		return (static_cast<std::uint64_t>(valeur) << 1) ^ static_cast<std::uint64_t>(valeur >> 63);
+	}
+
+	std::int64_t unzigzag(std::uint64_t valeur)
+	{
+		return static_cast<std::int64_t>(valeur >> 1) ^ -static_cast<std::int64_t>(valeur & 1);
+	}
+
+	// Clé entière d'un flottant, pour coder les écarts sans perte : le double d'un entier exact, sinon les bits du flottant suivis d'un 1 ///
+	// Integer key of a float, to code differences losslessly: twice an exact integer, otherwise the float bits followed by a 1
+	std::int64_t floatKey(float valeur)
+	{
+		if (valeur == std::trunc(valeur) && std::abs(valeur) < 1073741824.f && !(valeur == 0.f && std::signbit(valeur)))
+			return static_cast<std::int64_t>(valeur) * 2;
+		return (static_cast<std::int64_t>(std::bit_cast<std::uint32_t>(valeur)) << 1) | 1;
+	}
+
+	float keyFloat(std::int64_t cle)
+	{
+		if (cle & 1)
+			return std::bit_cast<float>(static_cast<std::uint32_t>(cle >> 1));
+		return static_cast<float>(cle / 2);
+	}
+
+	/// <summary>
+	/// Écrit une colonne en plages (longueur, symbole) ///
+	/// Writes a column as (length, symbol) runs
+	/// </summary>
+	void putRuns(std::vector<char>& sortie, const std::vector<std::uint64_t>& symboles)
+	{
+		for (std::size_t i{ 0 }; i < symboles.size();)
+		{
+			std::size_t fin{ i + 1 };
+			while (fin < symboles.size() && symboles[fin] == symboles[i])
+				++fin;
+			putVarint(sortie, fin - i);
+			putVarint(sortie, symboles[i]);
+			i = fin;
+		}
+	}
+
+	/// <summary>
+	/// Lit une colonne écrite par putRuns, un symbole à la fois ///
+	/// Reads a column written by putRuns, one symbol at a time
+	/// </summary>
+	struct RunReader {
+		const char* cursor{ nullptr };
+		const char* end{ nullptr };
+		std::uint64_t remaining{ 0 };
+		std::uint64_t symbol{ 0 };
+
+		/// <summary>
+		/// Charge la plage suivante si la plage courante est épuisée ///
+		/// Loads the next run if the current run is exhausted
+		/// </summary>
+		void load()
+		{
+			if (remaining != 0)
+				return;
+			remaining = getVarint(cursor, end);
+			symbol = getVarint(cursor, end);
+			if (remaining == 0)
+				throw opt::ParseException("compact level run");
+		}
+	};
+
+	template <typename Field>
+	void putDeltaColumn(std::vector<char>& sortie, const std::vector<opt::TileRecord>& tuiles, float defaut, Field&& champ)
+	{
+		std::vector<std::uint64_t> symboles(tuiles.size());
+		std::int64_t precedente{ floatKey(defaut) };
+		for (std::size_t i{ 0 }; i < tuiles.size(); ++i)
+		{
+			const std::int64_t cle{ floatKey(champ(tuiles[i])) };
+			symboles[i] = zigzag(cle - precedente);
+			precedente = cle;
+		}
+		putRuns(sortie, symboles);
+	}
+
+	void writeCompact(std::vector<char>& octets, const std::vector<opt::TileRecord>& tuiles)
+	{
+		const opt::TileRecord defaut;
+		unsigned colonnes{ 0 };
+		for (const opt::TileRecord& tuile : tuiles)
+		{
+			colonnes |= (tuile.subTexture != defaut.subTexture) << subTextureColumn;
+			colonnes |= (tuile.textureRule != defaut.textureRule) << ruleColumn;
+			colonnes |= (floatKey(tuile.rect.left) != floatKey(0.f)) << leftColumn;
+			colonnes |= (floatKey(tuile.rect.top) != floatKey(0.f)) << topColumn;
+			colonnes |= (floatKey(tuile.rect.width) != floatKey(0.f)) << widthColumn;
+			colonnes |= (floatKey(tuile.rect.height) != floatKey(0.f)) << heightColumn;
+			colonnes |= (floatKey(tuile.scale.x) != floatKey(defaut.scale.x)) << scaleXColumn;
+			colonnes |= (floatKey(tuile.scale.y) != floatKey(defaut.scale.y)) << scaleYColumn;
+			colonnes |= (tuile.colour != defaut.colour) << colourColumn;
+		}
+		// Au moins une colonne est stockée, pour que le nombre de tuiles soit vérifié sur des données ///
+		// At least one column is stored, so that the tile count is checked against data
+		if (!colonnes && !tuiles.empty())
+			colonnes = 1u << subTextureColumn;
+		putVarint(octets, colonnes);
+
+		// Chaque colonne est précédée de sa taille, pour que la lecture les parcoure toutes en une passe ///
+		// Each column is preceded by its size, so reading walks all of them in one pass
+		std::vector<char> colonne;
+		std::vector<std::uint64_t> symboles(tuiles.size());
+		for (unsigned i{ subTextureColumn }; i <= colourColumn; ++i)
+		{
+			if (!(colonnes & (1u << i)))
+				continue;
+			colonne.clear();
+			switch (i)
+			{
+			case subTextureColumn:
+				for (std::size_t j{ 0 }; j < tuiles.size(); ++j)
+					symboles[j] = zigzag(tuiles[j].subTexture);
+				putRuns(colonne, symboles);
+				break;
+			case ruleColumn:
+				for (std::size_t j{ 0 }; j < tuiles.size(); ++j)
+					symboles[j] = static_cast<std::uint64_t>(tuiles[j].textureRule);
+				putRuns(colonne, symboles);
+				break;
+			case leftColumn:
+				putDeltaColumn(colonne, tuiles, 0.f, [](const opt::TileRecord& tuile) { return tuile.rect.left; });
+				break;
+			case topColumn:
+				putDeltaColumn(colonne, tuiles, 0.f, [](const opt::TileRecord& tuile) { return tuile.rect.top; });
+				break;
+			case widthColumn:
+				putDeltaColumn(colonne, tuiles, 0.f, [](const opt::TileRecord& tuile) { return tuile.rect.width; });
+				break;
+			case heightColumn:
+				putDeltaColumn(colonne, tuiles, 0.f, [](const opt::TileRecord& tuile) { return tuile.rect.height; });
+				break;
+			case scaleXColumn:
+				putDeltaColumn(colonne, tuiles, defaut.scale.x, [](const opt::TileRecord& tuile) { return tuile.scale.x; });
+				break;
+			case scaleYColumn:
+				putDeltaColumn(colonne, tuiles, defaut.scale.y, [](const opt::TileRecord& tuile) { return tuile.scale.y; });
+				break;
+			case colourColumn:
+				for (std::size_t j{ 0 }; j < tuiles.size(); ++j)
+					symboles[j] = tuiles[j].colour.toInteger();
+				putRuns(colonne, symboles);
+				break;
+			}
+			putVarint(octets, colonne.size());
+			octets.insert(octets.end(), colonne.begin(), colonne.end());
+		}
+	}
+
+	void readCompact(const char* curseur, const char* fin, std::size_t count, std::vector<opt::TileRecord>& tuiles)
+	{
+		const std::uint64_t colonnes{ getVarint(curseur, fin) };
+		if (colonnes >> (colourColumn + 1) || (!colonnes && count))
+			throw opt::ParseException("compact level columns");
+		RunReader lecteurs[colourColumn + 1];
+		for (unsigned i{ subTextureColumn }; i <= colourColumn; ++i)
+		{
+			if (!(colonnes & (1u << i)))
+				continue;
+			const std::uint64_t taille{ getVarint(curseur, fin) };
+			if (taille > static_cast<std::uint64_t>(fin - curseur))
+				throw opt::ParseException("truncated compact level");
+			lecteurs[i].cursor = curseur;
+			lecteurs[i].end = curseur + taille;
+			curseur += taille;
+		}
+		const opt::TileRecord defaut;
+		std::int64_t cles[colourColumn + 1]{};
+		cles[scaleXColumn] = floatKey(defaut.scale.x);
+		cles[scaleYColumn] = floatKey(defaut.scale.y);
+
+		// Les tuiles sont décodées par étendues où chaque colonne présente reste dans la même plage :
+		// les valeurs y sont constantes et les écarts aussi ///
+		// Tiles are decoded by spans where every present column stays inside the same run:
+		// values are constant there, and so are differences
+		// Le nombre de tuiles annoncé est vérifié sur une colonne avant de réserver : un en-tête corrompu ne réclame pas une mémoire démesurée ///
+		// The announced tile count is checked against one column before reserving: a corrupted header does not claim an oversized memory
+		for (const RunReader& lecteur : lecteurs)
+		{
+			if (!lecteur.cursor)
+				continue;
+			std::uint64_t total{ 0 };
+			for (const char* position{ lecteur.cursor }; position != lecteur.end;)
+			{
+				const std::uint64_t longueur{ getVarint(position, lecteur.end) };
+				getVarint(position, lecteur.end);
+				if (longueur > count - total)
+					throw opt::ParseException("compact level run");
+				total += longueur;
+			}
+			if (total != count)
+				throw opt::ParseException("compact level run");
+			break;
+		}
+		tuiles.reserve(tuiles.size() + count);
+		for (std::size_t i{ 0 }; i < count;)
+		{
+			std::uint64_t etendue{ count - i };
+			for (unsigned j{ subTextureColumn }; j <= colourColumn; ++j)
+				if (colonnes & (1u << j))
+				{
+					lecteurs[j].load();
+					etendue = std::min(etendue, lecteurs[j].remaining);
+				}
+
+			opt::TileRecord tuile;
+			if (colonnes & (1u << subTextureColumn))
+				tuile.subTexture = static_cast<int>(unzigzag(lecteurs[subTextureColumn].symbol));
+			if (colonnes & (1u << ruleColumn))
+			{
+				if (lecteurs[ruleColumn].symbol > static_cast<std::uint64_t>(opt::TextureRule::fill_space))
+					throw opt::ParseException("texture rule " + std::to_string(lecteurs[ruleColumn].symbol));
+				tuile.textureRule = static_cast<opt::TextureRule>(lecteurs[ruleColumn].symbol);
+			}
+			if (colonnes & (1u << colourColumn))
+				tuile.colour = sf::Color(static_cast<sf::Uint32>(lecteurs[colourColumn].symbol));
+			std::int64_t ecarts[colourColumn + 1]{};
+			for (unsigned j{ leftColumn }; j <= scaleYColumn; ++j)
+				if (colonnes & (1u << j))
+					ecarts[j] = unzigzag(lecteurs[j].symbol);
+			for (unsigned j{ subTextureColumn }; j <= colourColumn; ++j)
+				if (colonnes & (1u << j))
+					lecteurs[j].remaining -= etendue;
+
+			const bool ecartsNuls{ !ecarts[leftColumn] && !ecarts[topColumn] && !ecarts[widthColumn] && !ecarts[heightColumn]
+				&& !ecarts[scaleXColumn] && !ecarts[scaleYColumn] };
+			if (ecartsNuls)
+			{
+				tuile.rect = sf::FloatRect(keyFloat(cles[leftColumn]), keyFloat(cles[topColumn]), keyFloat(cles[widthColumn]), keyFloat(cles[heightColumn]));
+				tuile.scale = sf::Vector2f(keyFloat(cles[scaleXColumn]), keyFloat(cles[scaleYColumn]));
+				tuiles.insert(tuiles.end(), static_cast<std::size_t>(etendue), tuile);
+			}
+			else
+				for (std::uint64_t k{ 0 }; k < etendue; ++k)
+				{
+					for (unsigned j{ leftColumn }; j <= scaleYColumn; ++j)
+						cles[j] += ecarts[j];
+					tuile.rect = sf::FloatRect(keyFloat(cles[leftColumn]), keyFloat(cles[topColumn]), keyFloat(cles[widthColumn]), keyFloat(cles[heightColumn]));
+					tuile.scale = sf::Vector2f(keyFloat(cles[scaleXColumn]), keyFloat(cles[scaleYColumn]));
+					tuiles.push_back(tuile);
+				}
+			i += static_cast<std::size_t>(etendue);
+		}
+		for (const RunReader& lecteur : lecteurs)
+			if (lecteur.remaining != 0 || lecteur.cursor != lecteur.end)
+				throw opt::ParseException("compact level run");
+	}
+
+	std::uint64_t readHeader(const char* entete, std::uint32_t& encodage)
+	{
+		if (!std::equal(std::begin(magic), std::end(magic), entete))
+			throw opt::ParseException("level header");
+		if (getU32(entete + 4) != version)
+			throw opt::ParseException("level version " + std::to_string(getU32(entete + 4)));
+		encodage = getU32(entete + 8);
+		if (encodage != static_cast<std::uint32_t>(opt::LevelFile::Encoding::raw) && encodage != static_cast<std::uint32_t>(opt::LevelFile::Encoding::compact))
+			throw opt::ParseException("level encoding " + std::to_string(encodage));
+		return getU64(entete + 12);
+	}
+
+	opt::TileRecord readRaw(const char* donnees)
+	{
+		opt::TileRecord tuile;
+		tuile.rect = sf::FloatRect(getF32(donnees), getF32(donnees + 4), getF32(donnees + 8), getF32(donnees + 12));
+		tuile.subTexture = static_cast<int>(getU32(donnees + 16));
+		const unsigned char regle{ static_cast<unsigned char>(donnees[20]) };
+		if (regle > static_cast<unsigned char>(opt::TextureRule::fill_space))
+			throw opt::ParseException("texture rule " + std::to_string(regle));
+		tuile.textureRule = static_cast<opt::TextureRule>(regle);
+		tuile.scale = sf::Vector2f(getF32(donnees + 21), getF32(donnees + 25));
+		tuile.colour = sf::Color(static_cast<sf::Uint8>(donnees[29]), static_cast<sf::Uint8>(donnees[30]),
+			static_cast<sf::Uint8>(donnees[31]), static_cast<sf::Uint8>(donnees[32]));
+		return tuile;
+	}
+
+	void putChange(std::vector<char>& sortie, const opt::TileRecord& tuile)
+	{
+		const opt::TileRecord defaut;
+		std::uint8_t champs{ 0 };
+		if (tuile.rect.getPosition() != defaut.rect.getPosition())
+			champs |= positionField;
+		if (tuile.rect.getSize() != defaut.rect.getSize())
+			champs |= sizeField;
+		if (tuile.subTexture != defaut.subTexture)
+			champs |= subTextureField;
+		if (tuile.textureRule != defaut.textureRule)
+			champs |= ruleField;
+		if (tuile.scale != defaut.scale)
+			champs |= scaleField;
+		if (tuile.colour != defaut.colour)
+			champs |= colourField;
+		sortie.push_back(static_cast<char>(champs));
+		if (champs & positionField)
+		{
+			putF32(sortie, tuile.rect.left);
+			putF32(sortie, tuile.rect.top);
+		}
+		if (champs & sizeField)
+		{
+			putF32(sortie, tuile.rect.width);
+			putF32(sortie, tuile.rect.height);
+		}
+		if (champs & subTextureField)
+			putVarint(sortie, zigzag(tuile.subTexture));
+		if (champs & ruleField)
+			sortie.push_back(static_cast<char>(tuile.textureRule));
+		if (champs & scaleField)
+		{
+			putF32(sortie, tuile.scale.x);
+			putF32(sortie, tuile.scale.y);
+		}
+		if (champs & colourField)
+			putU32(sortie, tuile.colour.toInteger());
+	}
+
+	opt::TileRecord getChange(const char*& curseur, const char* fin)
+	{
+		const auto exiger{ [&](std::ptrdiff_t nombre) {
+			if (fin - curseur < nombre)
+				throw opt::ParseException("truncated journal");
+		} };
+		exiger(1);
+		const std::uint8_t champs{ static_cast<std::uint8_t>(*curseur++) };
+		if (champs & ~(positionField | sizeField | subTextureField | ruleField | scaleField | colourField))
+			throw opt::ParseException("journal fields " + std::to_string(champs));
+
+		opt::TileRecord tuile;
+		if (champs & positionField)
+		{
+			exiger(8);
+			tuile.rect.left = getF32(curseur);
+			tuile.rect.top = getF32(curseur + 4);
+			curseur += 8;
+		}
+		if (champs & sizeField)
+		{
+			exiger(8);
+			tuile.rect.width = getF32(curseur);
+			tuile.rect.height = getF32(curseur + 4);
+			curseur += 8;
+		}
+		if (champs & subTextureField)
+			tuile.subTexture = static_cast<int>(unzigzag(getVarint(curseur, fin)));
+		if (champs & ruleField)
+		{
+			exiger(1);
+			const unsigned char regle{ static_cast<unsigned char>(*curseur++) };
+			if (regle > static_cast<unsigned char>(opt::TextureRule::fill_space))
+				throw opt::ParseException("texture rule " + std::to_string(regle));
+			tuile.textureRule = static_cast<opt::TextureRule>(regle);
+		}
+		if (champs & scaleField)
+		{
+			exiger(8);
+			tuile.scale = sf::Vector2f(getF32(curseur), getF32(curseur + 4));
+			curseur += 8;
+		}
+		if (champs & colourField)
+		{
+			exiger(4);
+			tuile.colour = sf::Color(getU32(curseur));
+			curseur += 4;
+		}
+		return tuile;
+	}
+}
+
+void opt::LevelFile::write(std::ostream& stream, const std::vector<TileRecord>& tiles, Encoding encoding)
+{
+	std::vector<char> octets;
+	octets.reserve(headerSize + (encoding == Encoding::raw ? tiles.size() * rawRecordSize : 64));
+	octets.insert(octets.end(), std::begin(magic), std::end(magic));
+	putU32(octets, version);
+	putU32(octets, static_cast<std::uint32_t>(encoding));
+	const std::uint64_t nbTuiles{ tiles.size() };
+	putU32(octets, static_cast<std::uint32_t>(nbTuiles));
+	putU32(octets, static_cast<std::uint32_t>(nbTuiles >> 32));
+	if (encoding == Encoding::compact)
+	{
+		// La taille des données permet de lire le flux sans dépasser les tuiles ///
+		// The data size allows reading the stream without going past the tiles
+		std::vector<char> donnees;
+		writeCompact(donnees, tiles);
+		putU32(octets, static_cast<std::uint32_t>(donnees.size()));
+		putU32(octets, static_cast<std::uint32_t>(static_cast<std::uint64_t>(donnees.size()) >> 32));
+		octets.insert(octets.end(), donnees.begin(), donnees.end());
+		stream.write(octets.data(), static_cast<std::streamsize>(octets.size()));
+		return;
+	}
+	for (const TileRecord& tuile : tiles)
+	{
+		putF32(octets, tuile.rect.left);
+		putF32(octets, tuile.rect.top);
+		putF32(octets, tuile.rect.width);
+		putF32(octets, tuile.rect.height);
+		putU32(octets, static_cast<std::uint32_t>(tuile.subTexture));
+		octets.push_back(static_cast<char>(tuile.textureRule));
+		putF32(octets, tuile.scale.x);
+		putF32(octets, tuile.scale.y);
+		octets.push_back(static_cast<char>(tuile.colour.r));
+		octets.push_back(static_cast<char>(tuile.colour.g));
+		octets.push_back(static_cast<char>(tuile.colour.b));
+		octets.push_back(static_cast<char>(tuile.colour.a));
+	}
+	stream.write(octets.data(), static_cast<std::streamsize>(octets.size()));
+}
+
+void opt::LevelFile::save(const std::string& path, const std::vector<TileRecord>& tiles, Encoding encoding)
+{
+	std::ofstream fichier{ path, std::ios::binary | std::ios::trunc };
+	if (!fichier)
+		throw LoadException(path);
+	write(fichier, tiles, encoding);
+	if (!fichier)
+		throw LoadException(path);
+}
+
+std::vector<opt::TileRecord> opt::LevelFile::read(std::istream& stream)
+{
+	char entete[headerSize];
+	if (!stream.read(entete, headerSize))
+		throw ParseException("level header");
+	std::uint32_t encodage;
+	const std::uint64_t nbTuiles{ readHeader(entete, encodage) };
+
+	std::vector<TileRecord> tuiles;
+	if (encodage == static_cast<std::uint32_t>(Encoding::compact))
+	{
+		char taille[8];
+		if (!stream.read(taille, sizeof(taille)))
+			throw ParseException("truncated compact level");
+		const std::uint64_t nbOctets{ getU64(taille) };
+		std::vector<char> donnees;
+		for (std::uint64_t lus{ 0 }; lus < nbOctets;)
+		{
+			const std::size_t bloc{ static_cast<std::size_t>(std::min<std::uint64_t>(nbOctets - lus, readBlock * rawRecordSize)) };
+			donnees.resize(static_cast<std::size_t>(lus) + bloc);
+			if (!stream.read(donnees.data() + lus, static_cast<std::streamsize>(bloc)))
+				throw ParseException("truncated compact level");
+			lus += bloc;
+		}
+		readCompact(donnees.data(), donnees.data() + donnees.size(), static_cast<std::size_t>(nbTuiles), tuiles);
+		return tuiles;
+	}
+
+	std::vector<char> octets;
+	for (std::uint64_t lues{ 0 }; lues < nbTuiles;)
+	{
+		const std::size_t nbBloc{ static_cast<std::size_t>(std::min<std::uint64_t>(nbTuiles - lues, readBlock)) };
+		octets.resize(nbBloc * rawRecordSize);
+		if (!stream.read(octets.data(), static_cast<std::streamsize>(octets.size())))
+			throw ParseException("truncated level after " + std::to_string(lues) + " tiles");
+		for (std::size_t i{ 0 }; i < nbBloc; ++i)
+		{
+			tuiles.push_back(readRaw(octets.data() + i * rawRecordSize));
+		}
+		lues += nbBloc;
+	}
+	return tuiles;
+}
+
+std::vector<opt::TileRecord> opt::LevelFile::read(std::span<const char> bytes)
+{
+	if (bytes.size() < headerSize)
+		throw ParseException("level header");
+	std::uint32_t encodage;
+	const std::uint64_t nbTuiles{ readHeader(bytes.data(), encodage) };
+	const char* curseur{ bytes.data() + headerSize };
+	const char* fin{ bytes.data() + bytes.size() };
+
+	std::vector<TileRecord> tuiles;
+	if (encodage == static_cast<std::uint32_t>(Encoding::compact))
+	{
+		if (fin - curseur < 8 || getU64(curseur) != static_cast<std::uint64_t>(fin - curseur - 8))
+			throw ParseException("truncated compact level");
+		readCompact(curseur + 8, fin, static_cast<std::size_t>(nbTuiles), tuiles);
+		return tuiles;
+	}
+
+	if (nbTuiles != static_cast<std::uint64_t>(fin - curseur) / rawRecordSize || static_cast<std::size_t>(fin - curseur) % rawRecordSize)
+		throw ParseException("truncated level");
+	tuiles.reserve(static_cast<std::size_t>(nbTuiles));
+	for (; curseur != fin; curseur += rawRecordSize)
+		tuiles.push_back(readRaw(curseur));
+	return tuiles;
+}
+
+std::vector<opt::TileRecord> opt::LevelFile::load(const std::string& path)
+{
+	std::ifstream fichier{ path, std::ios::binary };
+	if (!fichier)
+		throw LoadException(path);
+	std::vector<TileRecord> tuiles{ read(fichier) };
+	readChanges(fichier, tuiles);
+	return tuiles;
+}
+
+void opt::LevelFile::writeChanges(std::ostream& stream, std::span<const TileChange> changes)
+{
+	std::vector<char> donnees;
+	donnees.reserve(changes.size() * 12);
+	std::size_t precedent{ 0 };
+	for (const TileChange& changement : changes)
+	{
+		// Écart signé : les entrées sont rejouées dans l'ordre d'écriture, quel qu'il soit ///
+		// Signed difference: entries are replayed in writing order, whatever it is
+		putVarint(donnees, zigzag(static_cast<std::int64_t>(changement.index - precedent)));
+		putChange(donnees, changement.record);
+		precedent = changement.index;
+	}
+
+	std::vector<char> octets;
+	octets.reserve(journalHeaderSize + donnees.size());
+	octets.insert(octets.end(), std::begin(journalMagic), std::end(journalMagic));
+	putU32(octets, journalVersion);
+	const std::uint64_t nbEntrees{ changes.size() };
+	putU32(octets, static_cast<std::uint32_t>(nbEntrees));
+	putU32(octets, static_cast<std::uint32_t>(nbEntrees >> 32));
+	putU32(octets, static_cast<std::uint32_t>(donnees.size()));
+	putU32(octets, static_cast<std::uint32_t>(static_cast<std::uint64_t>(donnees.size()) >> 32));
+	octets.insert(octets.end(), donnees.begin(), donnees.end());
+	stream.write(octets.data(), static_cast<std::streamsize>(octets.size()));
+}
+
+void opt::LevelFile::appendChanges(const std::string& path, std::span<const TileChange> changes)
+{
+	std::ofstream fichier{ path, std::ios::binary | std::ios::app };
+	if (!fichier)
+		throw LoadException(path);
+	writeChanges(fichier, changes);
+	if (!fichier)
+		throw LoadException(path);
+}
+
+void opt::LevelFile::readChanges(std::istream& stream, std::vector<TileRecord>& tiles)
+{
+	while (stream.peek() != std::istream::traits_type::eof())
+	{
+		char entete[journalHeaderSize];
+		if (!stream.read(entete, journalHeaderSize) || !std::equal(std::begin(journalMagic), std::end(journalMagic), entete))
+			throw ParseException("journal header");
+		if (getU32(entete + 4) != journalVersion)
+			throw ParseException("journal version " + std::to_string(getU32(entete + 4)));
+		const std::uint64_t nbEntrees{ getU64(entete + 8) };
+		const std::uint64_t nbOctets{ getU64(entete + 16) };
+		// Chaque entrée occupe au moins deux octets /// Each entry takes at least two bytes
+		if (nbEntrees > nbOctets / 2)
+			throw ParseException("journal entry count");
+
+		std::vector<char> donnees;
+		for (std::uint64_t lus{ 0 }; lus < nbOctets;)
+		{
+			const std::size_t bloc{ static_cast<std::size_t>(std::min<std::uint64_t>(nbOctets - lus, readBlock * rawRecordSize)) };
+			donnees.resize(static_cast<std::size_t>(lus) + bloc);
+			if (!stream.read(donnees.data() + lus, static_cast<std::streamsize>(bloc)))
+				throw ParseException("truncated journal");
+			lus += bloc;
+		}
+
+		const char* curseur{ donnees.data() };
+		const char* fin{ donnees.data() + donnees.size() };
+		std::size_t indice{ 0 };
+		for (std::uint64_t i{ 0 }; i < nbEntrees; ++i)
+		{
+			indice += static_cast<std::size_t>(unzigzag(getVarint(curseur, fin)));
+			const TileRecord tuile{ getChange(curseur, fin) };
+			// Une tuile ajoutée suit toujours la dernière tuile existante ///
+			// An added tile always follows the last existing tile
+			if (indice < tiles.size())
+				tiles[indice] = tuile;
+			else if (indice == tiles.size())
+				tiles.push_back(tuile);
+			else
+				throw ParseException("journal tile " + std::to_string(indice) + " after " + std::to_string(tiles.size()) + " tiles");
+		}
+		if (curseur != fin)
+			throw ParseException("journal size");
+	}
+}
+
+void opt::LevelFile::buildVertexes(std::span<const TileRecord> tiles, const std::vector<sf::FloatRect>& subTextures,
+	std::vector<sf::Vertex>& vertexes, std::vector<std::size_t>* beginTiles)
+{
+	// Premier passage : sous-textures vérifiées et nombre de sommets, pour n'agrandir qu'une fois ///
+	// First pass: subtextures checked and vertex counts, to grow only once
+	std::vector<std::size_t> debuts(tiles.size());
+	std::size_t fin{ vertexes.size() };
+	for (std::size_t i{ 0 }; i < tiles.size(); ++i)
+	{
+		const TileRecord& tuile{ tiles[i] };
+		const sf::FloatRect* sousTexture{ nullptr };
+		if (tuile.rect.getSize() != sf::Vector2f())
+		{
+			if (tuile.subTexture < 0 || tuile.subTexture >= static_cast<int>(subTextures.size()))
+				throw AtlasException(tuile.subTexture);
+			sousTexture = &subTextures[tuile.subTexture];
+		}
+		debuts[i] = fin;
+		fin += Tile::vertexCount(tuile.rect, sousTexture, Tile::resolvedScale(tuile.rect, sousTexture, tuile.textureRule, tuile.scale));
+	}
+
+	vertexes.resize(fin);
+	for (std::size_t i{ 0 }; i < tiles.size(); ++i)
+	{
+		const TileRecord& tuile{ tiles[i] };
+		const sf::FloatRect* sousTexture{ tuile.rect.getSize() != sf::Vector2f() ? &subTextures[tuile.subTexture] : nullptr };
+		Tile::writeVertexes(vertexes.data() + debuts[i], tuile.rect, sousTexture,
+			Tile::resolvedScale(tuile.rect, sousTexture, tuile.textureRule, tuile.scale), tuile.colour);
+	}
+	if (beginTiles)
+		beginTiles->insert(beginTiles->end(), debuts.begin(), debuts.end());
+}
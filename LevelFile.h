@@ -0,0 +1,147 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef LEVELFILE_H
+#define LEVELFILE_H
+
+#include "OptTile.h"
+#include "Tile.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	/// <summary>
+	/// Description d'une tuile sans sommets, telle qu'enregistrée dans un fichier ///
+	/// Description of a tile without vertexes, as stored inside a file
+	/// </summary>
+	struct OPTTILE_API TileRecord {
+		// Position et taille de la tuile /// Tile position and size
+		sf::FloatRect rect;
+		int subTexture{ 0 };
+		TextureRule textureRule{ TextureRule::repeat_texture };
+		sf::Vector2f scale{ 1.f, 1.f };
+		sf::Color colour{ sf::Color::White };
+	};
+
+	/// <summary>
+	/// État d'une tuile après modification, tel qu'enregistré dans un journal ///
+	/// State of a tile after modification, as stored inside a journal
+	/// </summary>
+	struct OPTTILE_API TileChange {
+		// Indice de la tuile; égal au nombre de tuiles pour un ajout /// Tile index; equal to the tile count for an addition
+		std::size_t index{ 0 };
+		TileRecord record;
+	};
+
+	/// <summary>
+	/// Format binaire des niveaux : un en-tête ("OPTL", version, encodage, nombre de tuiles) suivi des tuiles, en petit-boutiste.
+	/// Les sommets ne sont pas enregistrés : ils sont reconstruits au chargement à partir des sous-textures ///
+	/// Binary level format: a header ("OPTL", version, encoding, tile count) followed by the tiles, in little-endian.
+	/// Vertexes are not stored: they are built again when loading from the subtextures
+	/// </summary>
+	class OPTTILE_API LevelFile {
+	public:
+		/// <summary>
+		/// Encodage des tuiles après l'en-tête ///
+		/// Encoding of the tiles after the header
+		/// </summary>
+		enum class Encoding : std::uint32_t {
+			// 33 octets par tuile /// 33 bytes per tile
+			raw = 0,
+			// Taille des données, puis une colonne par champ, absente si toutes les tuiles ont la valeur par défaut (la sous-texture reste si toutes les colonnes le sont).
+			// Sous-texture, règle et couleur sont codées par plages de valeurs égales; positions, tailles et échelles par plages d'écarts égaux avec la tuile précédente ///
+			// Data size, then one column per field, absent if every tile has the default value (the subtexture stays if every column would be).
+			// Subtexture, rule and colour are coded as runs of equal values; positions, sizes and scales as runs of equal differences with the previous tile
+			compact = 1
+		};
+
+		/// <summary>
+		/// Écrit des tuiles dans un flux binaire ///
+		/// Writes tiles into a binary stream
+		/// </summary>
+		static void write(std::ostream& stream, const std::vector<TileRecord>& tiles, Encoding encoding = Encoding::compact);
+
+		/// <summary>
+		/// Écrit des tuiles dans un fichier, remplacé s'il existe ///
+		/// Writes tiles into a file, replaced if it exists
+		/// </summary>
+		/// <exception cref="LoadException">Le fichier ne peut pas être ouvert /// The file cannot be opened</exception>
+		static void save(const std::string& path, const std::vector<TileRecord>& tiles, Encoding encoding = Encoding::compact);
+
+		/// <summary>
+		/// Lit les tuiles d'un flux binaire, quel que soit leur encodage. Le flux est laissé juste après les tuiles ///
+		/// Reads the tiles of a binary stream, whatever their encoding. The stream is left right after the tiles
+		/// </summary>
+		/// <exception cref="ParseException">Le flux n'est pas un niveau valide /// The stream is not a valid level</exception>
+		static std::vector<TileRecord> read(std::istream& stream);
+
+		/// <summary>
+		/// Lit les tuiles directement depuis la mémoire, par exemple un fichier projeté, sans copie intermédiaire.
+		/// Les octets doivent contenir exactement un niveau ///
+		/// Reads the tiles straight from memory, for example a mapped file, without intermediate copy.
+		/// The bytes must hold exactly one level
+		/// </summary>
+		/// <exception cref="ParseException">Les octets ne sont pas un niveau valide /// The bytes are not a valid level</exception>
+		static std::vector<TileRecord> read(std::span<const char> bytes);
+
+		/// <summary>
+		/// Lit les tuiles d'un fichier, journaux ajoutés compris ///
+		/// Reads the tiles of a file, appended journals included
+		/// </summary>
+		/// <exception cref="LoadException">Le fichier ne peut pas être ouvert /// The file cannot be opened</exception>
+		/// <exception cref="ParseException">Le fichier n'est pas un niveau valide /// The file is not a valid level</exception>
+		static std::vector<TileRecord> load(const std::string& path);
+
+		/// <summary>
+		/// Écrit un segment de journal ("OPTJ", version, nombre d'entrées, taille des données) : pour chaque tuile, l'écart d'indice avec
+		/// l'entrée précédente, un masque des champs différents de la valeur par défaut, puis ces seuls champs ///
+		/// Writes a journal segment ("OPTJ", version, entry count, data size): for each tile, the index difference with the
+		/// previous entry, a mask of the fields different from the default value, then only those fields
+		/// </summary>
+		static void writeChanges(std::ostream& stream, std::span<const TileChange> changes);
+
+		/// <summary>
+		/// Ajoute un segment de journal à la fin d'un fichier de niveau, sans réécrire ce qu'il contient déjà ///
+		/// Appends a journal segment at the end of a level file, without writing again what it already holds
+		/// </summary>
+		/// <exception cref="LoadException">Le fichier ne peut pas être ouvert /// The file cannot be opened</exception>
+		static void appendChanges(const std::string& path, std::span<const TileChange> changes);
+
+		/// <summary>
+		/// Applique aux tuiles tous les segments de journal jusqu'à la fin du flux, dans l'ordre d'écriture ///
+		/// Applies to the tiles every journal segment until the end of the stream, in writing order
+		/// </summary>
+		/// <exception cref="ParseException">Un segment n'est pas valide /// A segment is not valid</exception>
+		static void readChanges(std::istream& stream, std::vector<TileRecord>& tiles);
+
+		/// <summary>
+		/// Ajoute à la fin de vertexes les sommets des tuiles, comme le ferait Level::add, sans créer d'objet Tile.
+		/// Ne touche à aucun niveau et peut donc être appelé hors du fil de rendu ///
+		/// Appends the tiles' vertexes at the end of vertexes, as Level::add would, without creating any Tile object.
+		/// Touches no level and can therefore be called off the render thread
+		/// </summary>
+		/// <param name="tiles">Tuiles à construire /// Tiles to build</param>
+		/// <param name="subTextures">Sous-textures de l'atlas /// Atlas subtextures</param>
+		/// <param name="vertexes">Sommets, agrandis une seule fois /// Vertexes, grown only once</param>
+		/// <param name="beginTiles">Reçoit le premier sommet de chaque tuile, si non nul /// Receives the first vertex of each tile, if not null</param>
+		/// <exception cref="AtlasException">Une tuile utilise une sous-texture absente /// A tile uses a missing subtexture</exception>
+		static void buildVertexes(std::span<const TileRecord> tiles, const std::vector<sf::FloatRect>& subTextures,
+			std::vector<sf::Vertex>& vertexes, std::vector<std::size_t>* beginTiles = nullptr);
+	};
+}
+
+#endif // !LEVELFILE_H
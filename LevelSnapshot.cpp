@@ -0,0 +1,23 @@
+#include "pch.h"
+#include "LevelSnapshot.h"
+#include <algorithm>
+
+std::size_t opt::LevelSnapshot::size() const
+{
+	return m_tileCount;
+}
+
+std::size_t opt::LevelSnapshot::sharedChunks(const LevelSnapshot& other) const
+{
+	std::size_t partages{ 0 };
+	for (std::size_t i{ 0 }; i < std::min(m_tileChunks.size(), other.m_tileChunks.size()); ++i)
+		partages += m_tileChunks[i] == other.m_tileChunks[i];
+	for (std::size_t i{ 0 }; i < std::min(m_vertexChunks.size(), other.m_vertexChunks.size()); ++i)
+		partages += m_vertexChunks[i] == other.m_vertexChunks[i];
+	return partages;
+}
+
+std::size_t opt::LevelSnapshot::chunkCount() const
+{
+	return m_tileChunks.size() + m_vertexChunks.size();
+}
@@ -0,0 +1,75 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef LEVELSNAPSHOT_H
+#define LEVELSNAPSHOT_H
+
+#include "OptTile.h"
+#include "LevelFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	/// <summary>
+	/// Photo des tuiles et des sommets d'un niveau, prise par Level::snapshot et rendue par Level::restore.
+	/// L'état est découpé en morceaux immuables partagés entre les photos et le niveau : une photo ne copie que les morceaux
+	/// modifiés depuis la photo précédente, et la copier ne coûte qu'un pointeur par morceau.
+	/// La texture, les sous-textures, les modes de rendu, les couches et les colonnes d'attributs n'en font pas partie ///
+	/// Snapshot of the tiles and vertexes of a level, taken by Level::snapshot and given back by Level::restore.
+	/// The state is cut into immutable chunks shared between the snapshots and the level: a snapshot only copies the chunks
+	/// modified since the previous snapshot, and copying it only costs one pointer per chunk.
+	/// The texture, the subtextures, the render modes, the layers and the attribute columns are not part of it
+	/// </summary>
+	class OPTTILE_API LevelSnapshot {
+		friend class Level;
+	public:
+		// Tuiles par morceau /// Tiles per chunk
+		static constexpr std::size_t tileChunk{ 1024 };
+		// Sommets par morceau /// Vertexes per chunk
+		static constexpr std::size_t vertexChunk{ 4096 };
+
+	private:
+		struct TileChunk {
+			std::vector<TileRecord> records;
+			// Premier sommet de chaque tuile /// First vertex of each tile
+			std::vector<std::size_t> begins;
+			std::vector<std::uint8_t> hidden;
+		};
+
+		std::vector<std::shared_ptr<const TileChunk>> m_tileChunks;
+		std::vector<std::shared_ptr<const std::vector<sf::Vertex>>> m_vertexChunks;
+		std::size_t m_tileCount{ 0 };
+		std::size_t m_vertexCount{ 0 };
+		// Les tuiles se suivaient dans le tampon dans l'ordre de leur index /// Tiles followed each other inside the buffer in the order of their index
+		bool m_indexOrder{ true };
+
+	public:
+		/// <summary>
+		/// Nombre de tuiles de la photo ///
+		/// Number of tiles of the snapshot
+		/// </summary>
+		std::size_t size() const;
+
+		/// <summary>
+		/// Nombre de morceaux partagés avec une autre photo, c'est-à-dire identiques sans comparaison ///
+		/// Number of chunks shared with another snapshot, that is to say identical without comparison
+		/// </summary>
+		std::size_t sharedChunks(const LevelSnapshot& other) const;
+
+		std::size_t chunkCount() const;
+	};
+}
+
+#endif // !LEVELSNAPSHOT_H
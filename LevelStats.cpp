@@ -0,0 +1,22 @@
+#include "pch.h"
+#include "LevelStats.h"
+
+std::uint64_t opt::LevelStats::initializeCalls(TextureRule textureRule) const
+{
+	return initializeVertexesCalls[static_cast<std::size_t>(textureRule)];
+}
+
+void opt::LevelStats::reset()
+{
+	uploadedVertexes = 0;
+	uploadedBytes = 0;
+	bufferCreations = 0;
+	shiftedVertexes = 0;
+	initializeVertexesCalls.fill(0);
+	drawCalls = 0;
+	submittedVertexes = 0;
+	cacheCellRenders = 0;
+	appliedMutations = 0;
+	coalescedMutations = 0;
+	occlusionTests = 0;
+}
@@ -0,0 +1,95 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef LEVELSTATS_H
+#define LEVELSTATS_H
+
+#include "OptTile.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "Tile.h"
+
+// Les compteurs ne sont incrémentés que si OPTTILE_ENABLE_STATS est défini. Sinon, les instructions disparaissent à la compilation ///
+// Counters are only incremented when OPTTILE_ENABLE_STATS is defined. Otherwise, the statements vanish at compile time
+#ifdef OPTTILE_ENABLE_STATS
+#define OPTTILE_STAT(statement) do { statement; } while (false)
+#else
+#define OPTTILE_STAT(statement) do { } while (false)
+#endif
+
+namespace opt
+{
+	// Nombre de valeurs de l'énumération TextureRule ///
+	// Number of values of the TextureRule enumeration
+	constexpr std::size_t textureRuleCount{ 6 };
+
+	/// <summary>
+	/// Compteurs de performance d'un objet Level. Les compteurs d'opérations peuvent être réinitialisés à chaque image; la mémoire est calculée à la demande ///
+	/// Performance counters of a Level. Operation counters can be reset at each frame; memory is computed on demand
+	/// </summary>
+	struct OPTTILE_API LevelStats {
+		// Nombre de sommets téléversés vers la carte graphique par reloadBuffer ///
+		// Number of vertexes uploaded to the graphics card by reloadBuffer
+		std::uint64_t uploadedVertexes{ 0 };
+		// Nombre d'octets téléversés vers la carte graphique par reloadBuffer ///
+		// Number of bytes uploaded to the graphics card by reloadBuffer
+		std::uint64_t uploadedBytes{ 0 };
+		// Nombre de fois où le tampon graphique a été recréé ///
+		// Number of times the GPU buffer has been re-created
+		std::uint64_t bufferCreations{ 0 };
+		// Nombre de sommets déplacés dans le vector par Tile::moveVertexes ///
+		// Number of vertexes shifted inside the vector by Tile::moveVertexes
+		std::uint64_t shiftedVertexes{ 0 };
+		// Nombre d'appels à Tile::intializeVertexes pour chaque règle de texture (indexé par TextureRule) ///
+		// Number of calls to Tile::intializeVertexes for each texture rule (indexed by TextureRule)
+		std::array<std::uint64_t, textureRuleCount> initializeVertexesCalls{};
+		// Nombre d'appels de dessin soumis à la cible ///
+		// Number of draw calls submitted to the target
+		std::uint64_t drawCalls{ 0 };
+		// Nombre de sommets soumis à la cible ///
+		// Number of vertexes submitted to the target
+		std::uint64_t submittedVertexes{ 0 };
+		// Nombre de cellules du cache statique rendues de nouveau ///
+		// Number of static cache cells rendered again
+		std::uint64_t cacheCellRenders{ 0 };
+		// Nombre de modifications retirées de la file par applyMutations ///
+		// Number of changes popped from the queue by applyMutations
+		std::uint64_t appliedMutations{ 0 };
+		// Nombre de ces modifications fusionnées avec une autre modification de la même tuile ///
+		// Number of those changes merged with another change of the same tile
+		std::uint64_t coalescedMutations{ 0 };
+		// Nombre de tuiles réévaluées par la passe d'occlusion ///
+		// Number of tiles evaluated again by the occlusion pass
+		std::uint64_t occlusionTests{ 0 };
+		// Mémoire vive occupée par le niveau, en octets ///
+		// Memory held by the level on the CPU side, in bytes
+		std::size_t cpuBytes{ 0 };
+		// Mémoire graphique occupée par le niveau (tampon et texture), en octets ///
+		// Memory held by the level on the GPU side (buffer and texture), in bytes
+		std::size_t gpuBytes{ 0 };
+
+		/// <summary>
+		/// Retourne le nombre d'appels à intializeVertexes pour une règle de texture ///
+		/// Returns the number of intializeVertexes calls for a texture rule
+		/// </summary>
+		/// <param name="textureRule">Règle de texture /// Texture rule</param>
+		std::uint64_t initializeCalls(TextureRule textureRule) const;
+
+		/// <summary>
+		/// Remet les compteurs d'opérations à 0. La mémoire n'est pas touchée ///
+		/// Resets the operation counters to 0. Memory is left untouched
+		/// </summary>
+		void reset();
+	};
+}
+
+#endif // !LEVELSTATS_H
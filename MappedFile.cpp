@@ -0,0 +1,102 @@
+#include "pch.h"
+#include "MappedFile.h"
+#include "Exceptions.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+opt::MappedFile::MappedFile(const std::string& path) : m_data{ nullptr }, m_size{ 0 }, m_file{ INVALID_HANDLE_VALUE }, m_mapping{ nullptr }
+{
+	m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	LARGE_INTEGER taille;
+	if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &taille))
+	{
+		if (m_file != INVALID_HANDLE_VALUE)
+			CloseHandle(m_file);
+		throw LoadException(path);
+	}
+	m_size = static_cast<std::size_t>(taille.QuadPart);
+	if (m_size == 0)
+		return;
+	m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_mapping)
+		m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (!m_data)
+	{
+		if (m_mapping)
+			CloseHandle(m_mapping);
+		CloseHandle(m_file);
+		throw LoadException(path);
+	}
+}
+
+opt::MappedFile::~MappedFile()
+{
+	if (m_data)
+		UnmapViewOfFile(m_data);
+	if (m_mapping)
+		CloseHandle(m_mapping);
+	CloseHandle(m_file);
+}
+
+void opt::MappedFile::prefetch() const
+{
+#if _WIN32_WINNT >= 0x0602
+	if (!m_data)
+		return;
+	WIN32_MEMORY_RANGE_ENTRY plage{ const_cast<char*>(m_data), m_size };
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &plage, 0);
+#endif
+}
+#else
+opt::MappedFile::MappedFile(const std::string& path) : m_data{ nullptr }, m_size{ 0 }, m_descriptor{ open(path.c_str(), O_RDONLY) }
+{
+	struct stat informations;
+	if (m_descriptor < 0 || fstat(m_descriptor, &informations) != 0)
+	{
+		if (m_descriptor >= 0)
+			close(m_descriptor);
+		throw LoadException(path);
+	}
+	m_size = static_cast<std::size_t>(informations.st_size);
+	if (m_size == 0)
+		return;
+	void* projection{ mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_descriptor, 0) };
+	if (projection == MAP_FAILED)
+	{
+		close(m_descriptor);
+		throw LoadException(path);
+	}
+	// Le fichier est lu du début à la fin : le système peut lire d'avance ///
+	// The file is read from start to end: the system can read ahead
+	madvise(projection, m_size, MADV_SEQUENTIAL);
+	m_data = static_cast<const char*>(projection);
+}
+
+opt::MappedFile::~MappedFile()
+{
+	if (m_data)
+		munmap(const_cast<char*>(m_data), m_size);
+	close(m_descriptor);
+}
+
+void opt::MappedFile::prefetch() const
+{
+	if (m_data)
+		madvise(const_cast<char*>(m_data), m_size, MADV_WILLNEED);
+}
+#endif
+
+const char* opt::MappedFile::data() const
+{
+	return m_data;
+}
+
+std::size_t opt::MappedFile::size() const
+{
+	return m_size;
+}
@@ -0,0 +1,66 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include "OptTile.h"
+#include <cstddef>
+#include <string>
+
+namespace opt
+{
+	/// <summary>
+	/// Fichier projeté en mémoire en lecture seule. Les octets sont lus par le système à la demande, sans copie dans un tampon ///
+	/// File mapped into memory as read-only. Bytes are read by the system on demand, without copy into a buffer
+	/// </summary>
+	class OPTTILE_API MappedFile {
+	private:
+		const char* m_data;
+		std::size_t m_size;
+#ifdef _WIN32
+		void* m_file;
+		void* m_mapping;
+#else
+		int m_descriptor;
+#endif
+
+	public:
+		/// <summary>
+		/// Projette un fichier en entier ///
+		/// Maps a whole file
+		/// </summary>
+		/// <exception cref="LoadException">Le fichier ne peut pas être ouvert ou projeté /// The file cannot be opened or mapped</exception>
+		MappedFile(const std::string& path);
+
+		MappedFile(const MappedFile&) = delete;
+
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		~MappedFile();
+
+		/// <summary>
+		/// Retourne le premier octet du fichier, nul si le fichier est vide ///
+		/// Returns the first byte of the file, null if the file is empty
+		/// </summary>
+		const char* data() const;
+
+		std::size_t size() const;
+
+		/// <summary>
+		/// Demande au système de lire tout le fichier d'avance, en une lecture séquentielle, au lieu d'une lecture par page touchée ///
+		/// Asks the system to read the whole file ahead, as one sequential read, instead of one read per touched page
+		/// </summary>
+		void prefetch() const;
+	};
+}
+
+#endif // !MAPPEDFILE_H
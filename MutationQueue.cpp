@@ -0,0 +1,104 @@
+#include "pch.h"
+#include "MutationQueue.h"
+
+void opt::MutationQueue::push(Node* node)
+{
+	node->next.store(nullptr, std::memory_order_relaxed);
+	Node* precedent{ m_head.exchange(node, std::memory_order_acq_rel) };
+	// Entre l'échange et cette écriture, le consommateur voit la file coupée et attend le prochain lot ///
+	// Between the exchange and this write, the consumer sees a cut queue and waits for the next batch
+	precedent->next.store(node, std::memory_order_release);
+}
+
+opt::MutationQueue::Node* opt::MutationQueue::nodeAt(std::uint32_t slot) const
+{
+	const std::size_t index{ slot - 1u };
+	return m_blocks[index / blockNodes].load(std::memory_order_acquire) + index % blockNodes;
+}
+
+opt::MutationQueue::Node* opt::MutationQueue::acquireNode()
+{
+	std::uint64_t sommet{ m_free.load(std::memory_order_acquire) };
+	while (const std::uint32_t place{ static_cast<std::uint32_t>(sommet) })
+	{
+		// Le suivant peut être périmé si un autre producteur a pris ce nœud, mais le compteur fait alors échouer l'échange ///
+		// The next may be stale if another producer took this node, but the counter then fails the exchange
+		const std::uint64_t compteur{ (sommet >> 32) + 1u };
+		const std::uint64_t suivant{ (compteur << 32) | nodeAt(place)->nextFree.load(std::memory_order_relaxed) };
+		if (m_free.compare_exchange_weak(sommet, suivant, std::memory_order_acquire, std::memory_order_acquire))
+			return nodeAt(place);
+	}
+
+	const std::size_t bloc{ m_blockCount.fetch_add(1, std::memory_order_relaxed) };
+	// Réserve pleine : le nœud est alloué seul et libéré au retrait /// Pool full: the node is allocated alone and freed when popped
+	if (bloc >= maxBlocks)
+		return new Node;
+	Node* noeuds{ new Node[blockNodes] };
+	for (std::size_t i{ 0 }; i < blockNodes; ++i)
+		noeuds[i].slot = static_cast<std::uint32_t>(bloc * blockNodes + i + 1);
+	m_blocks[bloc].store(noeuds, std::memory_order_release);
+	for (std::size_t i{ 1 }; i < blockNodes; ++i)
+		releaseNode(noeuds + i);
+	return noeuds;
+}
+
+void opt::MutationQueue::releaseNode(Node* node)
+{
+	if (!node->slot)
+	{
+		delete node;
+		return;
+	}
+	std::uint64_t sommet{ m_free.load(std::memory_order_relaxed) };
+	do
+		node->nextFree.store(static_cast<std::uint32_t>(sommet), std::memory_order_relaxed);
+	while (!m_free.compare_exchange_weak(sommet, (((sommet >> 32) + 1u) << 32) | node->slot, std::memory_order_release, std::memory_order_relaxed));
+}
+
+opt::MutationQueue::MutationQueue() : m_head{ &m_stub }, m_tail{ &m_stub }
+{
+}
+
+opt::MutationQueue::~MutationQueue()
+{
+	TileMutation ignoree;
+	while (pop(ignoree));
+	for (std::atomic<Node*>& bloc : m_blocks)
+		delete[] bloc.load(std::memory_order_relaxed);
+}
+
+void opt::MutationQueue::push(const TileMutation& mutation)
+{
+	Node* noeud{ acquireNode() };
+	noeud->mutation = mutation;
+	push(noeud);
+}
+
+bool opt::MutationQueue::pop(TileMutation& mutation)
+{
+	Node* queue{ m_tail };
+	Node* suivant{ queue->next.load(std::memory_order_acquire) };
+	if (queue == &m_stub)
+	{
+		if (!suivant)
+			return false;
+		m_tail = suivant;
+		queue = suivant;
+		suivant = suivant->next.load(std::memory_order_acquire);
+	}
+	if (!suivant)
+	{
+		if (queue != m_head.load(std::memory_order_acquire))
+			return false;
+		// Dernier nœud : la sentinelle est remise derrière lui pour pouvoir le retirer ///
+		// Last node: the sentinel is pushed back behind it so it can be popped
+		push(&m_stub);
+		suivant = queue->next.load(std::memory_order_acquire);
+		if (!suivant)
+			return false;
+	}
+	m_tail = suivant;
+	mutation = queue->mutation;
+	releaseNode(queue);
+	return true;
+}
@@ -0,0 +1,111 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef MUTATIONQUEUE_H
+#define MUTATIONQUEUE_H
+
+#include "OptTile.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <SFML/Graphics.hpp>
+#include "Tile.h"
+
+namespace opt
+{
+	/// <summary>
+	/// Modification d'une tuile demandée par un autre fil d'exécution ///
+	/// Tile change requested by another thread
+	/// </summary>
+	struct OPTTILE_API TileMutation {
+		enum class Type { move, setPosition, resize, setColour, changeTexture, add };
+
+		Type type{ Type::move };
+		// Index de la tuile; ignoré pour un ajout /// Tile index; ignored for an addition
+		std::size_t index{ 0 };
+		// Déplacement, position ou taille selon le type /// Offset, position or size depending on the type
+		sf::Vector2f vector;
+		// Position de la tuile ajoutée /// Position of the added tile
+		sf::Vector2f position;
+		sf::Color colour;
+		int subTexture{ 0 };
+		TextureRule rule{ TextureRule::repeat_texture };
+	};
+
+	/// <summary>
+	/// File sans verrou à plusieurs producteurs et un seul consommateur (algorithme de Vyukov). Un ajout est un seul échange atomique,
+	/// donc un producteur n'attend jamais un autre fil, et les modifications d'un même producteur sortent dans l'ordre ///
+	/// Lock-free queue with many producers and a single consumer (Vyukov's algorithm). A push is a single atomic exchange,
+	/// so a producer never waits for another thread, and the changes of one producer come out in order.
+	/// Les nœuds viennent de blocs de 1024 recyclés par le consommateur; un ajout n'alloue que si la réserve est vide ///
+	/// Nodes come from blocks of 1024 recycled by the consumer; a push only allocates when the pool is empty
+	/// </summary>
+	class OPTTILE_API MutationQueue {
+	private:
+		struct Node {
+			std::atomic<Node*> next{ nullptr };
+			// Suivant dans la réserve /// Next in the pool
+			std::atomic<std::uint32_t> nextFree{ 0 };
+			// Place dans la réserve plus un, 0 pour un nœud hors réserve /// Pool slot plus one, 0 for a node outside the pool
+			std::uint32_t slot{ 0 };
+			TileMutation mutation;
+		};
+
+		static constexpr std::size_t blockNodes{ 1024 };
+		static constexpr std::size_t maxBlocks{ 1024 };
+
+		// Dernier nœud ajouté, partagé par les producteurs /// Last pushed node, shared by the producers
+		std::atomic<Node*> m_head;
+		// Prochain nœud à retirer, utilisé par le consommateur seulement /// Next node to pop, used by the consumer only
+		Node* m_tail;
+		// Nœud sentinelle qui garde la file non vide /// Sentinel node that keeps the queue non-empty
+		Node m_stub;
+		// Blocs de nœuds, jamais libérés avant la destruction /// Node blocks, never freed before destruction
+		std::array<std::atomic<Node*>, maxBlocks> m_blocks{};
+		std::atomic<std::size_t> m_blockCount{ 0 };
+		// Pile des nœuds libres : place du sommet dans les 32 bits bas, compteur contre l'ABA dans les 32 bits hauts ///
+		// Free node stack: top slot in the low 32 bits, ABA counter in the high 32 bits
+		std::atomic<std::uint64_t> m_free{ 0 };
+
+		void push(Node* node);
+
+		Node* nodeAt(std::uint32_t slot) const;
+
+		Node* acquireNode();
+
+		void releaseNode(Node* node);
+
+	public:
+		MutationQueue();
+
+		MutationQueue(const MutationQueue&) = delete;
+
+		MutationQueue& operator=(const MutationQueue&) = delete;
+
+		~MutationQueue();
+
+		/// <summary>
+		/// Ajoute une modification. Peut être appelée par n'importe quel fil ///
+		/// Pushes a change. Can be called by any thread
+		/// </summary>
+		void push(const TileMutation& mutation);
+
+		/// <summary>
+		/// Retire la plus ancienne modification. Un seul fil doit l'appeler. Retourne faux si la file est vide ou si l'ajout suivant n'est pas terminé ///
+		/// Pops the oldest change. Only one thread may call it. Returns false if the queue is empty or if the next push is not finished
+		/// </summary>
+		/// <param name="mutation">Reçoit la modification retirée /// Receives the popped change</param>
+		bool pop(TileMutation& mutation);
+	};
+}
+
+#endif // !MUTATIONQUEUE_H
@@ -0,0 +1,111 @@
+#include "pch.h"
+#include "OcclusionIndex.h"
+
+opt::OcclusionIndex::OcclusionIndex(unsigned cellSize) : m_grid{ cellSize }
+{
+}
+
+void opt::OcclusionIndex::markDirty(std::size_t tile)
+{
+	if (!m_isDirty[tile])
+	{
+		m_isDirty[tile] = true;
+		m_dirty.push_back(tile);
+	}
+}
+
+void opt::OcclusionIndex::markRegion(const sf::FloatRect& region)
+{
+	m_grid.query(region, m_found);
+	for (std::size_t tuile : m_found)
+		markDirty(tuile);
+}
+
+void opt::OcclusionIndex::update(std::size_t tile, const sf::FloatRect& bounds, bool opaque)
+{
+	if (tile >= m_opaque.size())
+	{
+		m_opaque.resize(tile + 1, false);
+		m_occluded.resize(tile + 1, false);
+		m_isDirty.resize(tile + 1, false);
+	}
+	const sf::FloatRect ancien{ m_grid.bounds(tile) };
+	m_grid.update(tile, bounds);
+	// Seules les tuiles sous une tuile opaque, avant ou après le changement, peuvent changer d'état ///
+	// Only the tiles under an opaque tile, before or after the change, may change their state
+	if (m_opaque[tile])
+		markRegion(ancien);
+	if (opaque)
+		markRegion(bounds);
+	m_opaque[tile] = opaque;
+	markDirty(tile);
+}
+
+void opt::OcclusionIndex::markAll()
+{
+	for (std::size_t i{ 0 }; i < m_opaque.size(); ++i)
+		markDirty(i);
+}
+
+void opt::OcclusionIndex::clear()
+{
+	m_grid.clear();
+	m_opaque.clear();
+	m_occluded.clear();
+	m_dirty.clear();
+	m_isDirty.clear();
+}
+
+void opt::OcclusionIndex::truncate(std::size_t count)
+{
+	if (count >= m_opaque.size())
+		return;
+	std::vector<sf::FloatRect> couvertes;
+	for (std::size_t i{ count }; i < m_opaque.size(); ++i)
+		if (m_opaque[i])
+			couvertes.push_back(m_grid.bounds(i));
+	m_grid.truncate(count);
+	m_opaque.resize(count);
+	m_occluded.resize(count);
+	m_isDirty.resize(count);
+	std::erase_if(m_dirty, [count](std::size_t tuile) { return tuile >= count; });
+	// Les régions sont marquées une fois les tuiles retirées des cellules ///
+	// Regions are marked once the tiles are removed from the cells
+	for (const sf::FloatRect& region : couvertes)
+		markRegion(region);
+}
+
+std::size_t opt::OcclusionIndex::resolve(const std::vector<std::size_t>& drawOrder)
+{
+	for (std::size_t tuile : m_dirty)
+	{
+		m_isDirty[tuile] = false;
+		const sf::FloatRect rectangle{ m_grid.bounds(tuile) };
+		bool cachee{ false };
+		// Une tuile qui en couvre une autre touche forcément la cellule de son coin haut gauche ///
+		// A tile covering another one necessarily touches the cell of its top left corner
+		if (tuile < drawOrder.size())
+		{
+			for (std::size_t autre : m_grid.cellAt(rectangle.getPosition()))
+			{
+				const sf::FloatRect dessus{ m_grid.bounds(autre) };
+				if (autre != tuile && m_opaque[autre] && autre < drawOrder.size() && drawOrder[autre] > drawOrder[tuile]
+					&& dessus.left <= rectangle.left && dessus.top <= rectangle.top
+					&& dessus.left + dessus.width >= rectangle.left + rectangle.width && dessus.top + dessus.height >= rectangle.top + rectangle.height)
+				{
+					cachee = true;
+					break;
+				}
+			}
+		}
+		m_occluded[tuile] = cachee;
+	}
+	const std::size_t evaluees{ m_dirty.size() };
+	m_dirty.clear();
+	return evaluees;
+}
+
+bool opt::OcclusionIndex::occluded(std::size_t tile) const
+{
+	return tile < m_occluded.size() && m_occluded[tile];
+}
@@ -0,0 +1,93 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+
+#ifndef OCCLUSIONINDEX_H
+#define OCCLUSIONINDEX_H
+
+#include "OptTile.h"
+#include "SpatialGrid.h"
+#include <cstddef>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	/// <summary>
+	/// Passe d'occlusion : une tuile entièrement couverte par une tuile opaque dessinée après elle n'est pas dessinée.
+	/// Les tuiles sont rangées dans une grille de cellules, et seules les tuiles touchées par un changement sont réévaluées ///
+	/// Occlusion pass: a tile entirely covered by an opaque tile drawn after it is not drawn.
+	/// Tiles are stored inside a grid of cells, and only the tiles touched by a change are evaluated again
+	/// </summary>
+	class OPTTILE_API OcclusionIndex {
+	private:
+		// Rectangle enregistré de chaque tuile, rangé par cellule /// Recorded rectangle of each tile, stored by cell
+		SpatialGrid m_grid;
+		std::vector<bool> m_opaque;
+		std::vector<bool> m_occluded;
+		// Tuiles à réévaluer, sans doublon grâce à m_isDirty /// Tiles to evaluate again, without duplicate thanks to m_isDirty
+		std::vector<std::size_t> m_dirty;
+		std::vector<bool> m_isDirty;
+		// Tuiles trouvées par la dernière recherche dans la grille /// Tiles found by the last search inside the grid
+		std::vector<std::size_t> m_found;
+
+		void markDirty(std::size_t tile);
+
+		/// <summary>
+		/// Marque les tuiles dont le rectangle touche une région ///
+		/// Marks the tiles whose rectangle touches a region
+		/// </summary>
+		void markRegion(const sf::FloatRect& region);
+
+	public:
+		OcclusionIndex(unsigned cellSize = 256u);
+
+		/// <summary>
+		/// Enregistre le rectangle et l'opacité d'une tuile. La tuile et celles qu'elle couvrait ou couvre sont marquées ///
+		/// Records the rectangle and the opacity of a tile. The tile and the ones it covered or covers are marked
+		/// </summary>
+		/// <param name="tile">Index de la tuile /// Tile index</param>
+		/// <param name="bounds">Rectangle de la tuile /// Tile rectangle</param>
+		/// <param name="opaque">La tuile cache ce qui est dessous /// The tile hides what is under it</param>
+		void update(std::size_t tile, const sf::FloatRect& bounds, bool opaque);
+
+		/// <summary>
+		/// Marque toutes les tuiles, par exemple après un changement de l'ordre de dessin ///
+		/// Marks every tile, for example after a change of the draw order
+		/// </summary>
+		void markAll();
+
+		void clear();
+
+		/// <summary>
+		/// Oublie les tuiles à partir de count. Les tuiles qu'elles couvraient sont marquées ///
+		/// Forgets the tiles from count onwards. The tiles they covered are marked
+		/// </summary>
+		/// <param name="count">Nombre de tuiles gardées /// Number of kept tiles</param>
+		void truncate(std::size_t count);
+
+		/// <summary>
+		/// Réévalue les tuiles marquées ///
+		/// Evaluates the marked tiles again
+		/// </summary>
+		/// <param name="drawOrder">Clé d'ordre de dessin de chaque tuile (premier sommet dans le tampon) /// Draw order key of each tile (first vertex inside the buffer)</param>
+		/// <returns>Nombre de tuiles réévaluées /// Number of evaluated tiles</returns>
+		std::size_t resolve(const std::vector<std::size_t>& drawOrder);
+
+		/// <summary>
+		/// Indique si une tuile est cachée, selon la dernière évaluation ///
+		/// Tells if a tile is hidden, according to the last evaluation
+		/// </summary>
+		bool occluded(std::size_t tile) const;
+	};
+}
+
+#endif // !OCCLUSIONINDEX_H
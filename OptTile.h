@@ -2,10 +2,16 @@
 #ifndef OPTTILE_H
 #define OPTTILE_H
 
-#ifdef OPTTILE_EXPORTS
-#define OPTTILE_API __declspec(dllexport)
+#if defined(_WIN32) && !defined(OPTTILE_STATIC)
+	#ifdef OPTTILE_EXPORTS
+		#define OPTTILE_API __declspec(dllexport)
+	#else
+		#define OPTTILE_API __declspec(dllimport)
+	#endif
+#elif defined(__GNUC__) && !defined(OPTTILE_STATIC)
+	#define OPTTILE_API __attribute__((visibility("default")))
 #else
-#define OPTTILE_API __declspec(dllimport)
+	#define OPTTILE_API
 #endif 
 
 #endif // !OPTTILE_H
@@ -0,0 +1,275 @@
+#include "pch.h"
+#include "PackedVertexBuffer.h"
+#include "Exceptions.h"
+#include "GlFunctions.h"
+#include <SFML/Window/Context.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+static_assert(sizeof(opt::PackedVertex) == 12, "PackedVertex must stay 12 bytes");
+
+namespace
+{
+	const char* const vertexShader{ R"(
+#version 120
+attribute vec2 position;
+attribute vec2 texCoords;
+attribute vec4 colour;
+
+uniform mat4 transform;
+uniform vec2 origin;
+uniform float step;
+
+varying vec2 uv;
+varying vec4 tint;
+
+void main()
+{
+	uv = texCoords;
+	tint = colour;
+	gl_Position = transform * vec4(origin + position * step, 0.0, 1.0);
+}
+)" };
+
+	const char* const fragmentShader{ R"(
+#version 120
+uniform sampler2D atlas;
+uniform float textured;
+
+varying vec2 uv;
+varying vec4 tint;
+
+void main()
+{
+	gl_FragColor = textured > 0.5 ? tint * texture2D(atlas, uv) : tint;
+}
+)" };
+
+	// Plus petit pas de quantification, pour garder les positions fractionnaires des petits niveaux ///
+	// Smallest quantization step, to keep the fractional positions of small levels
+	constexpr float minimumStep{ 1.f / 256.f };
+	// Étendue couverte par un pas, avec une marge pour l'arrondi de l'origine ///
+	// Extent covered by one step, with a margin for the rounding of the origin
+	constexpr float stepsPerExtent{ 65532.f };
+	// Au-delà, les positions entières d'un morceau ne sont plus exactes /// Past this, the integer positions of a chunk are no longer exact
+	constexpr float largestStep{ 1.f };
+
+	struct Attribute {
+		const char* name;
+		GLint size;
+		GLenum type;
+		GLboolean normalized;
+		std::size_t offset;
+	};
+
+	const Attribute vertexAttributes[]{
+		{ "position", 2, GL_SHORT, GL_FALSE, offsetof(opt::PackedVertex, position) },
+		{ "texCoords", 2, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(opt::PackedVertex, texCoords) },
+		{ "colour", 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(opt::PackedVertex, colour) }
+	};
+
+	sf::Int16 quantizePosition(float position, float origin, float step)
+	{
+		const float pas{ std::round((position - origin) / step) };
+		return static_cast<sf::Int16>(std::clamp(pas, static_cast<float>(std::numeric_limits<sf::Int16>::min()),
+			static_cast<float>(std::numeric_limits<sf::Int16>::max())));
+	}
+
+	sf::Uint16 normalizeTexCoord(float texCoord, unsigned textureSize)
+	{
+		if (!textureSize)
+			return 0;
+		return static_cast<sf::Uint16>(std::round(std::clamp(texCoord / static_cast<float>(textureSize), 0.f, 1.f) * 65535.f));
+	}
+}
+
+void opt::PackedVertexBuffer::createResources() const
+{
+	if (!m_buffer)
+	{
+		GLuint tampon{ 0 };
+		glFunctions().genBuffers(1, &tampon);
+		m_buffer = tampon;
+		m_capacity = 0;
+		m_dirty = true;
+	}
+	if (!m_shaderLoaded)
+	{
+		if (!m_shader.loadFromMemory(vertexShader, fragmentShader))
+			throw opt::LoadException("packed vertex shader");
+		m_shaderLoaded = true;
+	}
+}
+
+void opt::PackedVertexBuffer::upload() const
+{
+	if (!m_dirty)
+		return;
+	const GlFunctions& gl{ glFunctions() };
+	gl.bindBuffer(GlFunctions::arrayBuffer, m_buffer);
+	const std::size_t octets{ m_vertexes.size() * sizeof(PackedVertex) };
+	if (m_capacity < m_vertexes.size())
+	{
+		m_capacity = std::max(m_vertexes.size(), m_capacity + m_capacity / 2);
+		gl.bufferData(GlFunctions::arrayBuffer, m_capacity * sizeof(PackedVertex), nullptr, GlFunctions::dynamicDraw);
+	}
+	gl.bufferSubData(GlFunctions::arrayBuffer, 0, octets, m_vertexes.data());
+	gl.bindBuffer(GlFunctions::arrayBuffer, 0);
+	m_uploadedBytes += octets;
+	m_dirty = false;
+}
+
+void opt::PackedVertexBuffer::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	if (m_vertexes.empty() || !target.setActive(true))
+		return;
+	createResources();
+	upload();
+	const GlFunctions& gl{ glFunctions() };
+
+	sf::Transform matrice{ target.getView().getTransform() };
+	matrice *= states.transform;
+	m_shader.setUniform("transform", sf::Glsl::Mat4(matrice));
+	const bool texture{ states.texture && states.texture->getSize().x && states.texture->getSize().y };
+	m_shader.setUniform("textured", texture ? 1.f : 0.f);
+	if (texture)
+		m_shader.setUniform("atlas", *states.texture);
+
+	const sf::IntRect vue{ target.getViewport(target.getView()) };
+	glViewport(vue.left, static_cast<GLint>(target.getSize().y) - (vue.top + vue.height), vue.width, vue.height);
+	gl.applyBlendMode(states.blendMode);
+	sf::Shader::bind(&m_shader);
+
+	const GLuint programme{ m_shader.getNativeHandle() };
+	GLint emplacements[std::size(vertexAttributes)]{};
+	gl.bindBuffer(GlFunctions::arrayBuffer, m_buffer);
+	for (std::size_t i{ 0 }; i < std::size(vertexAttributes); ++i)
+	{
+		const Attribute& attribut{ vertexAttributes[i] };
+		emplacements[i] = gl.getAttribLocation(programme, attribut.name);
+		if (emplacements[i] < 0)
+			continue;
+		gl.enableVertexAttribArray(emplacements[i]);
+		gl.vertexAttribPointer(emplacements[i], attribut.size, attribut.type, attribut.normalized, sizeof(PackedVertex),
+			reinterpret_cast<const void*>(attribut.offset));
+	}
+
+	// Un appel de dessin par morceau, chacun avec son origine et son pas ///
+	// One draw call per chunk, each one with its origin and step
+	for (std::size_t i{ 0 }; i < m_chunks.size(); ++i)
+	{
+		m_shader.setUniform("origin", sf::Glsl::Vec2(m_chunks[i].origin));
+		m_shader.setUniform("step", m_chunks[i].step);
+		const std::size_t debut{ i * chunkVertexes };
+		glDrawArrays(GL_TRIANGLES, static_cast<GLint>(debut), static_cast<GLsizei>(std::min(chunkVertexes, m_vertexes.size() - debut)));
+	}
+
+	for (GLint emplacement : emplacements)
+	{
+		if (emplacement >= 0)
+			gl.disableVertexAttribArray(emplacement);
+	}
+	gl.bindBuffer(GlFunctions::arrayBuffer, 0);
+	sf::Shader::bind(nullptr);
+	// SFML garde un cache des états OpenGL; il doit être réinitialisé après des appels directs ///
+	// SFML keeps a cache of the OpenGL states; it has to be reset after direct calls
+	target.resetGLStates();
+}
+
+bool opt::PackedVertexBuffer::isAvailable()
+{
+	return sf::Shader::isAvailable() && glFunctions().hasBuffers();
+}
+
+opt::PackedVertexBuffer::PackedVertexBuffer() : m_buffer{ 0 }, m_capacity{ 0 }, m_dirty{ false }, m_uploadedBytes{ 0 },
+	m_shaderLoaded{ false }
+{
+}
+
+opt::PackedVertexBuffer::~PackedVertexBuffer()
+{
+	clear();
+}
+
+bool opt::PackedVertexBuffer::update(const std::vector<sf::Vertex>& vertexes, const sf::Texture& texture)
+{
+	m_vertexes.resize(vertexes.size());
+	m_chunks.resize((vertexes.size() + chunkVertexes - 1) / chunkVertexes);
+	m_dirty = true;
+
+	bool exact{ true };
+	const sf::Vector2u tailleTexture{ texture.getSize() };
+	for (std::size_t morceau{ 0 }; morceau < m_chunks.size(); ++morceau)
+	{
+		const std::size_t debut{ morceau * chunkVertexes };
+		const std::size_t fin{ std::min(debut + chunkVertexes, vertexes.size()) };
+		sf::Vector2f minimum{ vertexes[debut].position }, maximum{ minimum };
+		for (std::size_t i{ debut }; i < fin; ++i)
+		{
+			minimum.x = std::min(minimum.x, vertexes[i].position.x);
+			minimum.y = std::min(minimum.y, vertexes[i].position.y);
+			maximum.x = std::max(maximum.x, vertexes[i].position.x);
+			maximum.y = std::max(maximum.y, vertexes[i].position.y);
+		}
+		// Le pas est une puissance de deux : les positions multiples du pas restent exactes ///
+		// The step is a power of two: positions that are multiples of the step stay exact
+		Chunk& donnees{ m_chunks[morceau] };
+		const float etendue{ std::max(maximum.x - minimum.x, maximum.y - minimum.y) };
+		donnees.step = minimumStep;
+		while (etendue > donnees.step * stepsPerExtent)
+			donnees.step *= 2.f;
+		exact = exact && donnees.step <= largestStep;
+		donnees.origin = sf::Vector2f(std::round((minimum.x + maximum.x) / 2.f / donnees.step) * donnees.step,
+			std::round((minimum.y + maximum.y) / 2.f / donnees.step) * donnees.step);
+
+		for (std::size_t i{ debut }; i < fin; ++i)
+		{
+			const sf::Vertex& sommet{ vertexes[i] };
+			PackedVertex& compact{ m_vertexes[i] };
+			compact.position[0] = quantizePosition(sommet.position.x, donnees.origin.x, donnees.step);
+			compact.position[1] = quantizePosition(sommet.position.y, donnees.origin.y, donnees.step);
+			compact.texCoords[0] = normalizeTexCoord(sommet.texCoords.x, tailleTexture.x);
+			compact.texCoords[1] = normalizeTexCoord(sommet.texCoords.y, tailleTexture.y);
+			compact.colour[0] = sommet.color.r;
+			compact.colour[1] = sommet.color.g;
+			compact.colour[2] = sommet.color.b;
+			compact.colour[3] = sommet.color.a;
+		}
+	}
+	return exact;
+}
+
+void opt::PackedVertexBuffer::clear()
+{
+	m_vertexes.clear();
+	m_vertexes.shrink_to_fit();
+	m_chunks.clear();
+	m_dirty = false;
+	if (m_buffer)
+	{
+		sf::Context contexte;
+		const GLuint tampon{ m_buffer };
+		glFunctions().deleteBuffers(1, &tampon);
+		m_buffer = 0;
+		m_capacity = 0;
+	}
+}
+
+std::size_t opt::PackedVertexBuffer::getVertexCount() const
+{
+	return m_vertexes.size();
+}
+
+std::size_t opt::PackedVertexBuffer::takeUploadedBytes()
+{
+	const std::size_t octets{ m_uploadedBytes };
+	m_uploadedBytes = 0;
+	return octets;
+}
+
+std::size_t opt::PackedVertexBuffer::gpuBytes() const
+{
+	return m_capacity * sizeof(PackedVertex);
+}
@@ -0,0 +1,115 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef PACKEDVERTEXBUFFER_H
+#define PACKEDVERTEXBUFFER_H
+
+#include "OptTile.h"
+#include <cstddef>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	/// <summary>
+	/// Sommet compact de 12 octets : position entière relative à l'origine de son morceau, coordonnées de texture normalisées sur 16 bits et couleur ///
+	/// Compact 12-byte vertex: integer position relative to the origin of its chunk, texture coordinates normalized on 16 bits and colour
+	/// </summary>
+	struct OPTTILE_API PackedVertex {
+		// Position en pas de quantification à partir de l'origine /// Position in quantization steps from the origin
+		sf::Int16 position[2];
+		// Coordonnées de texture divisées par la taille de la texture, sur 65535 /// Texture coordinates divided by the texture size, over 65535
+		sf::Uint16 texCoords[2];
+		sf::Uint8 colour[4];
+	};
+
+	/// <summary>
+	/// Tampon de sommets compacts. Les sf::Vertex sont convertis au moment du téléversement, par morceaux de chunkVertexes sommets dessinés chacun
+	/// avec son origine et son pas de quantification : le pas est la plus petite puissance de deux qui couvre l'étendue du morceau ///
+	/// Packed vertex buffer. The sf::Vertex are converted when uploading, by chunks of chunkVertexes vertexes each drawn
+	/// with its origin and quantization step: the step is the smallest power of two covering the extent of the chunk
+	/// </summary>
+	class OPTTILE_API PackedVertexBuffer : public sf::Drawable {
+	private:
+		struct Chunk {
+			sf::Vector2f origin;
+			float step;
+		};
+
+		std::vector<PackedVertex> m_vertexes;
+		// Origine et pas de chaque morceau de chunkVertexes sommets /// Origin and step of each chunk of chunkVertexes vertexes
+		std::vector<Chunk> m_chunks;
+		// Le tampon OpenGL est créé et rempli au dessin, d'où les membres mutables ///
+		// The OpenGL buffer is created and filled when drawing, hence the mutable members
+		mutable unsigned m_buffer;
+		// Nombre de sommets que le tampon peut contenir /// Number of vertexes the buffer can hold
+		mutable std::size_t m_capacity;
+		// Les sommets convertis n'ont pas encore été téléversés /// The converted vertexes have not been uploaded yet
+		mutable bool m_dirty;
+		// Octets téléversés depuis le dernier appel à takeUploadedBytes /// Bytes uploaded since the last call to takeUploadedBytes
+		mutable std::size_t m_uploadedBytes;
+		mutable sf::Shader m_shader;
+		mutable bool m_shaderLoaded;
+
+		void createResources() const;
+
+		void upload() const;
+
+	protected:
+		void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+	public:
+		// Sommets par morceau, multiple de 3 pour ne pas couper de triangle /// Vertexes per chunk, multiple of 3 so no triangle is cut
+		static constexpr std::size_t chunkVertexes{ 3 * 4096 };
+
+		/// <summary>
+		/// Indique si la carte graphique permet les nuanceurs et les tampons nécessaires ///
+		/// Indicates if the graphics card allows the needed shaders and buffers
+		/// </summary>
+		static bool isAvailable();
+
+		PackedVertexBuffer();
+
+		PackedVertexBuffer(const PackedVertexBuffer&) = delete;
+
+		PackedVertexBuffer& operator=(const PackedVertexBuffer&) = delete;
+
+		~PackedVertexBuffer();
+
+		/// <summary>
+		/// Convertit les sommets. Le téléversement est fait au prochain dessin, lorsqu'un contexte est actif ///
+		/// Converts the vertexes. The upload is done at the next draw, when a context is active
+		/// </summary>
+		/// <param name="vertexes">Sommets du niveau /// Vertexes of the level</param>
+		/// <param name="texture">Texture utilisée pour normaliser les coordonnées de texture /// Texture used to normalize the texture coordinates</param>
+		/// <returns>Faux si un morceau s'étend sur plus de 65532 unités : ses positions entières ne sont plus exactes ///
+		/// False if a chunk spans more than 65532 units: its integer positions are no longer exact</returns>
+		bool update(const std::vector<sf::Vertex>& vertexes, const sf::Texture& texture);
+
+		/// <summary>
+		/// Libère les sommets et le tampon ///
+		/// Releases the vertexes and the buffer
+		/// </summary>
+		void clear();
+
+		std::size_t getVertexCount() const;
+
+		/// <summary>
+		/// Retourne les octets téléversés depuis le dernier appel et remet le compte à 0 ///
+		/// Returns the bytes uploaded since the last call and resets the count to 0
+		/// </summary>
+		std::size_t takeUploadedBytes();
+
+		std::size_t gpuBytes() const;
+	};
+}
+
+#endif // !PACKEDVERTEXBUFFER_H
@@ -0,0 +1,122 @@
+#include "pch.h"
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+opt::SpatialGrid::SpatialGrid(unsigned cellSize) : m_cellSize{ cellSize }
+{
+}
+
+std::int64_t opt::SpatialGrid::key(int x, int y)
+{
+	return (static_cast<std::int64_t>(x) << 32) | static_cast<std::uint32_t>(y);
+}
+
+template <class Function>
+void opt::SpatialGrid::forEachCell(const sf::FloatRect& bounds, Function function) const
+{
+	if (bounds.width <= 0.f || bounds.height <= 0.f)
+		return;
+	const float taille{ static_cast<float>(m_cellSize) };
+	// Le bord droit et le bord bas sont exclus : des tuiles qui se touchent ne partagent pas de cellule sans raison ///
+	// The right and bottom edges are excluded: touching tiles do not share a cell for no reason
+	const int droite{ static_cast<int>(std::ceil((bounds.left + bounds.width) / taille)) - 1 };
+	const int bas{ static_cast<int>(std::ceil((bounds.top + bounds.height) / taille)) - 1 };
+	for (int x{ static_cast<int>(std::floor(bounds.left / taille)) }; x <= droite; ++x)
+		for (int y{ static_cast<int>(std::floor(bounds.top / taille)) }; y <= bas; ++y)
+			function(key(x, y));
+}
+
+void opt::SpatialGrid::removeFromCells(std::size_t tile)
+{
+	forEachCell(m_bounds[tile], [&](std::int64_t cle) {
+		const auto cellule{ m_cells.find(cle) };
+		if (cellule == m_cells.end())
+			return;
+		std::vector<std::size_t>& tuiles{ cellule->second };
+		const auto position{ std::find(tuiles.begin(), tuiles.end(), tile) };
+		if (position != tuiles.end())
+		{
+			*position = tuiles.back();
+			tuiles.pop_back();
+		}
+		if (tuiles.empty())
+			m_cells.erase(cellule);
+	});
+}
+
+void opt::SpatialGrid::update(std::size_t tile, const sf::FloatRect& bounds)
+{
+	if (tile >= m_bounds.size())
+		m_bounds.resize(tile + 1);
+	if (m_bounds[tile] == bounds)
+		return;
+	removeFromCells(tile);
+	forEachCell(bounds, [&](std::int64_t cle) { m_cells[cle].push_back(tile); });
+	m_bounds[tile] = bounds;
+}
+
+void opt::SpatialGrid::clear()
+{
+	m_cells.clear();
+	m_bounds.clear();
+}
+
+void opt::SpatialGrid::truncate(std::size_t count)
+{
+	for (std::size_t i{ count }; i < m_bounds.size(); ++i)
+		removeFromCells(i);
+	if (count < m_bounds.size())
+		m_bounds.resize(count);
+}
+
+std::size_t opt::SpatialGrid::size() const
+{
+	return m_bounds.size();
+}
+
+sf::FloatRect opt::SpatialGrid::bounds(std::size_t tile) const
+{
+	return tile < m_bounds.size() ? m_bounds[tile] : sf::FloatRect();
+}
+
+const std::vector<std::size_t>& opt::SpatialGrid::cellAt(const sf::Vector2f& point) const
+{
+	static const std::vector<std::size_t> vide;
+	const float taille{ static_cast<float>(m_cellSize) };
+	const auto cellule{ m_cells.find(key(static_cast<int>(std::floor(point.x / taille)), static_cast<int>(std::floor(point.y / taille)))) };
+	return cellule == m_cells.end() ? vide : cellule->second;
+}
+
+void opt::SpatialGrid::query(const sf::FloatRect& region, std::vector<std::size_t>& tiles) const
+{
+	tiles.clear();
+	if (region.width <= 0.f || region.height <= 0.f)
+		return;
+	// Une région plus grande que la grille occupée parcourt les cellules existantes plutôt que les cellules de la région ///
+	// A region larger than the occupied grid goes through the existing cells rather than the cells of the region
+	const float taille{ static_cast<float>(m_cellSize) };
+	const double largeur{ std::floor((region.left + region.width) / taille) - std::floor(region.left / taille) + 1.0 };
+	const double hauteur{ std::floor((region.top + region.height) / taille) - std::floor(region.top / taille) + 1.0 };
+	if (largeur * hauteur > static_cast<double>(m_cells.size()))
+	{
+		for (const auto& [cle, tuiles] : m_cells)
+			for (std::size_t tuile : tuiles)
+				if (region.intersects(m_bounds[tuile]))
+					tiles.push_back(tuile);
+	}
+	else
+	{
+		forEachCell(region, [&](std::int64_t cle) {
+			const auto cellule{ m_cells.find(cle) };
+			if (cellule == m_cells.end())
+				return;
+			for (std::size_t tuile : cellule->second)
+				if (region.intersects(m_bounds[tuile]))
+					tiles.push_back(tuile);
+		});
+	}
+	// Une tuile sur plusieurs cellules y est trouvée plusieurs fois /// A tile over several cells is found there several times
+	std::sort(tiles.begin(), tiles.end());
+	tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+}
@@ -0,0 +1,88 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "OptTile.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	/// <summary>
+	/// Grille de cellules carrées qui range les tuiles selon leur rectangle, pour trouver celles d'une région sans parcourir tout le niveau ///
+	/// Grid of square cells storing the tiles by their rectangle, to find those of a region without going through the whole level
+	/// </summary>
+	class OPTTILE_API SpatialGrid {
+	private:
+		// Taille en unités du monde d'une cellule /// Size in world units of a cell
+		unsigned m_cellSize;
+		// Tuiles touchant chaque cellule /// Tiles touching each cell
+		std::unordered_map<std::int64_t, std::vector<std::size_t>> m_cells;
+		// Rectangle enregistré de chaque tuile /// Recorded rectangle of each tile
+		std::vector<sf::FloatRect> m_bounds;
+
+		static std::int64_t key(int x, int y);
+
+		template <class Function>
+		void forEachCell(const sf::FloatRect& bounds, Function function) const;
+
+		void removeFromCells(std::size_t tile);
+
+	public:
+		SpatialGrid(unsigned cellSize = 256u);
+
+		/// <summary>
+		/// Range une tuile selon son nouveau rectangle. Un rectangle vide ne touche aucune cellule ///
+		/// Stores a tile by its new rectangle. An empty rectangle touches no cell
+		/// </summary>
+		/// <param name="tile">Index de la tuile /// Tile index</param>
+		/// <param name="bounds">Rectangle global de la tuile /// Global rectangle of the tile</param>
+		void update(std::size_t tile, const sf::FloatRect& bounds);
+
+		void clear();
+
+		/// <summary>
+		/// Retire les tuiles à partir de count ///
+		/// Removes the tiles from count onwards
+		/// </summary>
+		/// <param name="count">Nombre de tuiles gardées /// Number of kept tiles</param>
+		void truncate(std::size_t count);
+
+		std::size_t size() const;
+
+		/// <summary>
+		/// Retourne le rectangle enregistré d'une tuile, vide si elle n'a jamais été rangée ///
+		/// Returns the recorded rectangle of a tile, empty if it was never stored
+		/// </summary>
+		sf::FloatRect bounds(std::size_t tile) const;
+
+		/// <summary>
+		/// Retourne les tuiles qui touchent la cellule d'un point, dont les rectangles ne contiennent pas forcément le point ///
+		/// Returns the tiles touching the cell of a point, whose rectangles do not necessarily contain the point
+		/// </summary>
+		const std::vector<std::size_t>& cellAt(const sf::Vector2f& point) const;
+
+		/// <summary>
+		/// Remplit tiles avec les tuiles, sans doublon et triées par index, dont le rectangle touche la région ///
+		/// Fills tiles with the tiles, without duplicate and sorted by index, whose rectangle touches the region
+		/// </summary>
+		/// <param name="region">Région cherchée /// Searched region</param>
+		/// <param name="tiles">Reçoit les tuiles trouvées /// Receives the found tiles</param>
+		void query(const sf::FloatRect& region, std::vector<std::size_t>& tiles) const;
+	};
+}
+
+#endif // !SPATIALGRID_H
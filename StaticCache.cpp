@@ -0,0 +1,173 @@
+#include "pch.h"
+#include "StaticCache.h"
+#include "Exceptions.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// Le contenu des cellules est gardé en alpha prémultiplié pour que leur composition donne le même résultat qu'un dessin direct ///
+	// Cell content is kept in premultiplied alpha so compositing them gives the same result as a direct draw
+	const sf::BlendMode renderBlend{ sf::BlendMode::SrcAlpha, sf::BlendMode::OneMinusSrcAlpha, sf::BlendMode::Add,
+		sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha, sf::BlendMode::Add };
+	const sf::BlendMode compositeBlend{ sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha };
+}
+
+std::int64_t opt::StaticCache::key(int x, int y)
+{
+	return (static_cast<std::int64_t>(x) << 32) | static_cast<std::uint32_t>(y);
+}
+
+void opt::StaticCache::rebuildLayout(const std::vector<sf::Vertex>& vertexes)
+{
+	std::unordered_map<std::int64_t, Cell> cellules;
+	const float taille{ static_cast<float>(m_cellSize) };
+	for (std::size_t i{ 0 }; i + 2 < vertexes.size(); i += 3)
+	{
+		const float gauche{ std::min({ vertexes[i].position.x, vertexes[i + 1].position.x, vertexes[i + 2].position.x }) };
+		const float droite{ std::max({ vertexes[i].position.x, vertexes[i + 1].position.x, vertexes[i + 2].position.x }) };
+		const float haut{ std::min({ vertexes[i].position.y, vertexes[i + 1].position.y, vertexes[i + 2].position.y }) };
+		const float bas{ std::max({ vertexes[i].position.y, vertexes[i + 1].position.y, vertexes[i + 2].position.y }) };
+		if (gauche == droite || haut == bas)
+			continue;
+		for (int x{ static_cast<int>(std::floor(gauche / taille)) }; x <= static_cast<int>(std::floor(droite / taille)); ++x)
+			for (int y{ static_cast<int>(std::floor(haut / taille)) }; y <= static_cast<int>(std::floor(bas / taille)); ++y)
+			{
+				const std::int64_t cle{ key(x, y) };
+				if (cellules.count(cle))
+					continue;
+				// On garde la texture d'une cellule déjà existante pour éviter de la recréer ///
+				// The texture of an already existing cell is kept to avoid creating it again
+				auto existante{ m_cells.find(cle) };
+				if (existante != m_cells.end())
+					cellules[cle].texture = std::move(existante->second.texture);
+				else
+					cellules[cle];
+			}
+	}
+	m_cells = std::move(cellules);
+	m_layoutDirty = false;
+}
+
+opt::StaticCache::StaticCache(unsigned cellSize) : m_cellSize{ std::max(1u, std::min(cellSize, sf::Texture::getMaximumSize())) }, m_layoutDirty{ true }
+{
+}
+
+void opt::StaticCache::setCellSize(unsigned cellSize)
+{
+	m_cellSize = std::max(1u, std::min(cellSize, sf::Texture::getMaximumSize()));
+	clear();
+}
+
+unsigned opt::StaticCache::cellSize() const
+{
+	return m_cellSize;
+}
+
+void opt::StaticCache::invalidate(const sf::FloatRect& region)
+{
+	if (m_layoutDirty || region.width <= 0.f || region.height <= 0.f)
+		return;
+	const float taille{ static_cast<float>(m_cellSize) };
+	const int gauche{ static_cast<int>(std::floor(region.left / taille)) }, droite{ static_cast<int>(std::floor((region.left + region.width) / taille)) };
+	const int haut{ static_cast<int>(std::floor(region.top / taille)) }, bas{ static_cast<int>(std::floor((region.top + region.height) / taille)) };
+	// Une région plus grande que les cellules occupées coûte moins cher à traiter en recalculant tout ///
+	// A region larger than the occupied cells costs less to handle by computing everything again
+	if ((static_cast<double>(droite) - gauche + 1.0) * (static_cast<double>(bas) - haut + 1.0) > static_cast<double>(m_cells.size()))
+	{
+		invalidate();
+		return;
+	}
+	// Une cellule inoccupée est ajoutée à rendre : seule sa texture sera créée, les autres cellules restent valides ///
+	// An unoccupied cell is added to be rendered: only its texture will be created, the other cells stay valid
+	for (int x{ gauche }; x <= droite; ++x)
+		for (int y{ haut }; y <= bas; ++y)
+			m_cells[key(x, y)].dirty = true;
+}
+
+void opt::StaticCache::invalidate()
+{
+	m_layoutDirty = true;
+	for (auto& [cle, cellule] : m_cells)
+		cellule.dirty = true;
+}
+
+void opt::StaticCache::clear()
+{
+	m_cells.clear();
+	m_layoutDirty = true;
+}
+
+std::size_t opt::StaticCache::render(const sf::VertexBuffer* buffer, const std::vector<sf::Vertex>& vertexes, const sf::Texture& texture, const RangeQuery& ranges, std::size_t& submitted)
+{
+	if (m_layoutDirty)
+		rebuildLayout(vertexes);
+
+	const float taille{ static_cast<float>(m_cellSize) };
+	sf::RenderStates etats{ &texture };
+	etats.blendMode = renderBlend;
+	std::size_t rendues{ 0 };
+	for (auto& [cle, cellule] : m_cells)
+	{
+		if (!cellule.dirty)
+			continue;
+		if (!cellule.texture)
+		{
+			cellule.texture = std::make_unique<sf::RenderTexture>();
+			if (!cellule.texture->create(m_cellSize, m_cellSize))
+				throw opt::LoadException("sf::RenderTexture");
+		}
+		const sf::Vector2f coin{ static_cast<float>(static_cast<std::int32_t>(cle >> 32)) * taille,
+			static_cast<float>(static_cast<std::int32_t>(cle & 0xFFFFFFFF)) * taille };
+		const sf::FloatRect zone{ coin, sf::Vector2f(taille, taille) };
+		cellule.texture->setView(sf::View(zone));
+		cellule.texture->clear(sf::Color::Transparent);
+		for (const auto& [debut, nombre] : ranges(zone))
+		{
+			if (buffer)
+				cellule.texture->draw(*buffer, debut, nombre, etats);
+			else
+				cellule.texture->draw(vertexes.data() + debut, nombre, sf::Triangles, etats);
+			submitted += nombre;
+		}
+		cellule.texture->display();
+		cellule.dirty = false;
+		++rendues;
+	}
+	return rendues;
+}
+
+std::size_t opt::StaticCache::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	const float taille{ static_cast<float>(m_cellSize) };
+	states.blendMode = compositeBlend;
+	std::size_t appels{ 0 };
+	for (const auto& [cle, cellule] : m_cells)
+	{
+		if (!cellule.texture)
+			continue;
+		const sf::Vector2f coin{ static_cast<float>(static_cast<std::int32_t>(cle >> 32)) * taille,
+			static_cast<float>(static_cast<std::int32_t>(cle & 0xFFFFFFFF)) * taille };
+		const sf::Vertex quad[6]{
+			sf::Vertex(coin, sf::Vector2f(0.f, 0.f)),
+			sf::Vertex(coin + sf::Vector2f(0.f, taille), sf::Vector2f(0.f, taille)),
+			sf::Vertex(coin + sf::Vector2f(taille, 0.f), sf::Vector2f(taille, 0.f)),
+			sf::Vertex(coin + sf::Vector2f(0.f, taille), sf::Vector2f(0.f, taille)),
+			sf::Vertex(coin + sf::Vector2f(taille, 0.f), sf::Vector2f(taille, 0.f)),
+			sf::Vertex(coin + sf::Vector2f(taille, taille), sf::Vector2f(taille, taille))
+		};
+		states.texture = &cellule.texture->getTexture();
+		target.draw(quad, 6, sf::Triangles, states);
+		++appels;
+	}
+	return appels;
+}
+
+std::size_t opt::StaticCache::gpuBytes() const
+{
+	std::size_t octets{ 0 };
+	for (const auto& [cle, cellule] : m_cells)
+		if (cellule.texture)
+			octets += static_cast<std::size_t>(m_cellSize) * m_cellSize * 4;
+	return octets;
+}
@@ -0,0 +1,126 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef STATICCACHE_H
+#define STATICCACHE_H
+
+#include "OptTile.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	/// <summary>
+	/// Cache de rendu d'un niveau statique. Le niveau est rendu une fois dans des sf::RenderTexture en cellules carrées, puis redessiné comme quelques quadrilatères texturés.
+	/// Seules les cellules touchées par une modification sont rendues de nouveau ///
+	/// Render cache of a static level. The level is rendered once into square cells of sf::RenderTexture, then redrawn as a few textured quads.
+	/// Only the cells touched by a change are rendered again
+	/// </summary>
+	class OPTTILE_API StaticCache {
+	public:
+		// Retourne les plages [début, nombre) des sommets qui touchent une région ///
+		// Returns the ranges [begin, count) of the vertexes touching a region
+		using RangeQuery = std::function<std::vector<std::pair<std::size_t, std::size_t>>(const sf::FloatRect&)>;
+
+	private:
+		struct Cell {
+			std::unique_ptr<sf::RenderTexture> texture;
+			bool dirty{ true };
+		};
+
+		// Taille en pixels (unités du monde) d'une cellule ///
+		// Size in pixels (world units) of a cell
+		unsigned m_cellSize;
+		// Cellules contenant au moins un sommet, indexées par leur coordonnée de grille ///
+		// Cells containing at least one vertex, indexed by their grid coordinate
+		std::unordered_map<std::int64_t, Cell> m_cells;
+		// Indique si l'ensemble des cellules occupées doit être recalculé ///
+		// Indicates if the set of occupied cells has to be computed again
+		bool m_layoutDirty;
+
+		static std::int64_t key(int x, int y);
+
+		/// <summary>
+		/// Recalcule les cellules occupées à partir des triangles du niveau ///
+		/// Computes again the occupied cells from the triangles of the level
+		/// </summary>
+		void rebuildLayout(const std::vector<sf::Vertex>& vertexes);
+
+	public:
+		/// <summary>
+		/// Crée un cache vide ///
+		/// Creates an empty cache
+		/// </summary>
+		/// <param name="cellSize">Taille d'une cellule en unités du monde /// Size of a cell in world units</param>
+		StaticCache(unsigned cellSize = 1024u);
+
+		/// <summary>
+		/// Change la taille des cellules et invalide tout le cache ///
+		/// Changes the size of the cells and invalidates the whole cache
+		/// </summary>
+		void setCellSize(unsigned cellSize);
+
+		unsigned cellSize() const;
+
+		/// <summary>
+		/// Marque les cellules touchant la région comme étant à rendre de nouveau. Une cellule inoccupée devient occupée et sera rendue;
+		/// une cellule vidée reste occupée jusqu'à la prochaine invalidation complète ///
+		/// Marks the cells touching the region as needing a new render. An unoccupied cell becomes occupied and will be rendered;
+		/// an emptied cell stays occupied until the next full invalidation
+		/// </summary>
+		/// <param name="region">Région modifiée, en unités du monde /// Modified region, in world units</param>
+		void invalidate(const sf::FloatRect& region);
+
+		/// <summary>
+		/// Invalide tout le cache. Les cellules occupées seront recalculées ///
+		/// Invalidates the whole cache. Occupied cells will be computed again
+		/// </summary>
+		void invalidate();
+
+		/// <summary>
+		/// Libère toutes les textures du cache ///
+		/// Frees every texture of the cache
+		/// </summary>
+		void clear();
+
+		/// <summary>
+		/// Rend de nouveau les cellules invalidées. Chaque cellule ne dessine que les plages de sommets qui la touchent,
+		/// depuis le sf::VertexBuffer du niveau ou, sans tampon, depuis ses sommets ///
+		/// Renders again the invalidated cells. Each cell only draws the vertex ranges touching it,
+		/// from the level's sf::VertexBuffer or, without a buffer, from its vertexes
+		/// </summary>
+		/// <param name="buffer">Tampon des sommets, ou nullptr /// Buffer of the vertexes, or nullptr</param>
+		/// <param name="ranges">Plages de sommets touchant une cellule /// Vertex ranges touching a cell</param>
+		/// <param name="submitted">Reçoit en plus le nombre de sommets dessinés /// Receives in addition the number of drawn vertexes</param>
+		/// <returns>Nombre de cellules rendues /// Number of rendered cells</returns>
+		std::size_t render(const sf::VertexBuffer* buffer, const std::vector<sf::Vertex>& vertexes, const sf::Texture& texture, const RangeQuery& ranges, std::size_t& submitted);
+
+		/// <summary>
+		/// Dessine chaque cellule comme un quadrilatère texturé ///
+		/// Draws each cell as a textured quad
+		/// </summary>
+		/// <returns>Nombre d'appels de dessin /// Number of draw calls</returns>
+		std::size_t draw(sf::RenderTarget& target, sf::RenderStates states) const;
+
+		/// <summary>
+		/// Retourne la mémoire graphique occupée par les textures du cache ///
+		/// Returns the GPU memory held by the cache's textures
+		/// </summary>
+		std::size_t gpuBytes() const;
+	};
+}
+
+#endif // !STATICCACHE_H
@@ -0,0 +1,297 @@
+#include "pch.h"
+#include "StreamingWorld.h"
+#include "Level.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <utility>
+
+namespace
+{
+	// Mémoire comptée pour un tronçon en plus de ses sommets, pour que les tronçons vides soient aussi évincés ///
+	// Memory counted for a chunk on top of its vertexes, so empty chunks are evicted too
+	constexpr std::size_t chunkOverhead{ 256 };
+}
+
+std::uint64_t opt::StreamingWorld::key(int x, int y)
+{
+	return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+}
+
+sf::Vector2i opt::StreamingWorld::coordinates(std::uint64_t key)
+{
+	return sf::Vector2i(static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32)), static_cast<std::int32_t>(static_cast<std::uint32_t>(key)));
+}
+
+opt::StreamingWorld::StreamingWorld(const Level& atlas, const std::string& directory, float chunkSize) :
+	m_directory{ directory }, m_chunkSize{ chunkSize }, m_texture{ &atlas.getTexture() }, m_subTextures{ atlas.getSubTextures() },
+	m_prefetchRadius{ chunkSize }, m_memoryBudget{ 256ull << 20 }, m_uploadBudget{ 4ull << 20 }, m_residentBytes{ 0 },
+	m_stop{ false }
+{
+	m_loader = std::thread(&StreamingWorld::load, this);
+}
+
+opt::StreamingWorld::~StreamingWorld()
+{
+	{
+		std::lock_guard<std::mutex> verrou{ m_mutex };
+		m_stop = true;
+	}
+	m_wake.notify_all();
+	m_loader.join();
+}
+
+std::string opt::StreamingWorld::chunkPath(const std::string& directory, int x, int y)
+{
+	return (std::filesystem::path(directory) / (std::to_string(x) + "_" + std::to_string(y) + ".chunk")).string();
+}
+
+std::size_t opt::StreamingWorld::split(const Level& level, const std::string& directory, float chunkSize, LevelFile::Encoding encoding)
+{
+	std::map<std::pair<int, int>, std::vector<TileRecord>> troncons;
+	for (const TileRecord& tuile : level.records())
+	{
+		const int x{ static_cast<int>(std::floor(tuile.rect.left / chunkSize)) };
+		const int y{ static_cast<int>(std::floor(tuile.rect.top / chunkSize)) };
+		troncons[{ x, y }].push_back(tuile);
+	}
+	std::filesystem::create_directories(directory);
+	for (const auto& [coordonnees, tuiles] : troncons)
+		LevelFile::save(chunkPath(directory, coordonnees.first, coordonnees.second), tuiles, encoding);
+	return troncons.size();
+}
+
+void opt::StreamingWorld::load()
+{
+	std::unique_lock<std::mutex> verrou{ m_mutex };
+	while (true)
+	{
+		m_wake.wait(verrou, [this] { return m_stop || !m_requests.empty(); });
+		if (m_stop)
+			return;
+		Built troncon{ m_requests.front() };
+		m_requests.pop_front();
+		verrou.unlock();
+
+		std::exception_ptr erreur;
+		try
+		{
+			build(troncon);
+		}
+		catch (...)
+		{
+			erreur = std::current_exception();
+			troncon.failed = true;
+		}
+
+		verrou.lock();
+		if (erreur && !m_error)
+			m_error = erreur;
+		m_built.push_back(std::move(troncon));
+	}
+}
+
+void opt::StreamingWorld::build(Built& chunk) const
+{
+	const sf::Vector2i position{ coordinates(chunk.key) };
+	std::ifstream fichier{ chunkPath(m_directory, position.x, position.y), std::ios::binary };
+	if (!fichier)
+		return;
+	LevelFile::buildVertexes(LevelFile::read(fichier), m_subTextures, chunk.vertexes);
+	if (chunk.vertexes.empty())
+		return;
+
+	sf::Vector2f minimum{ chunk.vertexes[0].position };
+	sf::Vector2f maximum{ minimum };
+	for (const sf::Vertex& sommet : chunk.vertexes)
+	{
+		minimum.x = std::min(minimum.x, sommet.position.x);
+		minimum.y = std::min(minimum.y, sommet.position.y);
+		maximum.x = std::max(maximum.x, sommet.position.x);
+		maximum.y = std::max(maximum.y, sommet.position.y);
+	}
+	chunk.bounds = sf::FloatRect(minimum, maximum - minimum);
+}
+
+float opt::StreamingWorld::distanceToCamera(std::uint64_t key) const
+{
+	const sf::Vector2i position{ coordinates(key) };
+	const sf::Vector2f ecart{ (position.x + 0.5f) * m_chunkSize - m_cameraCentre.x, (position.y + 0.5f) * m_chunkSize - m_cameraCentre.y };
+	return ecart.x * ecart.x + ecart.y * ecart.y;
+}
+
+void opt::StreamingWorld::evict(std::uint64_t key)
+{
+	const auto troncon{ m_chunks.find(key) };
+	if (troncon == m_chunks.end())
+		return;
+	if (troncon->second.resident)
+	{
+		m_residentBytes -= troncon->second.bytes;
+		m_recent.erase(troncon->second.recent);
+	}
+	m_chunks.erase(troncon);
+}
+
+void opt::StreamingWorld::prefetchRadius(float radius)
+{
+	m_prefetchRadius = radius;
+}
+
+void opt::StreamingWorld::memoryBudget(std::size_t bytes)
+{
+	m_memoryBudget = bytes;
+}
+
+void opt::StreamingWorld::uploadBudget(std::size_t bytesPerUpdate)
+{
+	m_uploadBudget = bytesPerUpdate;
+}
+
+void opt::StreamingWorld::setCamera(const sf::View& view)
+{
+	m_cameraCentre = view.getCenter();
+	const sf::Vector2f demiTaille{ view.getSize().x / 2.f + m_prefetchRadius, view.getSize().y / 2.f + m_prefetchRadius };
+	const int gauche{ static_cast<int>(std::floor((m_cameraCentre.x - demiTaille.x) / m_chunkSize)) };
+	const int haut{ static_cast<int>(std::floor((m_cameraCentre.y - demiTaille.y) / m_chunkSize)) };
+	const int droite{ static_cast<int>(std::floor((m_cameraCentre.x + demiTaille.x) / m_chunkSize)) };
+	const int bas{ static_cast<int>(std::floor((m_cameraCentre.y + demiTaille.y) / m_chunkSize)) };
+
+	for (auto& [cle, troncon] : m_chunks)
+		troncon.wanted = false;
+	std::vector<std::uint64_t> nouveaux;
+	for (int y{ haut }; y <= bas; ++y)
+		for (int x{ gauche }; x <= droite; ++x)
+		{
+			const std::uint64_t cle{ key(x, y) };
+			const auto [troncon, insere] { m_chunks.try_emplace(cle) };
+			troncon->second.wanted = true;
+			if (insere)
+				nouveaux.push_back(cle);
+			else if (troncon->second.resident)
+				m_recent.splice(m_recent.begin(), m_recent, troncon->second.recent);
+		}
+
+	std::vector<std::uint64_t> annules;
+	{
+		std::lock_guard<std::mutex> verrou{ m_mutex };
+		// Les demandes pas encore commencées hors de la zone sont annulées ///
+		// Requests not started yet outside the area are cancelled
+		for (std::uint64_t cle : m_requests)
+			if (!m_chunks.at(cle).wanted)
+				annules.push_back(cle);
+		std::erase_if(m_requests, [this](std::uint64_t cle) { return !m_chunks.at(cle).wanted; });
+		m_requests.insert(m_requests.end(), nouveaux.begin(), nouveaux.end());
+		std::sort(m_requests.begin(), m_requests.end(), [this](std::uint64_t a, std::uint64_t b) {
+			return distanceToCamera(a) < distanceToCamera(b);
+		});
+	}
+	if (!nouveaux.empty())
+		m_wake.notify_one();
+	for (std::uint64_t cle : annules)
+		m_chunks.erase(cle);
+}
+
+std::size_t opt::StreamingWorld::update()
+{
+	std::vector<Built> construits;
+	std::exception_ptr erreur;
+	{
+		std::lock_guard<std::mutex> verrou{ m_mutex };
+		construits.swap(m_built);
+		std::swap(erreur, m_error);
+	}
+	for (Built& troncon : construits)
+		m_ready.push_back(std::move(troncon));
+
+	std::size_t nbTeleverses{ 0 };
+	std::size_t octets{ 0 };
+	while (!m_ready.empty())
+	{
+		Built& pret{ m_ready.front() };
+		const std::size_t taille{ pret.vertexes.size() * sizeof(sf::Vertex) };
+		if (nbTeleverses != 0 && octets + taille > m_uploadBudget)
+			break;
+		const auto troncon{ m_chunks.find(pret.key) };
+		// Un tronçon sorti de la zone pendant sa construction n'est pas téléversé. Un tronçon en échec est oublié plutôt que
+		// rendu résident vide, pour que la prochaine demande le relise ///
+		// A chunk which left the area while being built is not uploaded. A failed chunk is forgotten instead of
+		// made resident empty, so the next request reads it again
+		if (troncon != m_chunks.end() && (!troncon->second.wanted || pret.failed))
+			m_chunks.erase(troncon);
+		else if (troncon != m_chunks.end())
+		{
+			Chunk& resident{ troncon->second };
+			resident.vertexCount = pret.vertexes.size();
+			resident.bounds = pret.bounds;
+			if (resident.vertexCount != 0 && sf::VertexBuffer::isAvailable())
+			{
+				resident.buffer.create(resident.vertexCount);
+				resident.buffer.update(pret.vertexes.data());
+			}
+			else
+				resident.vertexes = std::move(pret.vertexes);
+			resident.bytes = taille + chunkOverhead;
+			resident.resident = true;
+			m_recent.push_front(pret.key);
+			resident.recent = m_recent.begin();
+			m_residentBytes += resident.bytes;
+			octets += taille;
+			++nbTeleverses;
+		}
+		m_ready.pop_front();
+	}
+
+	// Les tronçons demandés sont en tête de liste : l'éviction s'arrête au premier ///
+	// Requested chunks are at the front of the list: eviction stops at the first one
+	while (m_residentBytes > m_memoryBudget && !m_recent.empty() && !m_chunks.at(m_recent.back()).wanted)
+		evict(m_recent.back());
+
+	if (erreur)
+		std::rethrow_exception(erreur);
+	return nbTeleverses;
+}
+
+void opt::StreamingWorld::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	const sf::View& vue{ target.getView() };
+	const sf::FloatRect visible{ vue.getCenter() - vue.getSize() / 2.f, vue.getSize() };
+	states.texture = m_texture;
+	// Ordre de dessin fixe (ligne par ligne) pour que les tuiles qui débordent sur un voisin ne changent pas de plan selon l'éviction ///
+	// Fixed drawing order (row by row) so tiles overflowing on a neighbour do not change depth depending on eviction
+	std::vector<sf::Vector2i> visibles;
+	for (std::uint64_t cle : m_recent)
+	{
+		const Chunk& troncon{ m_chunks.at(cle) };
+		if (troncon.vertexCount != 0 && troncon.bounds.intersects(visible))
+			visibles.push_back(coordinates(cle));
+	}
+	std::sort(visibles.begin(), visibles.end(), [](const sf::Vector2i& a, const sf::Vector2i& b) {
+		return a.y != b.y ? a.y < b.y : a.x < b.x;
+	});
+	for (const sf::Vector2i& position : visibles)
+	{
+		const Chunk& troncon{ m_chunks.at(key(position.x, position.y)) };
+		if (troncon.vertexes.empty())
+			target.draw(troncon.buffer, states);
+		else
+			target.draw(troncon.vertexes.data(), troncon.vertexes.size(), sf::Triangles, states);
+	}
+}
+
+std::size_t opt::StreamingWorld::residentChunks() const
+{
+	return m_recent.size();
+}
+
+std::size_t opt::StreamingWorld::residentBytes() const
+{
+	return m_residentBytes;
+}
+
+std::size_t opt::StreamingWorld::pendingChunks() const
+{
+	return m_chunks.size() - m_recent.size();
+}
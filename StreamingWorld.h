@@ -0,0 +1,203 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef STREAMINGWORLD_H
+#define STREAMINGWORLD_H
+
+#include "OptTile.h"
+#include "LevelFile.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace opt
+{
+	class Level;
+
+	/// <summary>
+	/// Monde trop grand pour tenir en mémoire comme un seul Level, découpé en fichiers de tronçons carrés (voir split).
+	/// Un fil de chargement lit les tronçons autour de la caméra et construit leurs sommets; le fil de rendu ne fait que les téléverser.
+	/// Les tronçons résidents ne gardent que leur tampon graphique et sont évincés du moins récemment vu au plus récent lorsque le budget mémoire est dépassé.
+	/// Le monde est en lecture seule : les tuiles se modifient dans un Level, puis sont découpées de nouveau ///
+	/// World too big to fit in memory as one Level, divided into square chunk files (see split).
+	/// A loading thread reads the chunks around the camera and builds their vertexes; the render thread only uploads them.
+	/// Resident chunks keep only their GPU buffer and are evicted from least to most recently seen when the memory budget is exceeded.
+	/// The world is read-only: tiles are edited inside a Level, then split again
+	/// </summary>
+	class OPTTILE_API StreamingWorld : public sf::Drawable {
+	private:
+		struct Chunk {
+			// Tronçon dans la zone demandée par la caméra /// Chunk inside the area requested by the camera
+			bool wanted{ true };
+			bool resident{ false };
+			sf::VertexBuffer buffer{ sf::Triangles, sf::VertexBuffer::Static };
+			// Sommets gardés seulement sans sf::VertexBuffer /// Vertexes kept only without sf::VertexBuffer
+			std::vector<sf::Vertex> vertexes;
+			std::size_t vertexCount{ 0 };
+			// Rectangle couvert par les sommets /// Rectangle covered by the vertexes
+			sf::FloatRect bounds;
+			std::size_t bytes{ 0 };
+			std::list<std::uint64_t>::iterator recent;
+		};
+
+		struct Built {
+			std::uint64_t key;
+			std::vector<sf::Vertex> vertexes{};
+			sf::FloatRect bounds{};
+			// La construction a lancé une exception /// The build threw an exception
+			bool failed{ false };
+		};
+
+		std::string m_directory;
+		float m_chunkSize;
+		const sf::Texture* m_texture;
+		// Copie des sous-textures de l'atlas, lue par le fil de chargement ///
+		// Copy of the atlas subtextures, read by the loading thread
+		std::vector<sf::FloatRect> m_subTextures;
+		float m_prefetchRadius;
+		std::size_t m_memoryBudget;
+		std::size_t m_uploadBudget;
+		std::size_t m_residentBytes;
+
+		// Fil de rendu seulement /// Render thread only
+		std::unordered_map<std::uint64_t, Chunk> m_chunks;
+		// Tronçons résidents, du plus récemment vu au moins récemment vu /// Resident chunks, from most to least recently seen
+		std::list<std::uint64_t> m_recent;
+		// Tronçons construits qui attendent leur téléversement /// Built chunks waiting for their upload
+		std::deque<Built> m_ready;
+		sf::Vector2f m_cameraCentre;
+
+		// Partagés avec le fil de chargement, protégés par m_mutex /// Shared with the loading thread, guarded by m_mutex
+		std::mutex m_mutex;
+		std::condition_variable m_wake;
+		std::deque<std::uint64_t> m_requests;
+		std::vector<Built> m_built;
+		std::exception_ptr m_error;
+		bool m_stop;
+		std::thread m_loader;
+
+		static std::uint64_t key(int x, int y);
+		static sf::Vector2i coordinates(std::uint64_t key);
+
+		/// <summary>
+		/// Boucle du fil de chargement ///
+		/// Loading thread loop
+		/// </summary>
+		void load();
+
+		/// <summary>
+		/// Lit un tronçon et construit ses sommets. Un fichier absent donne un tronçon vide ///
+		/// Reads a chunk and builds its vertexes. A missing file gives an empty chunk
+		/// </summary>
+		void build(Built& chunk) const;
+
+		float distanceToCamera(std::uint64_t key) const;
+
+		void evict(std::uint64_t key);
+
+	public:
+		/// <summary>
+		/// Commence à servir les tronçons écrits par split dans un dossier ///
+		/// Starts serving the chunks written by split inside a directory
+		/// </summary>
+		/// <param name="atlas">Niveau fournissant la texture, qui doit vivre plus longtemps que le monde, et les sous-textures, copiées ///
+		/// Level giving the texture, which must outlive the world, and the subtextures, copied</param>
+		/// <param name="directory">Dossier des tronçons /// Chunks directory</param>
+		/// <param name="chunkSize">Côté d'un tronçon en unités du monde, le même que pour split /// Side of a chunk in world units, the same as for split</param>
+		StreamingWorld(const Level& atlas, const std::string& directory, float chunkSize);
+
+		StreamingWorld(const StreamingWorld&) = delete;
+
+		StreamingWorld& operator=(const StreamingWorld&) = delete;
+
+		~StreamingWorld();
+
+		/// <summary>
+		/// Découpe un niveau en fichiers de tronçons. Une tuile appartient au tronçon de son coin supérieur gauche ///
+		/// Splits a level into chunk files. A tile belongs to the chunk of its top left corner
+		/// </summary>
+		/// <param name="level">Niveau à découper /// Level to split</param>
+		/// <param name="directory">Dossier des tronçons, créé au besoin /// Chunks directory, created if needed</param>
+		/// <param name="chunkSize">Côté d'un tronçon en unités du monde /// Side of a chunk in world units</param>
+		/// <param name="encoding">Encodage des tuiles /// Tiles encoding</param>
+		/// <returns>Nombre de fichiers écrits /// Number of written files</returns>
+		static std::size_t split(const Level& level, const std::string& directory, float chunkSize,
+			LevelFile::Encoding encoding = LevelFile::Encoding::compact);
+
+		/// <summary>
+		/// Retourne le chemin du fichier d'un tronçon ///
+		/// Returns the path of a chunk's file
+		/// </summary>
+		static std::string chunkPath(const std::string& directory, int x, int y);
+
+		/// <summary>
+		/// Distance autour de la vue dans laquelle les tronçons sont chargés d'avance. Les tuiles ne devraient pas dépasser de leur tronçon de plus que cette distance ///
+		/// Distance around the view inside which chunks are loaded ahead. Tiles should not overflow their chunk by more than this distance
+		/// </summary>
+		void prefetchRadius(float radius);
+
+		/// <summary>
+		/// Mémoire maximale des tronçons résidents. Les tronçons dans la zone demandée ne sont jamais évincés, même au-delà du budget ///
+		/// Maximum memory of the resident chunks. Chunks inside the requested area are never evicted, even above the budget
+		/// </summary>
+		void memoryBudget(std::size_t bytes);
+
+		/// <summary>
+		/// Octets téléversés au plus par appel à update; un tronçon est toujours téléversé même s'il dépasse le budget ///
+		/// Bytes uploaded at most per call to update; one chunk is always uploaded even if it exceeds the budget
+		/// </summary>
+		void uploadBudget(std::size_t bytesPerUpdate);
+
+		/// <summary>
+		/// Demande les tronçons couvrant la vue élargie du rayon de préchargement, les plus proches du centre en premier.
+		/// Les demandes qui ne sont plus dans la zone et pas encore commencées sont annulées ///
+		/// Requests the chunks covering the view enlarged by the prefetch radius, closest to the centre first.
+		/// Requests no longer inside the area and not started yet are cancelled
+		/// </summary>
+		void setCamera(const sf::View& view);
+
+		/// <summary>
+		/// Téléverse les tronçons construits, dans la limite du budget de téléversement, puis évince au-delà du budget mémoire. À appeler à chaque image depuis le fil de rendu ///
+		/// Uploads the built chunks, within the upload budget, then evicts above the memory budget. To call every frame from the render thread
+		/// </summary>
+		/// <returns>Nombre de tronçons téléversés /// Number of uploaded chunks</returns>
+		/// <exception cref="Exception">Première erreur rencontrée par le fil de chargement. Le tronçon en échec est oublié et redemandé par le prochain setCamera qui le couvre ///
+		/// First error met by the loading thread. The failed chunk is forgotten and requested again by the next setCamera covering it</exception>
+		std::size_t update();
+
+		/// <summary>
+		/// Dessine les tronçons résidents qui touchent la vue de la cible ///
+		/// Draws the resident chunks touching the target's view
+		/// </summary>
+		virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+
+		std::size_t residentChunks() const;
+
+		std::size_t residentBytes() const;
+
+		/// <summary>
+		/// Retourne le nombre de tronçons demandés qui ne sont pas encore résidents ///
+		/// Returns the number of requested chunks which are not resident yet
+		/// </summary>
+		std::size_t pendingChunks() const;
+	};
+}
+
+#endif // !STREAMINGWORLD_H
@@ -0,0 +1,65 @@
+#include "pch.h"
+#include "SubTextureIndex.h"
+
+namespace
+{
+	// Une tuile qui n'est pas encore enregistrée /// A tile not recorded yet
+	constexpr std::size_t noSlot{ static_cast<std::size_t>(-1) };
+}
+
+void opt::SubTextureIndex::remove(std::size_t tile)
+{
+	// Retrait par échange avec la dernière tuile de la liste : la tuile déplacée change d'emplacement ///
+	// Removal by swapping with the last tile of the list: the moved tile changes its slot
+	std::vector<std::size_t>& tuiles{ m_tiles[m_subTextures[tile]] };
+	const std::size_t emplacement{ m_slots[tile] };
+	tuiles[emplacement] = tuiles.back();
+	m_slots[tuiles[emplacement]] = emplacement;
+	tuiles.pop_back();
+	m_slots[tile] = noSlot;
+}
+
+void opt::SubTextureIndex::update(std::size_t tile, int subTexture)
+{
+	if (tile >= m_slots.size())
+	{
+		m_slots.resize(tile + 1, noSlot);
+		m_subTextures.resize(tile + 1, 0);
+	}
+	if (m_slots[tile] != noSlot)
+	{
+		if (m_subTextures[tile] == subTexture)
+			return;
+		remove(tile);
+	}
+	std::vector<std::size_t>& tuiles{ m_tiles[subTexture] };
+	m_slots[tile] = tuiles.size();
+	m_subTextures[tile] = subTexture;
+	tuiles.push_back(tile);
+}
+
+const std::vector<std::size_t>& opt::SubTextureIndex::tilesUsing(int subTexture) const
+{
+	static const std::vector<std::size_t> aucune;
+	const auto iterateur{ m_tiles.find(subTexture) };
+	return iterateur == m_tiles.end() ? aucune : iterateur->second;
+}
+
+void opt::SubTextureIndex::truncate(std::size_t count)
+{
+	for (std::size_t i{ count }; i < m_slots.size(); ++i)
+		if (m_slots[i] != noSlot)
+			remove(i);
+	if (m_slots.size() > count)
+	{
+		m_slots.resize(count);
+		m_subTextures.resize(count);
+	}
+}
+
+void opt::SubTextureIndex::clear()
+{
+	m_tiles.clear();
+	m_subTextures.clear();
+	m_slots.clear();
+}
@@ -0,0 +1,63 @@
+///
+/// Version de la bibliothèque datant de 2023 - Library writen in 2023
+/// 
+/// ========================================================================================
+/// ========================================================================================
+/// 
+///	Fait par Charles Mandziuk. Aucune mention n'est nécessaire, mais est toujours appréciée
+/// 
+/// Writen by Charles Mandziuk. No any mention is mendatory, but is always appreciated
+///
+
+#ifndef SUBTEXTUREINDEX_H
+#define SUBTEXTUREINDEX_H
+
+#include "OptTile.h"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace opt
+{
+	/// <summary>
+	/// Index inverse de la sous-texture vers les tuiles qui l'utilisent, mis à jour à chaque changement de tuile ///
+	/// Reverse index from a subtexture to the tiles using it, updated at each tile change
+	/// </summary>
+	class OPTTILE_API SubTextureIndex {
+	private:
+		// Tuiles de chaque sous-texture, sans ordre particulier /// Tiles of each subtexture, in no particular order
+		std::unordered_map<int, std::vector<std::size_t>> m_tiles;
+		// Sous-texture enregistrée pour chaque tuile /// Subtexture recorded for each tile
+		std::vector<int> m_subTextures;
+		// Emplacement de chaque tuile dans la liste de sa sous-texture /// Slot of each tile inside the list of its subtexture
+		std::vector<std::size_t> m_slots;
+
+		void remove(std::size_t tile);
+
+	public:
+		/// <summary>
+		/// Enregistre la sous-texture d'une tuile. Ne fait rien si elle n'a pas changé ///
+		/// Records the subtexture of a tile. Does nothing if it did not change
+		/// </summary>
+		/// <param name="tile">Index de la tuile /// Tile index</param>
+		/// <param name="subTexture">Index de la sous-texture /// Subtexture index</param>
+		void update(std::size_t tile, int subTexture);
+
+		/// <summary>
+		/// Retourne les tuiles utilisant la sous-texture, sans ordre particulier ///
+		/// Returns the tiles using the subtexture, in no particular order
+		/// </summary>
+		const std::vector<std::size_t>& tilesUsing(int subTexture) const;
+
+		void clear();
+
+		/// <summary>
+		/// Oublie les tuiles à partir de count ///
+		/// Forgets the tiles from count onwards
+		/// </summary>
+		/// <param name="count">Nombre de tuiles gardées /// Number of kept tiles</param>
+		void truncate(std::size_t count);
+	};
+}
+
+#endif // !SUBTEXTUREINDEX_H
@@ -1,120 +1,160 @@
 #include "pch.h"
 #include "Tile.h"
-#include "Tile.h"
+#include "LevelStats.h"
+#include <algorithm>
 
 void opt::Tile::moveVertexes(int nbVertexes)
 {
-	m_vertexes->resize(m_vertexes->size() - m_tileVertexesCount + nbVertexes);
+	const int difference{ nbVertexes - static_cast<int>(m_tileVertexesCount) };
+	if (difference == 0)
+		return;
 
-	int difference{ nbVertexes - static_cast<int>(m_tileVertexesCount) }; // On met dans cet ordre pour que si le nombre est plus petit, le vector rappetisse
-	if (difference < 0 && m_tileIndex < m_beginTiles->size() - 1)
+	// Sommets situs aprs la tuile, qui doivent tre dcals de la diffrence ///
+	// Vertexes located after the tile, which have to be shifted by the difference
+	const std::size_t finTuile{ m_beginTiles->at(m_tileIndex) + m_tileVertexesCount };
+	const std::size_t nbDeplaces{ m_vertexes->size() - finTuile };
+	if (difference > 0)
 	{
-		for (std::size_t i{ m_beginTiles->at(m_tileIndex + 1) }; i < m_vertexes->size(); ++i)
-			m_vertexes->at(i + difference) = m_vertexes->at(i);
-		m_vertexes->resize(m_vertexes->size() - m_tileVertexesCount + nbVertexes);
-		for (std::size_t i{m_tileIndex + 1}; i < m_beginTiles->size(); ++i)
-			m_beginTiles->at(i) += difference;
+		m_vertexes->resize(m_vertexes->size() + difference);
+		std::move_backward(m_vertexes->begin() + finTuile, m_vertexes->begin() + finTuile + nbDeplaces, m_vertexes->end());
 	}
-	else if (difference > 0 && m_tileIndex < m_beginTiles->size() - 1)
+	else
 	{
+		std::move(m_vertexes->begin() + finTuile, m_vertexes->end(), m_vertexes->begin() + finTuile + difference);
 		m_vertexes->resize(m_vertexes->size() + difference);
-		for (std::size_t i{ m_vertexes->size() - 1 }; i > m_beginTiles->at(m_tileIndex + 1) + difference; --i)
-			m_vertexes->at(i) = m_vertexes->at(i - difference);
-		for (std::size_t i{m_tileIndex + 1}; i < m_beginTiles->size(); ++i)
-			m_beginTiles->at(i) += difference;
+	}
+	// Tant que le niveau range les tuiles dans l'ordre de leur index, seules les tuiles suivantes sont dcales.
+	// Aprs Level::optimizeLayout, toutes celles qui commencent aprs la tuile le sont ///
+	// While the level stores the tiles in the order of their index, only the following tiles are shifted.
+	// After Level::optimizeLayout, every tile beginning after this one is
+	if (m_indexOrder && *m_indexOrder)
+	{
+		for (std::size_t i{ m_tileIndex + 1 }; i < m_beginTiles->size(); ++i)
+			(*m_beginTiles)[i] += difference;
+	}
+	else
+	{
+		for (std::size_t i{ 0 }; i < m_beginTiles->size(); ++i)
+			if (i != m_tileIndex && (*m_beginTiles)[i] >= finTuile)
+				(*m_beginTiles)[i] += difference;
 	}
 	m_tileVertexesCount = nbVertexes;
+	OPTTILE_STAT(if (m_stats) m_stats->shiftedVertexes += nbDeplaces);
 }
 
-void opt::Tile::intializeVertexes()
+sf::Vector2f opt::Tile::resolvedScale(const sf::FloatRect& tileRect, const sf::FloatRect* subTexture, TextureRule textureRule, const sf::Vector2f& scale)
 {
-	if (!m_subTextures || m_tileRect.getSize() == sf::Vector2f())
-	{
-		const sf::Vector2f& position{ m_tileRect.getPosition() };
-		moveVertexes(6);
-		m_textureRule = TextureRule::fill_space;
-		(*m_vertexes)[m_beginTiles->at(m_tileIndex)].position = position;
-		(*m_vertexes)[m_beginTiles->at(m_tileIndex) + 1].position = position + sf::Vector2f(0.f, m_tileRect.height);
-		(*m_vertexes)[m_beginTiles->at(m_tileIndex) + 2].position = position + sf::Vector2f(m_tileRect.width, 0.f);
-		(*m_vertexes)[m_beginTiles->at(m_tileIndex) + 3].position = (*m_vertexes)[m_beginTiles->at(m_tileIndex) + 1].position;
-		(*m_vertexes)[m_beginTiles->at(m_tileIndex) + 4].position = (*m_vertexes)[m_beginTiles->at(m_tileIndex) + 2].position;
-		(*m_vertexes)[m_beginTiles->at(m_tileIndex) + 5].position = position + m_tileRect.getSize();
-		for (int i{ 0 }; i < m_tileVertexesCount; ++i)
-			(*m_vertexes)[i + m_beginTiles->at(m_tileIndex)].color = m_colour;
-		return;
-	}
+	if (!subTexture || textureRule != TextureRule::fill_space)
+		return scale;
+	return sf::Vector2f(tileRect.width / subTexture->width, tileRect.height / subTexture->height);
+}
 
-	sf::Vector2f coinGaucheSommet;
-	std::size_t indexSommet{ m_beginTiles->at(m_tileIndex) };
-	sf::Vector2f textureSize{m_subTextures->at(m_subTextureIndex).width, m_subTextures->at(m_subTextureIndex).height};
-	sf::Vector2f texturePosition{m_subTextures->at(m_subTextureIndex).left, m_subTextures->at(m_subTextureIndex).top};
+std::size_t opt::Tile::vertexCount(const sf::FloatRect& tileRect, const sf::FloatRect* subTexture, const sf::Vector2f& scale)
+{
+	if (!subTexture || tileRect.getSize() == sf::Vector2f())
+		return 6;
+	// Pourquoi on multiplie par 6? Car il faut 6 sommets pour faire un carr de tuile
+	return static_cast<std::size_t>(static_cast<int>(std::ceil(tileRect.width / (subTexture->width * scale.x))
+		* std::ceil(tileRect.height / (subTexture->height * scale.y))
+		* 6));
+}
 
-	if (m_textureRule == TextureRule::fill_space)
+void opt::Tile::writeVertexes(sf::Vertex* vertexes, const sf::FloatRect& tileRect, const sf::FloatRect* subTexture,
+	const sf::Vector2f& scale, const sf::Color& colour)
+{
+	const std::size_t nbSommets{ vertexCount(tileRect, subTexture, scale) };
+	if (!subTexture || tileRect.getSize() == sf::Vector2f())
 	{
-		m_scale.x = m_tileRect.width / textureSize.x;
-		m_scale.y = m_tileRect.height / textureSize.y;
+		const sf::Vector2f& position{ tileRect.getPosition() };
+		vertexes[0].position = position;
+		vertexes[1].position = position + sf::Vector2f(0.f, tileRect.height);
+		vertexes[2].position = position + sf::Vector2f(tileRect.width, 0.f);
+		vertexes[3].position = vertexes[1].position;
+		vertexes[4].position = vertexes[2].position;
+		vertexes[5].position = position + tileRect.getSize();
+		for (std::size_t i{ 0 }; i < nbSommets; ++i)
+			vertexes[i].color = colour;
+		return;
 	}
 
-	int nbVertexes{ static_cast<int>(std::ceil(m_tileRect.width / (m_subTextures->at(m_subTextureIndex).width * m_scale.x))
-		* std::ceil(m_tileRect.height / (m_subTextures->at(m_subTextureIndex).height * m_scale.y))
-		* 6) }; // Pourquoi on multiplie par 6? Car il faut 6 sommets pour faire un carr de tuile
-	moveVertexes(nbVertexes);
+	sf::Vector2f coinGaucheSommet;
+	std::size_t indexSommet{ 0 };
+	sf::Vector2f textureSize{ subTexture->width, subTexture->height };
+	sf::Vector2f texturePosition{ subTexture->left, subTexture->top };
 
 	// En thorie, l'index devrait concider avec la taille
-	while (coinGaucheSommet.y < m_tileRect.height)
+	while (coinGaucheSommet.y < tileRect.height)
 	{
 		coinGaucheSommet.x = 0.f;
-		for (; coinGaucheSommet.x < m_tileRect.width; coinGaucheSommet.x += textureSize.x * m_scale.x, indexSommet += 6)
+		for (; coinGaucheSommet.x < tileRect.width; coinGaucheSommet.x += textureSize.x * scale.x, indexSommet += 6)
 		{
-			(*m_vertexes)[indexSommet].position = coinGaucheSommet;
-			(*m_vertexes)[indexSommet].texCoords = sf::Vector2f(texturePosition.x, 0.f);
+			vertexes[indexSommet].position = coinGaucheSommet;
+			vertexes[indexSommet].texCoords = sf::Vector2f(texturePosition.x, 0.f);
 
-			if (coinGaucheSommet.y + textureSize.y * m_scale.y > m_tileRect.height)
+			if (coinGaucheSommet.y + textureSize.y * scale.y > tileRect.height)
 			{
-				(*m_vertexes)[indexSommet + 1].position = coinGaucheSommet + sf::Vector2f(0.f, m_tileRect.height - coinGaucheSommet.y);
-				(*m_vertexes)[indexSommet + 1].texCoords = sf::Vector2f(texturePosition.x, m_tileRect.height - coinGaucheSommet.y);
+				vertexes[indexSommet + 1].position = coinGaucheSommet + sf::Vector2f(0.f, tileRect.height - coinGaucheSommet.y);
+				vertexes[indexSommet + 1].texCoords = sf::Vector2f(texturePosition.x, tileRect.height - coinGaucheSommet.y);
 			}
 			else
 			{
-				(*m_vertexes)[indexSommet + 1].position = coinGaucheSommet + sf::Vector2f(0.f, textureSize.y * m_scale.y);
-				(*m_vertexes)[indexSommet + 1].texCoords = sf::Vector2f(texturePosition.x, textureSize.y);
+				vertexes[indexSommet + 1].position = coinGaucheSommet + sf::Vector2f(0.f, textureSize.y * scale.y);
+				vertexes[indexSommet + 1].texCoords = sf::Vector2f(texturePosition.x, textureSize.y);
 			}
 
-			if (coinGaucheSommet.x + textureSize.x * m_scale.x > m_tileRect.width)
+			if (coinGaucheSommet.x + textureSize.x * scale.x > tileRect.width)
 			{
-				(*m_vertexes)[indexSommet + 2].position = coinGaucheSommet + sf::Vector2f(m_tileRect.width - coinGaucheSommet.x, 0.f);
-				(*m_vertexes)[indexSommet + 2].texCoords = sf::Vector2f(texturePosition.x + (m_tileRect.width - coinGaucheSommet.x), 0.f);
+				vertexes[indexSommet + 2].position = coinGaucheSommet + sf::Vector2f(tileRect.width - coinGaucheSommet.x, 0.f);
+				vertexes[indexSommet + 2].texCoords = sf::Vector2f(texturePosition.x + (tileRect.width - coinGaucheSommet.x), 0.f);
 			}
 			else
 			{
-				(*m_vertexes)[indexSommet + 2].position = coinGaucheSommet + sf::Vector2f(textureSize.x * m_scale.x, 0.f);
-				(*m_vertexes)[indexSommet + 2].texCoords = sf::Vector2f(texturePosition.x + textureSize.x - 1.f, 0.f);
+				vertexes[indexSommet + 2].position = coinGaucheSommet + sf::Vector2f(textureSize.x * scale.x, 0.f);
+				vertexes[indexSommet + 2].texCoords = sf::Vector2f(texturePosition.x + textureSize.x - 1.f, 0.f);
 			}
 
-			(*m_vertexes)[indexSommet + 3] = (*m_vertexes)[indexSommet + 1];
-			(*m_vertexes)[indexSommet + 4] = (*m_vertexes)[indexSommet + 2];
+			vertexes[indexSommet + 3] = vertexes[indexSommet + 1];
+			vertexes[indexSommet + 4] = vertexes[indexSommet + 2];
 
-			(*m_vertexes)[indexSommet + 5].position = sf::Vector2f((*m_vertexes)[indexSommet + 4].position.x, (*m_vertexes)[indexSommet + 3].position.y);
-			(*m_vertexes)[indexSommet + 5].texCoords = sf::Vector2f((*m_vertexes)[indexSommet + 4].texCoords.x, (*m_vertexes)[indexSommet + 3].texCoords.y);
+			vertexes[indexSommet + 5].position = sf::Vector2f(vertexes[indexSommet + 4].position.x, vertexes[indexSommet + 3].position.y);
+			vertexes[indexSommet + 5].texCoords = sf::Vector2f(vertexes[indexSommet + 4].texCoords.x, vertexes[indexSommet + 3].texCoords.y);
 
 		}
-		coinGaucheSommet.y += textureSize.y * m_scale.y;
+		coinGaucheSommet.y += textureSize.y * scale.y;
 	}
 
-	for (int i{ 0 }; i < m_tileVertexesCount; ++i)
+	for (std::size_t i{ 0 }; i < nbSommets; ++i)
 	{
-		m_vertexes->at(m_beginTiles->at(m_tileIndex) + i).position += m_tileRect.getPosition();
-		m_vertexes->at(m_beginTiles->at(m_tileIndex) + i).color = m_colour;
+		vertexes[i].position += tileRect.getPosition();
+		vertexes[i].color = colour;
+	}
+}
+
+void opt::Tile::intializeVertexes()
+{
+	OPTTILE_STAT(if (m_stats) ++m_stats->initializeVertexesCalls[static_cast<std::size_t>(m_textureRule)]);
+	const sf::FloatRect* sousTexture{ nullptr };
+	if (!m_subTextures || m_tileRect.getSize() == sf::Vector2f())
+		m_textureRule = TextureRule::fill_space;
+	else
+	{
+		sousTexture = &m_subTextures->at(m_subTextureIndex);
+		m_scale = resolvedScale(m_tileRect, sousTexture, m_textureRule, m_scale);
 	}
+
+	moveVertexes(static_cast<int>(vertexCount(m_tileRect, sousTexture, m_scale)));
+	writeVertexes(m_vertexes->data() + m_beginTiles->at(m_tileIndex), m_tileRect, sousTexture, m_scale, m_colour);
 }
 
 opt::Tile::Tile() : m_subTextureIndex{ -1 }, m_textureRule{ TextureRule::repeat_texture },
-m_subTextures{ nullptr }, m_beginTiles{ nullptr }, m_tileIndex{ 0ull }, m_vertexes{ nullptr }, m_tileVertexesCount{ 0ull }
+m_subTextures{ nullptr }, m_beginTiles{ nullptr }, m_tileIndex{ 0ull }, m_vertexes{ nullptr }, m_tileVertexesCount{ 0ull }, m_stats{ nullptr }, m_indexOrder{ nullptr }
 {}
 
+// Les vecteurs appartiennent au niveau : les pointeurs partags n'en sont pas propritaires et la tuile peut tre dtruite ///
+// Vectors belong to the level: shared pointers do not own them and the tile can be destroyed
 opt::Tile::Tile(std::vector<std::size_t>& beginTiles, std::vector<sf::Vertex>& vertices) :
-	m_beginTiles{ &beginTiles }, m_vertexes{ &vertices }, m_tileVertexesCount{ 0ull }, m_tileIndex{ m_beginTiles->size() },
-	m_textureRule{ TextureRule::repeat_texture }, m_subTextureIndex{ -1 }, m_colour{ sf::Color(0xFFFFFFFF) }
+	m_beginTiles{ std::shared_ptr<void>(), &beginTiles }, m_vertexes{ std::shared_ptr<void>(), &vertices }, m_tileVertexesCount{ 0ull }, m_tileIndex{ m_beginTiles->size() },
+	m_textureRule{ TextureRule::repeat_texture }, m_subTextureIndex{ -1 }, m_colour{ sf::Color(0xFFFFFFFF) }, m_stats{ nullptr }, m_indexOrder{ nullptr }
 {
 	m_beginTiles->push_back(m_vertexes->size());
 }
@@ -123,9 +163,9 @@ opt::Tile::Tile(int noTuileDebutTexture, const sf::FloatRect& tileRect, TextureR
 	const std::vector<sf::FloatRect>& subTextures, std::vector<std::size_t>& beginTiles,
 	std::vector<sf::Vertex>& vertices, sf::Vector2f scale) :
 	m_subTextureIndex{ noTuileDebutTexture }, m_textureRule{ textureRule }, m_scale{ scale },
-	m_tileRect{ tileRect }, m_subTextures{ &subTextures }, m_tileVertexesCount{ 0ull },
-	m_beginTiles{ &beginTiles }, m_vertexes{ &vertices },
-	m_tileIndex{ m_beginTiles->size() }, m_colour{ sf::Color(0xFFFFFFFF) }
+	m_tileRect{ tileRect }, m_subTextures{ std::shared_ptr<void>(), &subTextures }, m_tileVertexesCount{ 0ull },
+	m_beginTiles{ std::shared_ptr<void>(), &beginTiles }, m_vertexes{ std::shared_ptr<void>(), &vertices },
+	m_tileIndex{ m_beginTiles->size() }, m_colour{ sf::Color(0xFFFFFFFF) }, m_stats{ nullptr }, m_indexOrder{ nullptr }
 {
 	m_beginTiles->push_back(m_vertexes->size());
 	intializeVertexes();
@@ -176,6 +216,11 @@ sf::Vector2f opt::Tile::getPosition() const
 	return topLeftCorner();
 }
 
+sf::FloatRect opt::Tile::getGlobalBounds() const
+{
+	return m_tileRect;
+}
+
 void opt::Tile::setScale(const sf::Vector2f& scale)
 {
 	switch (m_textureRule)
@@ -366,12 +411,15 @@ void opt::Tile::changeTextureRect(int numberSubTexture)
 			sf::Vector2f deplacement{ m_subTextures->at(numberSubTexture).getPosition() - m_subTextures->at(m_subTextureIndex).getPosition()};
 			for (int i{ 0 }; i < m_tileVertexesCount; ++i)
 				(*m_vertexes)[i + m_beginTiles->at(m_tileIndex)].texCoords += deplacement;
+			m_subTextureIndex = numberSubTexture;
 		}
 		else
 		{
+			// La nouvelle sous-texture doit tre connue avant de reconstruire les sommets ///
+			// The new subtexture has to be known before rebuilding the vertexes
+			m_subTextureIndex = numberSubTexture;
 			intializeVertexes();
 		}
-		m_subTextureIndex = numberSubTexture;
 		//m_texturePosition = sf::Vector2f(m_textureSize.x / *m_textureCount * m_subTextureIndex, 0.f);
 	}
 }
@@ -388,6 +436,8 @@ opt::TextureRule opt::Tile::getTextureRule()
 
 void opt::Tile::move(const sf::Vector2f& offset)
 {
+	m_tileRect.left += offset.x;
+	m_tileRect.top += offset.y;
 	for (std::size_t i {0}; i < m_tileVertexesCount; ++i)
 		m_vertexes->at(m_beginTiles->at(m_tileIndex) + i).position += offset;
 }
@@ -395,6 +445,8 @@ void opt::Tile::move(const sf::Vector2f& offset)
 void opt::Tile::move(float offsetX, float offsetY)
 {
 	sf::Vector2f offset{ offsetX, offsetY };
+	m_tileRect.left += offsetX;
+	m_tileRect.top += offsetY;
 	for (std::size_t i {0}; i < m_tileVertexesCount; ++i)
 		m_vertexes->at(m_beginTiles->at(m_tileIndex) + i).position += offset;
 }
@@ -26,6 +26,8 @@
 namespace opt
 {
 	//class OPTTILE_API Level;
+	class Level;
+	struct LevelStats;
 
 	enum class OPTTILE_API TextureRule {
 		// La texture sera répétée dans la tuile. Augmenter l'échelle augmentera simplement la taille de la tuile, sans augmenter la taille des textures
@@ -53,6 +55,7 @@ namespace opt
 	/// Object allowing to wrap a few SFML-linked inside this class. Needs however another object to be drawn, such as opt::Level
 	/// </summary>
 	class OPTTILE_API Tile {
+		friend class Level;
 	private:
 		/// <summary>
 		/// Regarde le nouveau nombre de sommets pour la tuile et bouge dans le vector les sommets au besoin ///
@@ -91,6 +94,12 @@ namespace opt
 		// Indique la couleur appliquée aux sommets ///
 		// Indicates the vertexes colour
 		sf::Color m_colour;													
+		// Compteurs de performance du niveau propriétaire. Nul si la tuile n'appartient à aucun niveau ///
+		// Performance counters of the owning level. Null if the tile belongs to no level
+		LevelStats* m_stats;
+		// Indique si le niveau propriétaire range les tuiles dans l'ordre de leur index. Nul si la tuile n'appartient à aucun niveau ///
+		// Indicates if the owning level stores the tiles in the order of their index. Null if the tile belongs to no level
+		const bool* m_indexOrder;
 
 		void intializeVertexes();
 	public:
@@ -176,6 +185,12 @@ namespace opt
 		/// </summary>
 		sf::Vector2f getPosition() const;
 
+		/// <summary>
+		/// Retourne le rectangle occupé par la tuile dans le monde ///
+		/// Returns the rectangle covered by the tile in the world
+		/// </summary>
+		sf::FloatRect getGlobalBounds() const;
+
 		/// <summary>
 		/// Met la tuile au zoom spécifié selon la règle de texture (consulter la documentation pour plus de détails) ///
 		/// Puts the tile at the specified zoom according to the texture rule (consult documentation for more details)
@@ -378,6 +393,37 @@ namespace opt
 		/// </summary>
 		std::size_t vertexCount() const;
 
+		/// <summary>
+		/// Retourne l'échelle réellement appliquée à la sous-texture selon la règle de texture ///
+		/// Returns the scale actually applied to the subtexture according to the texture rule
+		/// </summary>
+		/// <param name="tileRect">Position et taille de la tuile /// Tile position and size</param>
+		/// <param name="subTexture">Sous-texture utilisée, nulle pour un quad sans texture /// Used subtexture, null for an untextured quad</param>
+		/// <param name="textureRule">Règle appliquée à la sous-texture /// Rule applied to the subtexture</param>
+		/// <param name="scale">Échelle demandée /// Requested scale</param>
+		static sf::Vector2f resolvedScale(const sf::FloatRect& tileRect, const sf::FloatRect* subTexture, TextureRule textureRule, const sf::Vector2f& scale);
+
+		/// <summary>
+		/// Retourne le nombre de sommets qu'aurait une tuile, sans en construire une ///
+		/// Returns the number of vertexes a tile would have, without building one
+		/// </summary>
+		/// <param name="tileRect">Position et taille de la tuile /// Tile position and size</param>
+		/// <param name="subTexture">Sous-texture utilisée, nulle pour un quad sans texture /// Used subtexture, null for an untextured quad</param>
+		/// <param name="scale">Échelle déjà résolue (voir resolvedScale) /// Scale already resolved (see resolvedScale)</param>
+		static std::size_t vertexCount(const sf::FloatRect& tileRect, const sf::FloatRect* subTexture, const sf::Vector2f& scale);
+
+		/// <summary>
+		/// Écrit les sommets d'une tuile dans un tableau d'au moins vertexCount(...) éléments. Ne touche à aucun niveau, utilisable hors du fil de rendu ///
+		/// Writes a tile's vertexes into an array of at least vertexCount(...) elements. Touches no level, usable off the render thread
+		/// </summary>
+		/// <param name="vertexes">Destination des sommets /// Vertexes destination</param>
+		/// <param name="tileRect">Position et taille de la tuile /// Tile position and size</param>
+		/// <param name="subTexture">Sous-texture utilisée, nulle pour un quad sans texture /// Used subtexture, null for an untextured quad</param>
+		/// <param name="scale">Échelle déjà résolue (voir resolvedScale) /// Scale already resolved (see resolvedScale)</param>
+		/// <param name="colour">Couleur des sommets /// Vertexes colour</param>
+		static void writeVertexes(sf::Vertex* vertexes, const sf::FloatRect& tileRect, const sf::FloatRect* subTexture,
+			const sf::Vector2f& scale, const sf::Color& colour);
+
 	};
 }
 #endif 
@@ -0,0 +1,477 @@
+///
+/// Banc d'essai de la bibliothèque OptTile - Benchmark of the OptTile library
+///
+/// Mesure le coût des opérations de Level et Tile puis écrit les résultats en JSON pour que l'intégration continue puisse les comparer ///
+/// Measures the cost of the Level and Tile operations, then writes the results as JSON so CI can compare them
+///
+/// Utilisation /// Usage :
+///		opttile_bench [--sizes 1000,100000,1000000] [--min-time 0.25] [--max-iterations 100000] [--work-dir .] [--output results.json]
+///
+
+#include "Exceptions.h"
+#include "Level.h"
+#include <SFML/OpenGL.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// Taille d'une sous-texture de l'atlas généré /// Size of a subtexture of the generated atlas
+	constexpr unsigned benchCellSize{ 32u };
+	// Nombre de sous-textures dans l'atlas généré /// Number of subtextures inside the generated atlas
+	constexpr unsigned benchCellCount{ 4u };
+
+	struct Options {
+		std::vector<std::size_t> sizes{ 1000, 100000, 1000000 };
+		double minSeconds{ 0.25 };
+		std::size_t maxIterations{ 100000 };
+		std::string workDir{ "." };
+		std::string output;
+	};
+
+	struct Result {
+		std::string name;
+		std::string variant;
+		std::size_t tiles;
+		std::size_t iterations;
+		double totalNs;
+	};
+
+	using Clock = std::chrono::steady_clock;
+
+	double elapsedNs(Clock::time_point begin)
+	{
+		return std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+	}
+
+	/// <summary>
+	/// Répète une opération jusqu'à ce que le temps minimal ou le nombre maximal d'itérations soit atteint ///
+	/// Repeats an operation until the minimal time or the maximal number of iterations is reached
+	/// </summary>
+	template <typename Operation>
+	Result measure(const Options& options, const std::string& name, const std::string& variant, std::size_t tiles, Operation&& operation)
+	{
+		Result result{ name, variant, tiles, 0, 0.0 };
+		const double budget{ options.minSeconds * 1e9 };
+		const Clock::time_point begin{ Clock::now() };
+		while (result.iterations < options.maxIterations)
+		{
+			operation(result.iterations);
+			++result.iterations;
+			if (elapsedNs(begin) >= budget)
+				break;
+		}
+		result.totalNs = elapsedNs(begin);
+		std::cerr << name << " [" << variant << "] tiles=" << tiles << " : "
+			<< result.totalNs / result.iterations << " ns/op (" << result.iterations << " iterations)\n";
+		return result;
+	}
+
+	/// <summary>
+	/// Mesure une seule exécution d'une opération trop coûteuse pour être répétée ///
+	/// Measures a single run of an operation too expensive to be repeated
+	/// </summary>
+	template <typename Operation>
+	Result measureOnce(const std::string& name, const std::string& variant, std::size_t tiles, std::size_t operations, Operation&& operation)
+	{
+		const Clock::time_point begin{ Clock::now() };
+		operation();
+		Result result{ name, variant, tiles, operations, elapsedNs(begin) };
+		std::cerr << name << " [" << variant << "] tiles=" << tiles << " : "
+			<< result.totalNs / operations << " ns/op (" << operations << " operations)\n";
+		return result;
+	}
+
+	std::vector<sf::FloatRect> benchSubTextures()
+	{
+		std::vector<sf::FloatRect> subTextures;
+		for (unsigned i{ 0 }; i < benchCellCount; ++i)
+			subTextures.emplace_back(static_cast<float>(i * benchCellSize), 0.f, static_cast<float>(benchCellSize), static_cast<float>(benchCellSize));
+		return subTextures;
+	}
+
+	/// <summary>
+	/// Génère l'atlas du banc d'essai et l'écrit sur le disque avec son fichier de sous-textures ///
+	/// Generates the benchmark atlas and writes it on disk with its subtexture file
+	/// </summary>
+	sf::Image makeAtlas(const std::string& imagePath, const std::string& subTexturePath)
+	{
+		const sf::Color couleurs[benchCellCount]{ sf::Color(200, 60, 60), sf::Color(60, 200, 60), sf::Color(60, 60, 200), sf::Color(200, 200, 60) };
+		sf::Image atlas;
+		atlas.create(benchCellSize * benchCellCount, benchCellSize);
+		for (unsigned x{ 0 }; x < atlas.getSize().x; ++x)
+			for (unsigned y{ 0 }; y < atlas.getSize().y; ++y)
+				atlas.setPixel(x, y, ((x / 4 + y / 4) % 2) ? couleurs[x / benchCellSize] : sf::Color::White);
+		if (!atlas.saveToFile(imagePath))
+			throw opt::LoadException(imagePath);
+
+		std::ofstream fichier{ subTexturePath };
+		for (const sf::FloatRect& rect : benchSubTextures())
+			fichier << rect.left << ',' << rect.top << ',' << rect.width << ',' << rect.height << '\n';
+		if (!fichier)
+			throw opt::LoadException(subTexturePath);
+		return atlas;
+	}
+
+	sf::Vector2f gridPosition(std::size_t index, std::size_t columns)
+	{
+		return sf::Vector2f(static_cast<float>(index % columns * benchCellSize), static_cast<float>(index / columns * benchCellSize));
+	}
+
+	std::size_t gridColumns(std::size_t tiles)
+	{
+		return static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(tiles))));
+	}
+
+	/// <summary>
+	/// Remplit un niveau d'une grille de tuiles sans téléverser à chaque ajout ///
+	/// Fills a level with a grid of tiles without uploading at each addition
+	/// </summary>
+	void fillLevel(opt::Level& level, std::size_t tiles)
+	{
+		const std::size_t columns{ gridColumns(tiles) };
+		const sf::Vector2f size{ static_cast<float>(benchCellSize), static_cast<float>(benchCellSize) };
+		level.bufferAutoUpdate(false);
+		for (std::size_t i{ 0 }; i < tiles; ++i)
+			level.add(size, gridPosition(i, columns), static_cast<int>(i % benchCellCount), opt::TextureRule::repeat_texture);
+		level.reloadBuffer();
+		level.bufferAutoUpdate(true);
+	}
+
+	// Parcourt les tuiles dans un ordre dispersé pour ne pas toujours toucher la même ligne de cache ///
+	// Walks the tiles in a scattered order so the same cache line is not always hit
+	std::size_t scatteredIndex(std::size_t iteration, std::size_t tiles)
+	{
+		return (iteration * 7919u) % tiles;
+	}
+
+	void benchMutators(const Options& options, opt::Level& level, std::size_t tiles, std::vector<Result>& results)
+	{
+		const std::size_t columns{ gridColumns(tiles) };
+		const sf::Vector2f normalSize{ static_cast<float>(benchCellSize), static_cast<float>(benchCellSize) };
+		const sf::Vector2f bigSize{ normalSize * 2.f };
+		const std::size_t middle{ tiles / 2 };
+
+		for (bool autoUpdate : { true, false })
+		{
+			const std::string variant{ autoUpdate ? "auto_update" : "deferred" };
+			level.bufferAutoUpdate(autoUpdate);
+
+			results.push_back(measure(options, "move", variant, tiles, [&](std::size_t i) {
+				level.move((i % 2) ? -1.f : 1.f, 0.f, scatteredIndex(i / 2, tiles));
+			}));
+			results.push_back(measure(options, "setPosition", variant, tiles, [&](std::size_t i) {
+				const std::size_t index{ scatteredIndex(i, tiles) };
+				level.setPosition(gridPosition(index, columns) + sf::Vector2f(static_cast<float>(i % 2), 0.f), index);
+			}));
+			// Le redimensionnement change le nombre de sommets de la tuile (6 <-> 24), ce qui déplace le reste du vector ///
+			// Resizing changes the vertex count of the tile (6 <-> 24), which shifts the rest of the vector
+			results.push_back(measure(options, "resize", variant, tiles, [&](std::size_t i) {
+				level.resize((i % 2) ? normalSize : bigSize, middle);
+			}));
+			results.push_back(measure(options, "setScale", variant, tiles, [&](std::size_t i) {
+				level.setScale((i % 2) ? 0.5f : 2.f, middle);
+			}));
+			level.resize(normalSize, middle);
+			level.reloadBuffer();
+		}
+		level.bufferAutoUpdate(true);
+	}
+
+	void benchLoadTexture(const Options& options, opt::Level& level, std::size_t tiles, const sf::Texture& texture,
+		const std::string& imagePath, const std::string& subTexturePath, std::vector<Result>& results)
+	{
+		std::vector<sf::FloatRect> subTextures{ benchSubTextures() };
+		const std::string variant{ "auto_update" };
+
+		results.push_back(measure(options, "loadTexture(path,count)", variant, tiles, [&](std::size_t) {
+			level.loadTexture(imagePath, static_cast<int>(benchCellCount));
+		}));
+		results.push_back(measure(options, "loadTexture(path,rects)", variant, tiles, [&](std::size_t) {
+			level.loadTexture(imagePath, subTextures);
+		}));
+		results.push_back(measure(options, "loadTexture(path,subTexturePath)", variant, tiles, [&](std::size_t) {
+			level.loadTexture(imagePath, subTexturePath);
+		}));
+		results.push_back(measure(options, "loadTexture(texture,count)", variant, tiles, [&](std::size_t) {
+			level.loadTexture(texture, static_cast<int>(benchCellCount));
+		}));
+		results.push_back(measure(options, "loadTexture(texture,rects)", variant, tiles, [&](std::size_t) {
+			level.loadTexture(texture, subTextures);
+		}));
+		results.push_back(measure(options, "loadTexture(texture,subTexturePath)", variant, tiles, [&](std::size_t) {
+			level.loadTexture(texture, subTexturePath);
+		}));
+	}
+
+	/// <summary>
+	/// Mesure la génération des sommets d'une tuile de 8x8 répétitions pour chaque règle de texture ///
+	/// Measures the vertex generation of a tile of 8x8 repetitions for each texture rule
+	/// </summary>
+	void benchInitializeVertexes(const Options& options, const sf::Texture& texture, std::vector<Result>& results)
+	{
+		const std::pair<opt::TextureRule, const char*> regles[]{
+			{ opt::TextureRule::repeat_texture, "repeat_texture" },
+			{ opt::TextureRule::keep_height, "keep_height" },
+			{ opt::TextureRule::keep_width, "keep_width" },
+			{ opt::TextureRule::keep_size, "keep_size" },
+			{ opt::TextureRule::adjustable_size, "adjustable_size" },
+			{ opt::TextureRule::fill_space, "fill_space" }
+		};
+		const sf::Vector2f size{ static_cast<float>(benchCellSize * 8), static_cast<float>(benchCellSize * 8) };
+		std::vector<sf::FloatRect> subTextures{ benchSubTextures() };
+
+		for (const auto& [regle, nom] : regles)
+		{
+			opt::Level level;
+			level.loadTexture(texture, subTextures);
+			level.add(size, sf::Vector2f(), 0, regle);
+			level.bufferAutoUpdate(false);
+			// resize() passe toujours par intializeVertexes(); la tuile est seule, donc aucun sommet n'est déplacé ///
+			// resize() always goes through intializeVertexes(); the tile is alone, so no vertex is shifted
+			results.push_back(measure(options, "intializeVertexes", nom, level[0].vertexCount() / 6, [&](std::size_t) {
+				level.resize(size, regle, 0);
+			}));
+		}
+	}
+
+	void benchDraw(const Options& options, opt::Level& level, std::size_t tiles, sf::RenderTexture& cible, std::vector<Result>& results)
+	{
+		const std::size_t columns{ gridColumns(tiles) };
+		const float monde{ static_cast<float>(columns * benchCellSize) };
+		cible.setView(sf::View(sf::FloatRect(0.f, 0.f, monde, monde)));
+		results.push_back(measure(options, "draw", "render_texture", tiles, [&](std::size_t) {
+			cible.clear();
+			cible.draw(level);
+			cible.display();
+			glFinish();
+		}));
+		if (level.packedVertexes(true))
+		{
+			results.push_back(measure(options, "draw", "packed", tiles, [&](std::size_t) {
+				cible.clear();
+				cible.draw(level);
+				cible.display();
+				glFinish();
+			}));
+			level.packedVertexes(false);
+		}
+
+		// Plages de sommets d'un quart de la vue, dans l'ordre d'ajout puis dans l'ordre de Morton ///
+		// Vertex ranges of a quarter of the view, in insertion order then in Morton order
+		const sf::FloatRect quart{ monde / 4.f, monde / 4.f, monde / 2.f, monde / 2.f };
+		results.push_back(measure(options, "vertexRanges", "insertion", tiles, [&](std::size_t) {
+			level.vertexRanges(quart);
+		}));
+		level.optimizeLayout();
+		results.push_back(measure(options, "vertexRanges", "morton", tiles, [&](std::size_t) {
+			level.vertexRanges(quart);
+		}));
+		std::cerr << "vertexRanges [morton] : " << level.vertexRanges(quart).size() << " ranges\n";
+		level.culling(true);
+		results.push_back(measure(options, "draw", "culled_morton", tiles, [&](std::size_t) {
+			cible.clear();
+			cible.draw(level);
+			cible.display();
+			glFinish();
+		}));
+		level.culling(false);
+
+		// Rafale de modifications (1 % des tuiles) suivie d'un dessin, avec et sans budget de téléversement ///
+		// Burst of changes (1% of the tiles) followed by a draw, with and without an upload budget
+		const std::size_t rafale{ std::max<std::size_t>(1, tiles / 100) };
+		for (const std::size_t budget : { std::size_t{ 0 }, std::size_t{ 64 * 1024 } })
+		{
+			level.uploadBudget(budget);
+			results.push_back(measure(options, "burst_draw", budget ? "budget_64k" : "immediate", tiles, [&](std::size_t i) {
+				for (std::size_t j{ 0 }; j < rafale; ++j)
+					level.changeColour(sf::Color(static_cast<sf::Uint8>(i), 255, 255), static_cast<int>((i * rafale + j) % tiles));
+				cible.clear();
+				cible.draw(level);
+				cible.display();
+				glFinish();
+			}));
+		}
+		level.uploadBudget(0);
+	}
+
+	void benchSize(const Options& options, std::size_t tiles, const sf::Texture& texture, const std::string& imagePath,
+		const std::string& subTexturePath, sf::RenderTexture& cible, std::vector<Result>& results)
+	{
+		std::vector<sf::FloatRect> subTextures{ benchSubTextures() };
+
+		{
+			opt::Level level;
+			level.loadTexture(texture, subTextures);
+			results.push_back(measureOnce("add", "deferred", tiles, tiles, [&]() {
+				fillLevel(level, tiles);
+			}));
+		}
+
+		opt::Level level;
+		level.loadTexture(texture, subTextures);
+		fillLevel(level, tiles);
+
+		{
+			// Le niveau rempli sert de gabarit, estampillé plusieurs fois dans un monde ///
+			// The filled level is used as a template, stamped several times inside a world
+			constexpr std::size_t estampes{ 8 };
+			opt::Level monde;
+			monde.loadTexture(texture, subTextures);
+			results.push_back(measureOnce("append", "auto_update", tiles, estampes, [&]() {
+				for (std::size_t i{ 0 }; i < estampes; ++i)
+					monde.append(level, sf::Vector2f(0.f, static_cast<float>(i * gridColumns(tiles) * benchCellSize)));
+			}));
+		}
+
+		{
+			// Lecture d'un niveau enregistré dans chaque encodage, sans construire de sommets ///
+			// Reading a level saved in each encoding, without building vertexes
+			const std::vector<opt::TileRecord> tuiles{ level.records() };
+			const std::pair<opt::LevelFile::Encoding, const char*> encodages[]{
+				{ opt::LevelFile::Encoding::raw, "raw" }, { opt::LevelFile::Encoding::compact, "compact" } };
+			for (const auto& [encodage, nom] : encodages)
+			{
+				std::ostringstream sortie;
+				opt::LevelFile::write(sortie, tuiles, encodage);
+				const std::string octets{ sortie.str() };
+				std::cerr << "save [" << nom << "] tiles=" << tiles << " : " << octets.size() << " bytes\n";
+				results.push_back(measure(options, "read", nom, tiles, [&](std::size_t) {
+					std::istringstream entree{ octets };
+					opt::LevelFile::read(entree);
+				}));
+			}
+		}
+
+		{
+			// Sprites triés selon leur bord bas, déplacés de quelques pixels à chaque itération ///
+			// Sprites sorted by their bottom edge, moved by a few pixels at each iteration
+			opt::Level sprites;
+			sprites.loadTexture(texture, subTextures);
+			fillLevel(sprites, tiles);
+			sprites.addLayer("sprites");
+			for (std::size_t i{ 0 }; i < tiles; ++i)
+				sprites.setLayer("sprites", i);
+			sprites.layerYSorted("sprites", true);
+			results.push_back(measure(options, "move", "y_sorted", tiles, [&](std::size_t i) {
+				sprites.move(0.f, (i % 2) ? -3.f : 3.f, scatteredIndex(i / 2, tiles));
+			}));
+		}
+
+		benchMutators(options, level, tiles, results);
+		benchDraw(options, level, tiles, cible, results);
+		benchLoadTexture(options, level, tiles, texture, imagePath, subTexturePath, results);
+
+		// Chaque ajout agrandit le niveau; on limite donc le nombre d'itérations ///
+		// Each addition grows the level, so the number of iterations is bounded
+		Options ajoutOptions{ options };
+		ajoutOptions.maxIterations = std::min<std::size_t>(options.maxIterations, 1000);
+		const std::size_t columns{ gridColumns(tiles) };
+		results.push_back(measure(ajoutOptions, "add", "auto_update", tiles, [&](std::size_t i) {
+			level.add(sf::Vector2f(static_cast<float>(benchCellSize), static_cast<float>(benchCellSize)),
+				gridPosition(tiles + i, columns), static_cast<int>(i % benchCellCount), opt::TextureRule::repeat_texture);
+		}));
+	}
+
+	std::string escapeJson(const std::string& texte)
+	{
+		std::string echappe;
+		for (char c : texte)
+		{
+			if (c == '"' || c == '\\')
+				echappe += '\\';
+			echappe += c;
+		}
+		return echappe;
+	}
+
+	void writeJson(std::ostream& sortie, const std::vector<Result>& results)
+	{
+		sortie << "{\n  \"benchmark\": \"opttile_bench\",\n  \"version\": 1,\n  \"results\": [\n";
+		for (std::size_t i{ 0 }; i < results.size(); ++i)
+		{
+			const Result& result{ results[i] };
+			char nombres[160];
+			std::snprintf(nombres, sizeof(nombres), "\"iterations\": %zu, \"total_ns\": %.1f, \"ns_per_op\": %.3f",
+				result.iterations, result.totalNs, result.iterations ? result.totalNs / result.iterations : 0.0);
+			sortie << "    {\"name\": \"" << escapeJson(result.name) << "\", \"variant\": \"" << escapeJson(result.variant)
+				<< "\", \"tiles\": " << result.tiles << ", " << nombres << '}' << (i + 1 < results.size() ? ",\n" : "\n");
+		}
+		sortie << "  ]\n}\n";
+	}
+
+	Options parseOptions(int argc, char** argv)
+	{
+		Options options;
+		for (int i{ 1 }; i < argc; ++i)
+		{
+			const std::string argument{ argv[i] };
+			if (i + 1 >= argc)
+				throw opt::ParseException(argument);
+			const std::string valeur{ argv[++i] };
+			if (argument == "--sizes")
+			{
+				options.sizes.clear();
+				for (const std::string& taille : opt::splitString(valeur, ','))
+					options.sizes.push_back(std::stoull(taille));
+			}
+			else if (argument == "--min-time")
+				options.minSeconds = std::stod(valeur);
+			else if (argument == "--max-iterations")
+				options.maxIterations = std::stoull(valeur);
+			else if (argument == "--work-dir")
+				options.workDir = valeur;
+			else if (argument == "--output")
+				options.output = valeur;
+			else
+				throw opt::ParseException(argument);
+		}
+		return options;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		const Options options{ parseOptions(argc, argv) };
+		const std::string imagePath{ options.workDir + "/opttile_bench_atlas.png" };
+		const std::string subTexturePath{ options.workDir + "/opttile_bench_atlas.txt" };
+
+		sf::Texture texture;
+		if (!texture.loadFromImage(makeAtlas(imagePath, subTexturePath)))
+			throw opt::LoadException(imagePath);
+
+		sf::RenderTexture cible;
+		if (!cible.create(1280, 720))
+			throw opt::LoadException("sf::RenderTexture");
+
+		std::vector<Result> results;
+		benchInitializeVertexes(options, texture, results);
+		for (std::size_t tiles : options.sizes)
+			benchSize(options, tiles, texture, imagePath, subTexturePath, cible, results);
+
+		if (options.output.empty())
+			writeJson(std::cout, results);
+		else
+		{
+			std::ofstream sortie{ options.output };
+			writeJson(sortie, results);
+			if (!sortie)
+				throw opt::LoadException(options.output);
+		}
+	}
+	catch (const opt::Exception& exception)
+	{
+		std::cerr << exception.showMessage() << '\n';
+		return 1;
+	}
+	return 0;
+}
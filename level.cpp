@@ -1,7 +1,53 @@
 #include "pch.h"
 #include "Level.h"
 #include "Exceptions.h"
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+
+namespace
+{
+	// tale les 16 bits bas d'une valeur sur les bits pairs, pour entrelacer deux coordonnes (code de Morton) ///
+	// Spreads the 16 low bits of a value over the even bits, to interleave two coordinates (Morton code)
+	std::uint32_t spreadBits(std::uint32_t valeur)
+	{
+		valeur &= 0x0000FFFF;
+		valeur = (valeur | (valeur << 8)) & 0x00FF00FF;
+		valeur = (valeur | (valeur << 4)) & 0x0F0F0F0F;
+		valeur = (valeur | (valeur << 2)) & 0x33333333;
+		valeur = (valeur | (valeur << 1)) & 0x55555555;
+		return valeur;
+	}
+
+	// Lit un fichier de sous-textures "left,top,width,height[,name]", une par ligne. Les lignes blanches sont ignores,
+	// comme le fait opttile_atlasgen, pour que le mme fichier donne les mmes index  l'excution et  la compilation ///
+	// Reads a subtexture file "left,top,width,height[,name]", one per line. Blank lines are skipped,
+	// as opttile_atlasgen does, so the same file gives the same indexes at runtime and at compile time
+	std::vector<sf::FloatRect> readSubTextures(const std::string& path)
+	{
+		std::ifstream fichier{ path };
+		if (!fichier)
+			throw opt::LoadException(path);
+		std::vector<sf::FloatRect> sousTextures;
+		std::string ligne;
+		while (std::getline(fichier, ligne))
+		{
+			if (ligne.find_first_not_of(" \t\r") == std::string::npos)
+				continue;
+			const std::vector<std::string> donnees{ opt::splitString(ligne, ',') };
+			if (donnees.size() < 4)
+				throw opt::ParseException(ligne);
+			sousTextures.emplace_back(opt::parse<float>(donnees[0]), opt::parse<float>(donnees[1]), opt::parse<float>(donnees[2]), opt::parse<float>(donnees[3]));
+		}
+		if (sousTextures.empty())
+			throw opt::LoadException(path);
+		return sousTextures;
+	}
+}
 
 template <typename T>
 T opt::parse(const std::string& line)
@@ -34,16 +80,302 @@ std::vector<std::string> opt::splitString(std::string str, const char separator)
 
 void opt::Level::reloadBuffer()
 {
+	if (m_autoLayout && m_layoutChanges * 8 > m_tiles.size())
+		sortLayout();
+	m_pendingUploads.clear();
+	m_isPending.assign(m_isPending.size(), false);
+	if (m_usePacked)
+	{
+		// Le tlversement est fait au prochain dessin; les octets sont compts  ce moment ///
+		// The upload is done at the next draw; bytes are counted at that moment
+		bool exact;
+		if (m_hiddenCount)
+		{
+			uploadSource(0, m_vertexes.size(), nullptr, 0);
+			exact = m_packed.update(m_visibleVertexes, m_texture);
+		}
+		else
+			exact = m_packed.update(m_vertexes, m_texture);
+		if (exact)
+		{
+			OPTTILE_STAT(m_stats.uploadedVertexes += m_vertexes.size());
+			return;
+		}
+		// Les positions ne tiennent plus sur 16 bits sans perte : retour au sf::VertexBuffer ///
+		// Positions no longer fit on 16 bits without loss: back to the sf::VertexBuffer
+		m_usePacked = false;
+		m_packed.clear();
+		m_staticCache.invalidate();
+	}
 	m_renderVertexes.create(m_vertexes.size());
-	m_renderVertexes.update(m_vertexes.data());
+	m_renderVertexes.update(uploadSource(0, m_vertexes.size(), nullptr, 0));
+	OPTTILE_STAT(++m_stats.bufferCreations);
+	OPTTILE_STAT(m_stats.uploadedVertexes += m_vertexes.size());
+	OPTTILE_STAT(m_stats.uploadedBytes += m_vertexes.size() * sizeof(sf::Vertex));
 }
 
-bool opt::Level::continueUpdate(std::size_t index, std::size_t itterator)
+void opt::Level::refreshTile(std::size_t index)
 {
-	if (index >= m_beginTileIndex.size() - 1)
-		return itterator < m_vertexes.size();
+	m_tilesBySubTexture.update(index, m_tiles[index]->m_subTextureIndex);
+	if (m_useInstanced)
+		m_instanced.set(index, instanceOf(*m_tiles[index]));
+	if (m_useStaticCache)
+		m_staticCache.invalidate(m_tiles[index]->getGlobalBounds());
+	if (m_useOcclusion)
+		m_occlusion.update(index, m_tiles[index]->getGlobalBounds(), isOpaque(index));
+	if (usesCullingGrid())
+		m_cullingGrid.update(index, m_tiles[index]->getGlobalBounds());
+	if (m_layers.active())
+		m_layers.update(index, uploadSource(m_beginTileIndex[index], tileEnd(index), &index, 1), m_tiles[index]->vertexCount(), m_tiles[index]->bottomLeftCorner().y);
+}
+
+void opt::Level::adoptBuffer(sf::VertexBuffer& buffer)
+{
+	m_renderVertexes.swap(buffer);
+	m_pendingUploads.clear();
+	m_isPending.assign(m_isPending.size(), false);
+	OPTTILE_STAT(++m_stats.bufferCreations);
+}
+
+void opt::Level::updateTile(std::size_t index, const sf::FloatRect& previousBounds)
+{
+	markSnapshotTile(index);
+	journalTile(index);
+	m_tilesBySubTexture.update(index, m_tiles[index]->subTextureIndex());
+	if (previousBounds != m_tiles[index]->getGlobalBounds())
+		++m_layoutChanges;
+	if (m_useStaticCache)
+	{
+		m_staticCache.invalidate(previousBounds);
+		m_staticCache.invalidate(m_tiles[index]->getGlobalBounds());
+	}
+	if (m_useInstanced)
+		m_instanced.set(index, instanceOf(*m_tiles[index]));
+	if (m_useOcclusion)
+		m_occlusion.update(index, m_tiles[index]->getGlobalBounds(), isOpaque(index));
+	if (usesCullingGrid())
+		m_cullingGrid.update(index, m_tiles[index]->getGlobalBounds());
+	if (m_layers.active())
+		m_layers.update(index, uploadSource(m_beginTileIndex[index], tileEnd(index), &index, 1), m_tiles[index]->vertexCount(), m_tiles[index]->bottomLeftCorner().y);
+	// Les plages montres ne bougent que si la tuile a chang de nombre de sommets, donc la taille du tampon ///
+	// Shown ranges only move if the tile changed its vertex count, hence the size of the buffer
+	if (m_vertexes.size() != m_shownVertexCount)
+	{
+		m_shownVertexCount = m_vertexes.size();
+		m_shownRangesDirty = true;
+	}
+	if (m_autoUpdate && usesVertexBuffer())
+	{
+		// Si le nombre de sommets n'a pas chang, les autres tuiles n'ont pas boug dans le tampon ///
+		// If the vertex count did not change, the other tiles did not move inside the buffer
+		if (m_uploadBudget && !m_usePacked && m_renderVertexes.getVertexCount() == m_vertexes.size())
+			queueUpload(index);
+		else
+			reloadBuffer();
+	}
+}
+
+void opt::Level::queueUpload(std::size_t index)
+{
+	if (m_isPending.size() < m_tiles.size())
+		m_isPending.resize(m_tiles.size(), false);
+	if (!m_isPending[index])
+	{
+		m_isPending[index] = true;
+		m_pendingUploads.push_back(index);
+	}
+}
+
+void opt::Level::uploadTiles(std::vector<std::size_t>& indexes) const
+{
+	// Tri par emplacement dans le tampon : les tuiles qui se suivent dans le tampon sont tlverses ensemble ///
+	// Sorted by place inside the buffer: tiles following each other inside the buffer are uploaded together
+	std::sort(indexes.begin(), indexes.end(), [this](std::size_t a, std::size_t b) { return m_beginTileIndex[a] < m_beginTileIndex[b]; });
+	for (std::size_t i{ 0 }; i < indexes.size(); )
+	{
+		const std::size_t premiere{ i };
+		const std::size_t debut{ m_beginTileIndex[indexes[i]] };
+		std::size_t fin{ tileEnd(indexes[i]) };
+		for (++i; i < indexes.size() && m_beginTileIndex[indexes[i]] == fin; ++i)
+			fin = tileEnd(indexes[i]);
+		if (fin > debut)
+			m_renderVertexes.update(uploadSource(debut, fin, indexes.data() + premiere, i - premiere), fin - debut, static_cast<unsigned>(debut));
+		OPTTILE_STAT(m_stats.uploadedVertexes += fin - debut);
+		OPTTILE_STAT(m_stats.uploadedBytes += (fin - debut) * sizeof(sf::Vertex));
+	}
+	for (std::size_t index : indexes)
+	{
+		if (index < m_isPending.size())
+			m_isPending[index] = false;
+		// Le cache a pu tre rendu avec l'ancien contenu du tampon ///
+		// The cache may have been rendered with the previous content of the buffer
+		if (m_useStaticCache)
+			m_staticCache.invalidate(m_tiles[index]->getGlobalBounds());
+	}
+}
+
+void opt::Level::syncTiles(std::vector<std::size_t>& indexes, bool shifted)
+{
+	for (std::size_t index : indexes)
+	{
+		markSnapshotTile(index);
+		journalTile(index);
+	}
+	if (!m_autoUpdate || !usesVertexBuffer())
+		return;
+	if (shifted || m_usePacked)
+		reloadBuffer();
+	else if (m_uploadBudget)
+	{
+		for (std::size_t index : indexes)
+			queueUpload(index);
+	}
 	else
-		return itterator < m_beginTileIndex[index + 1];
+		uploadTiles(indexes);
+}
+
+void opt::Level::flushUploads(const sf::View& view) const
+{
+	struct Priorite {
+		bool horsEcran;
+		float distance;
+		std::size_t index;
+
+		bool operator>(const Priorite& other) const
+		{
+			if (horsEcran != other.horsEcran)
+				return horsEcran;
+			return distance > other.distance;
+		}
+	};
+
+	const sf::Vector2f centre{ view.getCenter() };
+	const sf::FloatRect visible{ centre - view.getSize() / 2.f, view.getSize() };
+	std::vector<Priorite> file;
+	file.reserve(m_pendingUploads.size());
+	for (std::size_t index : m_pendingUploads)
+	{
+		const sf::FloatRect rectangle{ m_tiles[index]->getGlobalBounds() };
+		const sf::Vector2f ecart{ rectangle.left + rectangle.width / 2.f - centre.x, rectangle.top + rectangle.height / 2.f - centre.y };
+		file.push_back({ !visible.intersects(rectangle), ecart.x * ecart.x + ecart.y * ecart.y, index });
+	}
+
+	// Tas minimum : seules les tuiles tlverses sont extraites, les autres ne sont pas tries ///
+	// Min-heap: only the uploaded tiles are extracted, the others are not sorted
+	std::make_heap(file.begin(), file.end(), std::greater<Priorite>());
+	std::vector<std::size_t> choisies;
+	std::size_t octets{ 0 };
+	while (!file.empty())
+	{
+		const std::size_t index{ file.front().index };
+		const std::size_t taille{ m_tiles[index]->vertexCount() * sizeof(sf::Vertex) };
+		// Au moins une tuile par image, mme si elle dpasse le budget  elle seule ///
+		// At least one tile per frame, even if it exceeds the budget by itself
+		if (!choisies.empty() && octets + taille > m_uploadBudget)
+			break;
+		octets += taille;
+		choisies.push_back(index);
+		std::pop_heap(file.begin(), file.end(), std::greater<Priorite>());
+		file.pop_back();
+	}
+
+	m_pendingUploads.clear();
+	for (const Priorite& restante : file)
+		m_pendingUploads.push_back(restante.index);
+	uploadTiles(choisies);
+}
+
+void opt::Level::updateAllTiles()
+{
+	markSnapshotAll();
+	m_journalReset = m_journaling;
+	m_staticCache.invalidate();
+	if (m_useOcclusion)
+		refreshOcclusion();
+	if (m_layers.active())
+	{
+		for (std::size_t i{ 0 }; i < m_tiles.size(); ++i)
+			m_layers.update(i, uploadSource(m_beginTileIndex[i], tileEnd(i), &i, 1), m_tiles[i]->vertexCount(), m_tiles[i]->bottomLeftCorner().y);
+	}
+	if (m_useInstanced)
+	{
+		m_instanced.resize(m_tiles.size());
+		for (std::size_t i{ 0 }; i < m_tiles.size(); ++i)
+			m_instanced.set(i, instanceOf(*m_tiles[i]));
+	}
+	if (m_autoUpdate && usesVertexBuffer()) reloadBuffer();
+}
+
+bool opt::Level::usesVertexBuffer() const
+{
+	// Le cache statique est rendu  partir du tampon de sommets, mme lorsque le rendu instanci est actif ///
+	// The static cache is rendered from the vertex buffer, even when instanced rendering is enabled
+	return (!m_useInstanced && !m_layers.active()) || m_useStaticCache;
+}
+
+bool opt::Level::usesCullingGrid() const
+{
+	// Le cache statique ne rend dans chaque cellule que les tuiles qui la touchent ///
+	// The static cache only renders inside each cell the tiles touching it
+	return m_culling || m_useStaticCache;
+}
+
+void opt::Level::refreshCullingGrid(bool wasUsed)
+{
+	if (!usesCullingGrid())
+		m_cullingGrid.clear();
+	else if (!wasUsed)
+	{
+		for (std::size_t i{ 0 }; i < m_tiles.size(); ++i)
+			m_cullingGrid.update(i, m_tiles[i]->getGlobalBounds());
+	}
+}
+
+opt::TileInstance opt::Level::instanceOf(const Tile& tile) const
+{
+	TileInstance instance{};
+	const sf::FloatRect& rect{ tile.m_tileRect };
+	instance.tileRect[0] = rect.left;
+	instance.tileRect[1] = rect.top;
+	instance.tileRect[2] = rect.width;
+	instance.tileRect[3] = rect.height;
+	// Une tuile cache devient un quadrilatre vide /// A hidden tile becomes an empty quad
+	if (isHidden(tile.m_tileIndex))
+	{
+		instance.tileRect[2] = 0.f;
+		instance.tileRect[3] = 0.f;
+	}
+	instance.flags = static_cast<float>(tile.m_textureRule);
+	// Mme condition que Tile::intializeVertexes pour une tuile sans sous-texture ///
+	// Same condition as Tile::intializeVertexes for a tile without subtexture
+	if (!tile.m_subTextures || rect.getSize() == sf::Vector2f() || tile.m_subTextureIndex < 0
+		|| tile.m_subTextureIndex >= static_cast<int>(tile.m_subTextures->size()))
+		instance.flags += 16.f;
+	else
+	{
+		const sf::FloatRect& sousTexture{ (*tile.m_subTextures)[tile.m_subTextureIndex] };
+		instance.textureRect[0] = sousTexture.left;
+		instance.textureRect[1] = sousTexture.top;
+		instance.textureRect[2] = sousTexture.width;
+		instance.textureRect[3] = sousTexture.height;
+		instance.cellSize[0] = sousTexture.width * tile.m_scale.x;
+		instance.cellSize[1] = sousTexture.height * tile.m_scale.y;
+	}
+	instance.colour[0] = tile.m_colour.r;
+	instance.colour[1] = tile.m_colour.g;
+	instance.colour[2] = tile.m_colour.b;
+	instance.colour[3] = tile.m_colour.a;
+	return instance;
+}
+
+bool opt::Level::continueUpdate(std::size_t index, std::size_t itterator)
+{
+	return itterator < tileEnd(index);
+}
+
+std::size_t opt::Level::tileEnd(std::size_t index) const
+{
+	return m_beginTileIndex[index] + m_tiles[index]->vertexCount();
 }
 
 //int opt::Level::vertexesChanges()
@@ -58,18 +390,16 @@ bool opt::Level::continueUpdate(std::size_t index, std::size_t itterator)
 //	return -1;
 //}
 
-opt::Level::Level() : m_renderVertexes{ sf::Triangles, sf::VertexBuffer::Dynamic }, m_autoUpdate{ true }
+opt::Level::Level() : m_renderVertexes{ sf::Triangles, sf::VertexBuffer::Dynamic }, m_autoUpdate{ true }, m_useStaticCache{ false }, m_useInstanced{ false }, m_usePacked{ false }, m_uploadBudget{ 0 }, m_autoLayout{ false }, m_layoutChanges{ 0 }, m_indexOrder{ true }, m_culling{ false }, m_useOcclusion{ false }, m_hiddenCount{ 0 }, m_shownRangesDirty{ true }, m_shownVertexCount{ 0 }, m_dirtyFromTile{ 0 }, m_dirtyFromVertex{ 0 }, m_trackedVertexCount{ 0 }, m_snapshotTracking{ false }, m_journaling{ false }, m_journalReset{ false }
 {
 
 }
 
 opt::Level::~Level()
 {
-	for (auto& tile : m_tiles)
-		tile.release();
 }
 
-opt::Level::Level(const std::string& pPathTexture, std::size_t pNbTextures) : m_renderVertexes{ sf::Triangles, sf::VertexBuffer::Dynamic }, m_autoUpdate{ true }
+opt::Level::Level(const std::string& pPathTexture, std::size_t pNbTextures) : m_renderVertexes{ sf::Triangles, sf::VertexBuffer::Dynamic }, m_autoUpdate{ true }, m_useStaticCache{ false }, m_useInstanced{ false }, m_usePacked{ false }, m_uploadBudget{ 0 }, m_autoLayout{ false }, m_layoutChanges{ 0 }, m_indexOrder{ true }, m_culling{ false }, m_useOcclusion{ false }, m_hiddenCount{ 0 }, m_shownRangesDirty{ true }, m_shownVertexCount{ 0 }, m_dirtyFromTile{ 0 }, m_dirtyFromVertex{ 0 }, m_trackedVertexCount{ 0 }, m_snapshotTracking{ false }, m_journaling{ false }, m_journalReset{ false }
 {
 	if (!m_texture.loadFromFile(pPathTexture))
 		throw opt::LoadException(pPathTexture);
@@ -103,6 +433,42 @@ opt::Level& opt::Level::operator=(opt::Level&& other) noexcept
 		m_subTextures = other.m_subTextures;
 		m_texture = other.m_texture;
 		m_vertexes = other.m_vertexes;
+		m_tilesBySubTexture.clear();
+		for (std::size_t i{ 0 }; i < m_tiles.size(); ++i)
+		{
+			m_tiles[i]->m_stats = &m_stats;
+			m_tiles[i]->m_indexOrder = &m_indexOrder;
+			m_tilesBySubTexture.update(i, m_tiles[i]->subTextureIndex());
+		}
+		m_useStaticCache = other.m_useStaticCache;
+		m_staticCache.setCellSize(other.m_staticCache.cellSize());
+		m_uploadBudget = other.m_uploadBudget;
+		m_autoLayout = other.m_autoLayout;
+		m_layoutChanges = other.m_layoutChanges;
+		m_indexOrder = other.m_indexOrder;
+		m_culling = other.m_culling;
+		m_cullingGrid.clear();
+		refreshCullingGrid(false);
+		m_columns = std::move(other.m_columns);
+		m_useOcclusion = other.m_useOcclusion;
+		m_forcedOpacity = std::move(other.m_forcedOpacity);
+		m_layers = std::move(other.m_layers);
+		m_hidden = std::move(other.m_hidden);
+		m_hiddenCount = other.m_hiddenCount;
+		m_shownRangesDirty = true;
+		markSnapshotAll();
+		m_journalReset = m_journaling;
+		m_occlusion.clear();
+		if (m_useOcclusion)
+			refreshOcclusion();
+		m_pendingUploads.clear();
+		m_isPending.clear();
+		m_usePacked = other.m_usePacked;
+		if (m_usePacked)
+			reloadBuffer();
+		m_useInstanced = other.m_useInstanced;
+		if (m_useInstanced)
+			updateAllTiles();
 	}
 	return *this;
 }
@@ -113,14 +479,100 @@ void opt::Level::draw(sf::RenderTarget& target, sf::RenderStates states) const
 
 	//states.transform = m_transformations;
 
+	if (!m_pendingUploads.empty())
+		flushUploads(target.getView());
+
+	const sf::Drawable& tampon{ m_usePacked ? static_cast<const sf::Drawable&>(m_packed) : m_renderVertexes };
+
+	if (m_useStaticCache)
+	{
+		// Le tampon compact ne dessine pas de plage : ses cellules sont rendues depuis les sommets du niveau ///
+		// The packed buffer does not draw ranges: its cells are rendered from the level's vertexes
+		std::size_t sommets{ 0 };
+		const std::size_t rendues{ m_staticCache.render(m_usePacked ? nullptr : &m_renderVertexes, m_vertexes, m_texture,
+			[this](const sf::FloatRect& cellule) { return drawnRanges(cellule); }, sommets) };
+		OPTTILE_STAT(m_stats.cacheCellRenders += rendues);
+		const std::size_t appels{ m_staticCache.draw(target, states) };
+		OPTTILE_STAT(m_stats.drawCalls += appels);
+		OPTTILE_STAT(m_stats.submittedVertexes += sommets + appels * 6);
+		return;
+	}
+
+	if (m_useInstanced)
+	{
+		const std::size_t octets{ m_instanced.draw(target, states, m_texture) };
+		OPTTILE_STAT(m_stats.uploadedBytes += octets);
+		OPTTILE_STAT(++m_stats.drawCalls);
+		OPTTILE_STAT(m_stats.submittedVertexes += m_instanced.size() * 6);
+		return;
+	}
+
+	if (m_layers.active())
+	{
+		std::size_t sommets{ 0 };
+		[[maybe_unused]] const std::size_t appels{ m_layers.draw(target, states, sommets) };
+		OPTTILE_STAT(m_stats.uploadedBytes += m_layers.takeUploadedBytes());
+		OPTTILE_STAT(m_stats.drawCalls += appels);
+		OPTTILE_STAT(m_stats.submittedVertexes += sommets);
+		return;
+	}
+
+	if ((m_culling || m_useOcclusion) && !m_usePacked && !m_vertexes.empty())
+	{
+		std::optional<sf::FloatRect> visible;
+		if (m_culling)
+		{
+			const sf::View& vue{ target.getView() };
+			visible = states.transform.getInverse().transformRect(sf::FloatRect(vue.getCenter() - vue.getSize() / 2.f, vue.getSize()));
+		}
+		for (const auto& [debut, nombre] : drawnRanges(visible))
+		{
+			target.draw(m_renderVertexes, debut, nombre, states);
+			OPTTILE_STAT(++m_stats.drawCalls);
+			OPTTILE_STAT(m_stats.submittedVertexes += nombre);
+		}
+		return;
+	}
+
+	if (m_hiddenCount && !m_usePacked && !m_vertexes.empty())
+	{
+		if (m_shownRangesDirty)
+		{
+			m_shownRanges = drawnRanges(std::nullopt);
+			m_shownRangesDirty = false;
+		}
+		std::size_t montres{ 0 };
+		for (const auto& [debut, nombre] : m_shownRanges)
+			montres += nombre;
+		// Un appel de dessin cote  peu prs autant que ce nombre de sommets soumis ///
+		// A draw call costs about as much as this number of submitted vertexes
+		constexpr std::size_t coutAppel{ 1024 };
+		if (m_shownRanges.size() * coutAppel + montres < m_vertexes.size())
+		{
+			for (const auto& [debut, nombre] : m_shownRanges)
+			{
+				target.draw(m_renderVertexes, debut, nombre, states);
+				OPTTILE_STAT(++m_stats.drawCalls);
+				OPTTILE_STAT(m_stats.submittedVertexes += nombre);
+			}
+			return;
+		}
+	}
+
 	if (!m_vertexes.empty())
-		target.draw(m_renderVertexes, states);
+	{
+		target.draw(tampon, states);
+		OPTTILE_STAT(m_stats.uploadedBytes += m_packed.takeUploadedBytes());
+		OPTTILE_STAT(++m_stats.drawCalls);
+		OPTTILE_STAT(m_stats.submittedVertexes += m_usePacked ? m_packed.getVertexCount() : m_renderVertexes.getVertexCount());
+	}
 }
 
 void opt::Level::move(float offsetX, float offsetY, std::size_t index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->move(offsetX, offsetY);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 	//for (std::size_t i{ m_beginTileIndex[index] }; continueUpdate(index, i); ++i)
 	//{
 	//	m_vertexes[i].position += sf::Vector2f(offsetX, offsetY);
@@ -129,8 +581,9 @@ void opt::Level::move(float offsetX, float offsetY, std::size_t index)
 
 void opt::Level::move(const sf::Vector2f& offset, std::size_t index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->move(offset);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 	//for (std::size_t i{ m_beginTileIndex[index] }; continueUpdate(index, i); ++i)
 	//{
 	//	m_vertexes[i].position += offset;
@@ -140,8 +593,9 @@ void opt::Level::move(const sf::Vector2f& offset, std::size_t index)
 
 void opt::Level::setPosition(float x, float y, std::size_t index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->setPosition(x, y);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 	//sf::Vector2f deplacement{sf::Vector2f(x, y) - m_tiles[index]->getPosition()};
 	//for (std::size_t i{m_beginTileIndex[index]}; continueUpdate(index, i); ++i)
 	//{
@@ -151,8 +605,9 @@ void opt::Level::setPosition(float x, float y, std::size_t index)
 
 void opt::Level::setPosition(const sf::Vector2f& position, std::size_t index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->setPosition(position);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 	//sf::Vector2f deplacement{position - m_tiles[index]->getPosition()};
 	//for (std::size_t i{m_beginTileIndex[index]}; continueUpdate(index, i); ++i)
 	//{
@@ -162,29 +617,33 @@ void opt::Level::setPosition(const sf::Vector2f& position, std::size_t index)
 
 void opt::Level::resize(float x, float y, std::size_t index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->resize(x, y);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 }
 
 void opt::Level::resize(const sf::Vector2f& size, std::size_t index)
 {
 	//std::size_t nbSommets{m_tiles[index]->vertexes().size()};
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->resize(size);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 }
 
 void opt::Level::resize(float x, float y, TextureRule textureRule, std::size_t index)
 {
 	//std::size_t nbSommets{m_tiles[index]->vertexes().size()};
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->resize(x, y, textureRule);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 }
 
 void opt::Level::resize(const sf::Vector2f& size, TextureRule textureRule, std::size_t index)
 {
 	//std::size_t nbSommets{m_tiles[index]->vertexes().size()};
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->resize(size, textureRule);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 }
 
 void opt::Level::loadTexture(const std::string& path, int subTextureCount)
@@ -205,7 +664,7 @@ void opt::Level::loadTexture(const std::string& path, int subTextureCount)
 	{
 		tuile->reloadTexture();
 	}
-	if (m_autoUpdate) reloadBuffer();
+	updateAllTiles();
 }
 
 void opt::Level::loadTexture(const std::string& path, std::vector<sf::FloatRect>& subTextures)
@@ -227,38 +686,19 @@ void opt::Level::loadTexture(const std::string& path, std::vector<sf::FloatRect>
 	{
 		tuile->reloadTexture();
 	}
-	if (m_autoUpdate) reloadBuffer();
+	updateAllTiles();
 }
 
 void opt::Level::loadTexture(const std::string& path, const std::string& subTexturePath)
 {
 	if (!m_texture.loadFromFile(path))
 		throw opt::LoadException(path);
-	std::fstream fichier{subTexturePath};
-	std::vector<std::string> lignes;
-	for (int i{ 0 }; fichier; ++i)
-	{
-		lignes.push_back("");
-		std::getline(fichier, lignes[i]);
-	}
-	if (lignes.empty())
-		throw opt::LoadException(subTexturePath);
-	if (lignes[lignes.size() - 1] == "")
-		lignes.pop_back();
-	m_subTextures.resize(lignes.size());
-	for (int i{ 0 }; i < m_subTextures.size(); ++i)
-	{
-		std::vector<std::string> donnees{splitString(lignes[i], ',') };
-		m_subTextures[i].left = parse<float>(donnees[0]);
-		m_subTextures[i].top = parse<float>(donnees[1]);
-		m_subTextures[i].width = parse<float>(donnees[2]);
-		m_subTextures[i].height = parse<float>(donnees[3]);
-	}
+	m_subTextures = readSubTextures(subTexturePath);
 	for (auto& tuile : m_tiles)
 	{
 		tuile->reloadTexture();
 	}
-	if (m_autoUpdate) reloadBuffer();
+	updateAllTiles();
 }
 
 void opt::Level::loadTexture(const sf::Texture& texture, int subTextureCount)
@@ -277,7 +717,7 @@ void opt::Level::loadTexture(const sf::Texture& texture, int subTextureCount)
 	{
 		tuile->reloadTexture();
 	}
-	if (m_autoUpdate) reloadBuffer();
+	updateAllTiles();
 }
 
 void opt::Level::loadTexture(const sf::Texture& texture, std::vector<sf::FloatRect>& subTextures)
@@ -289,89 +729,97 @@ void opt::Level::loadTexture(const sf::Texture& texture, std::vector<sf::FloatRe
 	{
 		tuile->reloadTexture();
 	}
-	if (m_autoUpdate) reloadBuffer();
+	updateAllTiles();
 }
 
 void opt::Level::loadTexture(const sf::Texture& texture, const std::string& subTexturePath)
 {
 	m_texture = texture;
-	std::fstream fichier{subTexturePath};
-	std::vector<std::string> lignes;
-	for (int i{ 0 }; fichier; ++i)
-	{
-		lignes.push_back("");
-		std::getline(fichier, lignes[i]);
-	}
-	if (lignes[lignes.size() - 1] == "")
-		lignes.pop_back();
-	if (lignes.empty())
-		throw "No data was within the file";
-	m_subTextures.resize(lignes.size());
-	for (int i{ 0 }; i < m_subTextures.size(); ++i)
-	{
-		std::vector<std::string> donnees{splitString(lignes[i], ',') };
-		m_subTextures[i].left = parse<float>(donnees[0]);
-		m_subTextures[i].top = parse<float>(donnees[1]);
-		m_subTextures[i].width = parse<float>(donnees[2]);
-		m_subTextures[i].height = parse<float>(donnees[3]);
-	}
+	m_subTextures = readSubTextures(subTexturePath);
 	for (auto& tuile : m_tiles)
 	{
 		tuile->reloadTexture();
 	}
-	if (m_autoUpdate) reloadBuffer();
+	updateAllTiles();
 }
 
 void opt::Level::setScale(const sf::Vector2f& scale, std::size_t index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->setScale(scale);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 }
 
 void opt::Level::setScale(float x, float y, std::size_t index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->setScale(x, y);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 }
 
 void opt::Level::setScale(const sf::Vector2f& scale, TextureRule textureRule, std::size_t index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->setScale(scale, textureRule);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 }
 
 void opt::Level::setScale(float x, float y, TextureRule textureRule, std::size_t index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->setScale(x, y, textureRule);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 }
 
 void opt::Level::setScale(float scale, TextureRule textureRule, std::size_t index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->setScale(scale, textureRule);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 }
 
 void opt::Level::setScale(float scale, std::size_t index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->setScale(scale);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 }
 
 void opt::Level::resetTiles()
 {
-	for (auto& tuile : m_tiles)
-		tuile.release();
-	m_tiles.resize(0);
+	m_tiles.clear();
 	m_beginTileIndex.resize(0);
 	m_renderVertexes.create(0);
 	m_vertexes.resize(0);
+	m_staticCache.clear();
+	m_instanced.resize(0);
+	m_packed.clear();
+	m_pendingUploads.clear();
+	m_isPending.clear();
+	m_tilesBySubTexture.clear();
+	m_columns.resize(0);
+	m_occlusion.clear();
+	m_forcedOpacity.clear();
+	m_layers.clearTiles();
+	m_hidden.clear();
+	m_hiddenCount = 0;
+	m_shownRangesDirty = true;
+	m_layoutChanges = 0;
+	m_indexOrder = true;
+	m_cullingGrid.clear();
+	markSnapshotAll();
+	m_isJournaled.clear();
+	m_journaledTiles.clear();
+	m_journalReset = m_journaling;
 }
 
 void opt::Level::add(const opt::Tile& tile)
 {
 	m_tiles.push_back(tile.clone());
-	reloadBuffer();
+	m_tiles.back()->m_stats = &m_stats;
+	m_tiles.back()->m_indexOrder = &m_indexOrder;
+	m_columns.resize(m_tiles.size());
+	updateTile(m_tiles.size() - 1, sf::FloatRect());
 	//if (!m_vertexes.empty())
 	//	m_renderVertexes.update(m_vertexes.data(), m_vertexes.size(), 0);
 }
@@ -380,7 +828,11 @@ void opt::Level::add(const sf::Vector2f& size, const sf::Vector2f& position, int
 {
 	m_tiles.push_back(std::make_unique<opt::Tile>(numberSubTexture, sf::FloatRect(position, size),
 		textureRule, m_subTextures, m_beginTileIndex, m_vertexes));
-	reloadBuffer();
+	m_tiles.back()->m_stats = &m_stats;
+	m_tiles.back()->m_indexOrder = &m_indexOrder;
+	m_columns.resize(m_tiles.size());
+	OPTTILE_STAT(++m_stats.initializeVertexesCalls[static_cast<std::size_t>(m_tiles.back()->getTextureRule())]);
+	updateTile(m_tiles.size() - 1, sf::FloatRect());
 	//if (!m_vertexes.empty())
 	//	m_renderVertexes.update(m_vertexes.data(), m_vertexes.size(), 0);
 }
@@ -389,7 +841,11 @@ void opt::Level::add(const sf::Vector2f& size, const sf::Vector2f& position, int
 {
 	m_tiles.push_back(std::make_unique<opt::Tile>(numberSubTexture, sf::FloatRect(position, size),
 		textureRule, m_subTextures, m_beginTileIndex, m_vertexes, scale));
-	reloadBuffer();
+	m_tiles.back()->m_stats = &m_stats;
+	m_tiles.back()->m_indexOrder = &m_indexOrder;
+	m_columns.resize(m_tiles.size());
+	OPTTILE_STAT(++m_stats.initializeVertexesCalls[static_cast<std::size_t>(m_tiles.back()->getTextureRule())]);
+	updateTile(m_tiles.size() - 1, sf::FloatRect());
 	//if (!m_vertexes.empty())
 	//	m_renderVertexes.update(m_vertexes.data(), m_vertexes.size(), 0);
 }
@@ -406,20 +862,23 @@ const std::vector<sf::FloatRect>& opt::Level::getSubTextures() const
 
 void opt::Level::changeTextureRect(int numberTexture, int index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->changeTextureRect(numberTexture);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 }
 
 void opt::Level::changeColour(const sf::Color& color, int index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->changeColour(color);
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 }
 
 void opt::Level::resetColour(int index)
 {
+	const sf::FloatRect ancien{ m_tiles[index]->getGlobalBounds() };
 	m_tiles[index]->resetColour();
-	if (m_autoUpdate) reloadBuffer();
+	updateTile(index, ancien);
 }
 
 sf::Color opt::Level::getColour(int index) const
@@ -456,3 +915,1092 @@ void opt::Level::bufferAutoUpdate(bool autoUpdate)
 {
 	m_autoUpdate = autoUpdate;
 }
+
+bool opt::Level::bufferAutoUpdate() const
+{
+	return m_autoUpdate;
+}
+
+opt::LevelStats opt::Level::stats() const
+{
+	LevelStats stats{ m_stats };
+	stats.cpuBytes = sizeof(Level)
+		+ m_tiles.capacity() * sizeof(std::unique_ptr<Tile>) + m_tiles.size() * sizeof(Tile)
+		+ m_beginTileIndex.capacity() * sizeof(std::size_t)
+		+ m_vertexes.capacity() * sizeof(sf::Vertex)
+		+ m_subTextures.capacity() * sizeof(sf::FloatRect)
+		+ m_instanced.size() * sizeof(TileInstance)
+		+ m_packed.getVertexCount() * sizeof(PackedVertex)
+		+ m_layers.cpuBytes()
+		+ m_visibleVertexes.capacity() * sizeof(sf::Vertex);
+	stats.gpuBytes = m_renderVertexes.getVertexCount() * sizeof(sf::Vertex)
+		+ static_cast<std::size_t>(m_texture.getSize().x) * m_texture.getSize().y * 4
+		+ m_staticCache.gpuBytes()
+		+ m_instanced.gpuBytes()
+		+ m_packed.gpuBytes()
+		+ m_layers.gpuBytes();
+	return stats;
+}
+
+void opt::Level::resetStats()
+{
+	m_stats.reset();
+}
+
+void opt::Level::staticCache(bool enabled, unsigned cellSize)
+{
+	const bool grille{ usesCullingGrid() };
+	m_useStaticCache = enabled;
+	refreshCullingGrid(grille);
+	if (!enabled || cellSize != m_staticCache.cellSize())
+		m_staticCache.setCellSize(cellSize);
+	m_staticCache.invalidate();
+}
+
+void opt::Level::invalidateCache()
+{
+	m_staticCache.invalidate();
+}
+
+bool opt::Level::instancedRendering(bool enabled)
+{
+	m_useInstanced = enabled && InstancedRenderer::isAvailable();
+	m_instanced.resize(0);
+	updateAllTiles();
+	if (!m_useInstanced && !m_autoUpdate)
+		reloadBuffer();
+	return m_useInstanced;
+}
+
+bool opt::Level::packedVertexes(bool enabled)
+{
+	m_usePacked = enabled && PackedVertexBuffer::isAvailable();
+	if (m_usePacked)
+		m_renderVertexes.create(0);
+	else
+		m_packed.clear();
+	m_staticCache.invalidate();
+	if (usesVertexBuffer())
+		reloadBuffer();
+	return m_usePacked;
+}
+
+void opt::Level::uploadBudget(std::size_t bytesPerFrame)
+{
+	m_uploadBudget = bytesPerFrame;
+	if (!bytesPerFrame)
+		flushAll();
+}
+
+void opt::Level::flushAll()
+{
+	std::vector<std::size_t> toutes;
+	toutes.swap(m_pendingUploads);
+	uploadTiles(toutes);
+}
+
+std::size_t opt::Level::pendingUploads() const
+{
+	return m_pendingUploads.size();
+}
+
+void opt::Level::enqueueMove(const sf::Vector2f& offset, std::size_t index)
+{
+	TileMutation mutation;
+	mutation.type = TileMutation::Type::move;
+	mutation.index = index;
+	mutation.vector = offset;
+	m_mutations.push(mutation);
+}
+
+void opt::Level::enqueueSetPosition(const sf::Vector2f& position, std::size_t index)
+{
+	TileMutation mutation;
+	mutation.type = TileMutation::Type::setPosition;
+	mutation.index = index;
+	mutation.vector = position;
+	m_mutations.push(mutation);
+}
+
+void opt::Level::enqueueResize(const sf::Vector2f& size, std::size_t index)
+{
+	TileMutation mutation;
+	mutation.type = TileMutation::Type::resize;
+	mutation.index = index;
+	mutation.vector = size;
+	m_mutations.push(mutation);
+}
+
+void opt::Level::enqueueSetColour(const sf::Color& color, std::size_t index)
+{
+	TileMutation mutation;
+	mutation.type = TileMutation::Type::setColour;
+	mutation.index = index;
+	mutation.colour = color;
+	m_mutations.push(mutation);
+}
+
+void opt::Level::enqueueChangeTexture(int numberTexture, std::size_t index)
+{
+	TileMutation mutation;
+	mutation.type = TileMutation::Type::changeTexture;
+	mutation.index = index;
+	mutation.subTexture = numberTexture;
+	m_mutations.push(mutation);
+}
+
+void opt::Level::enqueueAdd(const sf::Vector2f& size, const sf::Vector2f& position, int numberSubTexture, TextureRule textureRule)
+{
+	TileMutation mutation;
+	mutation.type = TileMutation::Type::add;
+	mutation.vector = size;
+	mutation.position = position;
+	mutation.subTexture = numberSubTexture;
+	mutation.rule = textureRule;
+	m_mutations.push(mutation);
+}
+
+std::size_t opt::Level::applyMutations()
+{
+	// tat final demand pour une tuile ///
+	// Final state requested for a tile
+	struct Fusion {
+		std::size_t index{ 0 };
+		std::optional<sf::Vector2f> position{};
+		sf::Vector2f deplacement{};
+		std::optional<sf::Vector2f> taille{};
+		std::optional<sf::Color> couleur{};
+		std::optional<int> sousTexture{};
+	};
+
+	const bool autoUpdate{ m_autoUpdate };
+	m_autoUpdate = false;
+	std::vector<Fusion> fusions;
+	std::unordered_map<std::size_t, std::size_t> emplacements;
+	std::size_t retirees{ 0 };
+	TileMutation mutation;
+	while (m_mutations.pop(mutation))
+	{
+		++retirees;
+		if (mutation.type == TileMutation::Type::add)
+		{
+			add(mutation.vector, mutation.position, mutation.subTexture, mutation.rule);
+			continue;
+		}
+		const auto [iterateur, nouvelle] { emplacements.try_emplace(mutation.index, fusions.size()) };
+		if (nouvelle)
+			fusions.push_back(Fusion{ mutation.index });
+		else
+			OPTTILE_STAT(++m_stats.coalescedMutations);
+		Fusion& fusion{ fusions[iterateur->second] };
+		switch (mutation.type)
+		{
+		case TileMutation::Type::move:
+			fusion.deplacement += mutation.vector;
+			break;
+		case TileMutation::Type::setPosition:
+			fusion.position = mutation.vector;
+			fusion.deplacement = sf::Vector2f();
+			break;
+		case TileMutation::Type::resize:
+			fusion.taille = mutation.vector;
+			break;
+		case TileMutation::Type::setColour:
+			fusion.couleur = mutation.colour;
+			break;
+		case TileMutation::Type::changeTexture:
+			fusion.sousTexture = mutation.subTexture;
+			break;
+		default:
+			break;
+		}
+	}
+	OPTTILE_STAT(m_stats.appliedMutations += retirees);
+
+	// Si une tuile change de nombre de sommets, les suivantes sont dcales dans le tampon ///
+	// If a tile changes its vertex count, the following ones are shifted inside the buffer
+	bool decalage{ m_renderVertexes.getVertexCount() != m_vertexes.size() };
+	std::vector<std::size_t> modifiees;
+	for (const Fusion& fusion : fusions)
+	{
+		if (fusion.index >= m_tiles.size())
+			continue;
+		const std::size_t sommets{ m_tiles[fusion.index]->vertexCount() };
+		if (fusion.sousTexture)
+			changeTextureRect(*fusion.sousTexture, static_cast<int>(fusion.index));
+		if (fusion.taille)
+			resize(*fusion.taille, fusion.index);
+		if (fusion.position)
+			setPosition(*fusion.position + fusion.deplacement, fusion.index);
+		else if (fusion.deplacement != sf::Vector2f())
+			move(fusion.deplacement, fusion.index);
+		if (fusion.couleur)
+			changeColour(*fusion.couleur, static_cast<int>(fusion.index));
+		decalage = decalage || m_tiles[fusion.index]->vertexCount() != sommets;
+		modifiees.push_back(fusion.index);
+	}
+
+	m_autoUpdate = autoUpdate;
+	if (retirees)
+		syncTiles(modifiees, decalage);
+	return retirees;
+}
+
+const std::vector<std::size_t>& opt::Level::tilesUsing(int subTexture) const
+{
+	return m_tilesBySubTexture.tilesUsing(subTexture);
+}
+
+std::size_t opt::Level::replaceSubTexture(int from, int to)
+{
+	if (from == to || to < 0 || to >= static_cast<int>(m_subTextures.size()))
+		return 0;
+	const std::vector<std::size_t>& tuiles{ m_tilesBySubTexture.tilesUsing(from) };
+	// Copie : changeTextureRect retire les tuiles de la liste parcourue ///
+	// Copy: changeTextureRect removes the tiles from the iterated list
+	std::vector<std::pair<std::size_t, int>> changements;
+	changements.reserve(tuiles.size());
+	for (std::size_t index : tuiles)
+		changements.emplace_back(index, to);
+	changeTextureRects(changements);
+	return changements.size();
+}
+
+void opt::Level::changeTextureRects(const std::vector<std::pair<std::size_t, int>>& changes)
+{
+	if (changes.empty())
+		return;
+	const bool autoUpdate{ m_autoUpdate };
+	m_autoUpdate = false;
+	bool decalage{ m_renderVertexes.getVertexCount() != m_vertexes.size() };
+	std::vector<std::size_t> tuiles;
+	tuiles.reserve(changes.size());
+	for (const auto& [index, sousTexture] : changes)
+	{
+		if (index >= m_tiles.size())
+			continue;
+		const std::size_t sommets{ m_tiles[index]->vertexCount() };
+		changeTextureRect(sousTexture, static_cast<int>(index));
+		decalage = decalage || m_tiles[index]->vertexCount() != sommets;
+		tuiles.push_back(index);
+	}
+	m_autoUpdate = autoUpdate;
+	syncTiles(tuiles, decalage);
+}
+
+void opt::Level::append(const Level& other, const sf::Vector2f& offset)
+{
+	// Association des sous-textures, vrifie avant toute modification ///
+	// Subtexture mapping, checked before any change
+	std::vector<int> correspondances(other.m_subTextures.size(), -1);
+	for (std::size_t i{ 0 }; i < other.m_subTextures.size(); ++i)
+	{
+		if (i < m_subTextures.size() && m_subTextures[i] == other.m_subTextures[i])
+			correspondances[i] = static_cast<int>(i);
+		else
+		{
+			const auto trouvee{ std::find(m_subTextures.begin(), m_subTextures.end(), other.m_subTextures[i]) };
+			if (trouvee != m_subTextures.end())
+				correspondances[i] = static_cast<int>(trouvee - m_subTextures.begin());
+		}
+	}
+	for (const auto& tuile : other.m_tiles)
+	{
+		const int sousTexture{ tuile->m_subTextureIndex };
+		if (sousTexture >= 0 && sousTexture < static_cast<int>(correspondances.size()) && correspondances[sousTexture] < 0)
+			throw AtlasException(sousTexture);
+	}
+
+	// Les tailles sont lues avant d'agrandir : other peut tre ce niveau ///
+	// Sizes are read before growing: other may be this level
+	const std::size_t debut{ m_vertexes.size() };
+	const std::size_t nbSommets{ other.m_vertexes.size() };
+	const std::size_t premiereTuile{ m_tiles.size() };
+	const std::size_t nbTuiles{ other.m_tiles.size() };
+
+	m_vertexes.resize(debut + nbSommets);
+	for (std::size_t i{ 0 }; i < nbSommets; ++i)
+	{
+		m_vertexes[debut + i] = other.m_vertexes[i];
+		m_vertexes[debut + i].position += offset;
+	}
+	m_beginTileIndex.reserve(premiereTuile + nbTuiles);
+	for (std::size_t i{ 0 }; i < nbTuiles; ++i)
+		m_beginTileIndex.push_back(other.m_beginTileIndex[i] + debut);
+	m_indexOrder = m_indexOrder && other.m_indexOrder;
+
+	m_tiles.reserve(premiereTuile + nbTuiles);
+	for (std::size_t i{ 0 }; i < nbTuiles; ++i)
+	{
+		std::unique_ptr<Tile> tuile{ other.m_tiles[i]->clone() };
+		// Pointeurs non propritaires vers les listes de ce niveau (constructeur d'aliasing sans propritaire) ///
+		// Non-owning pointers to this level's vectors (aliasing constructor without owner)
+		tuile->m_vertexes = std::shared_ptr<std::vector<sf::Vertex>>(std::shared_ptr<void>(), &m_vertexes);
+		tuile->m_beginTiles = std::shared_ptr<std::vector<std::size_t>>(std::shared_ptr<void>(), &m_beginTileIndex);
+		tuile->m_subTextures = std::shared_ptr<const std::vector<sf::FloatRect>>(std::shared_ptr<void>(), &m_subTextures);
+		tuile->m_tileIndex = premiereTuile + i;
+		tuile->m_tileRect.left += offset.x;
+		tuile->m_tileRect.top += offset.y;
+		if (tuile->m_subTextureIndex >= 0 && tuile->m_subTextureIndex < static_cast<int>(correspondances.size()))
+			tuile->m_subTextureIndex = correspondances[tuile->m_subTextureIndex];
+		tuile->m_stats = &m_stats;
+		tuile->m_indexOrder = &m_indexOrder;
+		m_tiles.push_back(std::move(tuile));
+	}
+	m_columns.append(other.m_columns, nbTuiles);
+	registerAdded(premiereTuile, nbSommets != 0);
+}
+
+void opt::Level::registerAdded(std::size_t firstTile, bool shifted)
+{
+	std::vector<std::size_t> ajoutees(m_tiles.size() - firstTile);
+	for (std::size_t i{ 0 }; i < ajoutees.size(); ++i)
+	{
+		ajoutees[i] = firstTile + i;
+		refreshTile(firstTile + i);
+	}
+	m_shownRangesDirty = true;
+	syncTiles(ajoutees, shifted);
+}
+
+void opt::Level::add(std::span<const TileRecord> tiles)
+{
+	const std::size_t premiereTuile{ m_tiles.size() };
+	const std::size_t debut{ m_vertexes.size() };
+	// Vrifie les sous-textures avant toute modification ///
+	// Checks the subtextures before any change
+	LevelFile::buildVertexes(tiles, m_subTextures, m_vertexes, &m_beginTileIndex);
+
+	m_tiles.reserve(premiereTuile + tiles.size());
+	for (std::size_t i{ 0 }; i < tiles.size(); ++i)
+	{
+		const TileRecord& description{ tiles[i] };
+		const std::size_t index{ premiereTuile + i };
+		std::unique_ptr<Tile> tuile{ std::make_unique<Tile>() };
+		tuile->m_vertexes = std::shared_ptr<std::vector<sf::Vertex>>(std::shared_ptr<void>(), &m_vertexes);
+		tuile->m_beginTiles = std::shared_ptr<std::vector<std::size_t>>(std::shared_ptr<void>(), &m_beginTileIndex);
+		tuile->m_subTextures = std::shared_ptr<const std::vector<sf::FloatRect>>(std::shared_ptr<void>(), &m_subTextures);
+		tuile->m_tileIndex = index;
+		tuile->m_tileRect = description.rect;
+		tuile->m_subTextureIndex = description.subTexture;
+		tuile->m_colour = description.colour;
+		if (description.rect.getSize() == sf::Vector2f())
+		{
+			tuile->m_textureRule = TextureRule::fill_space;
+			tuile->m_scale = description.scale;
+		}
+		else
+		{
+			tuile->m_textureRule = description.textureRule;
+			tuile->m_scale = Tile::resolvedScale(description.rect, &m_subTextures[description.subTexture], description.textureRule, description.scale);
+		}
+		tuile->m_tileVertexesCount = (index + 1 < m_beginTileIndex.size() ? m_beginTileIndex[index + 1] : m_vertexes.size()) - m_beginTileIndex[index];
+		tuile->m_stats = &m_stats;
+		tuile->m_indexOrder = &m_indexOrder;
+		OPTTILE_STAT(++m_stats.initializeVertexesCalls[static_cast<std::size_t>(tuile->m_textureRule)]);
+		m_tiles.push_back(std::move(tuile));
+	}
+	m_columns.resize(m_tiles.size());
+	registerAdded(premiereTuile, m_vertexes.size() != debut);
+}
+
+std::vector<opt::TileRecord> opt::Level::records() const
+{
+	std::vector<TileRecord> descriptions(m_tiles.size());
+	for (std::size_t i{ 0 }; i < m_tiles.size(); ++i)
+		descriptions[i] = tileRecord(i);
+	return descriptions;
+}
+
+opt::TileRecord opt::Level::tileRecord(std::size_t index) const
+{
+	const Tile& tuile{ *m_tiles[index] };
+	TileRecord description;
+	description.rect = tuile.m_tileRect;
+	description.subTexture = tuile.m_subTextureIndex;
+	description.textureRule = tuile.m_textureRule;
+	description.scale = tuile.m_scale;
+	description.colour = tuile.m_colour;
+	return description;
+}
+
+void opt::Level::save(const std::string& path, LevelFile::Encoding encoding) const
+{
+	LevelFile::save(path, records(), encoding);
+}
+
+void opt::Level::load(const std::string& path)
+{
+	// Le fichier est lu en entier avant de vider le niveau : une erreur de lecture le laisse intact ///
+	// The file is read entirely before emptying the level: a read error leaves it untouched
+	const std::vector<TileRecord> tuiles{ LevelFile::load(path) };
+	resetTiles();
+	add(tuiles);
+}
+
+void opt::Level::journal(bool enabled)
+{
+	m_journaling = enabled;
+	m_isJournaled.clear();
+	m_journaledTiles.clear();
+	m_journalReset = false;
+}
+
+std::size_t opt::Level::journalSize() const
+{
+	return m_journaledTiles.size();
+}
+
+void opt::Level::saveJournal(const std::string& path, LevelFile::Encoding encoding)
+{
+	if (m_journalReset)
+		save(path, encoding);
+	else if (!m_journaledTiles.empty())
+	{
+		// Tries par index, les tuiles ajoutes suivent les tuiles existantes dans l'ordre attendu par la relecture ///
+		// Sorted by index, the added tiles follow the existing tiles in the order expected by the replay
+		std::sort(m_journaledTiles.begin(), m_journaledTiles.end());
+		std::vector<TileChange> changements(m_journaledTiles.size());
+		for (std::size_t i{ 0 }; i < m_journaledTiles.size(); ++i)
+		{
+			changements[i].index = m_journaledTiles[i];
+			changements[i].record = tileRecord(m_journaledTiles[i]);
+		}
+		LevelFile::appendChanges(path, changements);
+	}
+	for (std::size_t index : m_journaledTiles)
+		m_isJournaled[index] = false;
+	m_journaledTiles.clear();
+	m_journalReset = false;
+}
+
+void opt::Level::saveBundle(const std::string& path, const std::string& imagePath, LevelFile::Encoding encoding) const
+{
+	const MappedFile image{ imagePath };
+	LevelBundle::save(path, std::span<const char>(image.data(), image.size()), m_subTextures, records(), encoding);
+}
+
+void opt::Level::loadBundle(const std::string& path)
+{
+	// Tout est dcod avant de toucher au niveau : une erreur le laisse intact ///
+	// Everything is decoded before touching the level: an error leaves it untouched
+	const LevelBundle paquet{ path };
+	std::vector<sf::FloatRect> sousTextures{ paquet.subTextures() };
+	const std::vector<TileRecord> tuiles{ paquet.tiles() };
+	sf::Texture texture;
+	if (!texture.loadFromMemory(paquet.image().data(), paquet.image().size()))
+		throw LoadException(path);
+	resetTiles();
+	m_texture.swap(texture);
+	m_subTextures = std::move(sousTextures);
+	// Mme rafrachissement que loadTexture : les sous-textures opaques sont dtectes avant l'ajout des tuiles ///
+	// Same refresh as loadTexture: opaque subtextures are detected before the tiles are added
+	updateAllTiles();
+	add(tuiles);
+}
+
+void opt::Level::markSnapshotTile(std::size_t index) const
+{
+	if (!m_snapshotTracking)
+		return;
+	if (m_vertexes.size() != m_trackedVertexCount)
+	{
+		markSnapshotFrom(index);
+		return;
+	}
+	const std::size_t morceau{ index / LevelSnapshot::tileChunk };
+	if (morceau < m_dirtyTileChunks.size())
+		m_dirtyTileChunks[morceau] = true;
+	if (index >= m_tiles.size())
+		return;
+	const std::size_t fin{ tileEnd(index) };
+	for (std::size_t i{ m_beginTileIndex[index] / LevelSnapshot::vertexChunk }; i * LevelSnapshot::vertexChunk < fin && i < m_dirtyVertexChunks.size(); ++i)
+		m_dirtyVertexChunks[i] = true;
+}
+
+void opt::Level::markSnapshotFrom(std::size_t index) const
+{
+	m_dirtyFromTile = std::min(m_dirtyFromTile, index);
+	// Une tuile ajoute commence l o finissaient les sommets suivis ///
+	// An added tile begins where the tracked vertexes ended
+	const std::size_t sommet{ index < m_beginTileIndex.size() ? m_beginTileIndex[index] : m_trackedVertexCount };
+	m_dirtyFromVertex = std::min({ m_dirtyFromVertex, sommet, m_trackedVertexCount });
+	m_trackedVertexCount = m_vertexes.size();
+}
+
+void opt::Level::markSnapshotAll() const
+{
+	m_dirtyFromTile = 0;
+	m_dirtyFromVertex = 0;
+}
+
+void opt::Level::journalTile(std::size_t index)
+{
+	if (!m_journaling)
+		return;
+	if (m_isJournaled.size() < m_tiles.size())
+		m_isJournaled.resize(m_tiles.size(), false);
+	if (m_isJournaled[index])
+		return;
+	m_isJournaled[index] = true;
+	m_journaledTiles.push_back(index);
+}
+
+opt::LevelSnapshot opt::Level::snapshot() const
+{
+	using TileChunk = LevelSnapshot::TileChunk;
+	const std::size_t nbMorceauxTuiles{ (m_tiles.size() + LevelSnapshot::tileChunk - 1) / LevelSnapshot::tileChunk };
+	const std::size_t nbMorceauxSommets{ (m_vertexes.size() + LevelSnapshot::vertexChunk - 1) / LevelSnapshot::vertexChunk };
+
+	// Seuls les morceaux modifis sont copis; les autres sont partags avec les photos prcdentes ///
+	// Only the modified chunks are copied; the others are shared with the previous snapshots
+	m_snapshotState.m_tileChunks.resize(nbMorceauxTuiles);
+	for (std::size_t i{ 0 }; i < nbMorceauxTuiles; ++i)
+	{
+		const std::size_t debut{ i * LevelSnapshot::tileChunk };
+		const std::size_t fin{ std::min(debut + LevelSnapshot::tileChunk, m_tiles.size()) };
+		if (m_snapshotState.m_tileChunks[i] && i < m_dirtyTileChunks.size() && !m_dirtyTileChunks[i] && fin <= m_dirtyFromTile)
+			continue;
+		std::shared_ptr<TileChunk> morceau{ std::make_shared<TileChunk>() };
+		morceau->records.resize(fin - debut);
+		morceau->begins.assign(m_beginTileIndex.begin() + debut, m_beginTileIndex.begin() + fin);
+		morceau->hidden.resize(fin - debut);
+		for (std::size_t j{ debut }; j < fin; ++j)
+		{
+			const Tile& tuile{ *m_tiles[j] };
+			TileRecord& description{ morceau->records[j - debut] };
+			description.rect = tuile.m_tileRect;
+			description.subTexture = tuile.m_subTextureIndex;
+			description.textureRule = tuile.m_textureRule;
+			description.scale = tuile.m_scale;
+			description.colour = tuile.m_colour;
+			morceau->hidden[j - debut] = isHidden(j);
+		}
+		m_snapshotState.m_tileChunks[i] = std::move(morceau);
+	}
+	m_snapshotState.m_vertexChunks.resize(nbMorceauxSommets);
+	for (std::size_t i{ 0 }; i < nbMorceauxSommets; ++i)
+	{
+		const std::size_t debut{ i * LevelSnapshot::vertexChunk };
+		const std::size_t fin{ std::min(debut + LevelSnapshot::vertexChunk, m_vertexes.size()) };
+		if (m_snapshotState.m_vertexChunks[i] && i < m_dirtyVertexChunks.size() && !m_dirtyVertexChunks[i] && fin <= m_dirtyFromVertex)
+			continue;
+		m_snapshotState.m_vertexChunks[i] = std::make_shared<const std::vector<sf::Vertex>>(m_vertexes.begin() + debut, m_vertexes.begin() + fin);
+	}
+	m_snapshotState.m_tileCount = m_tiles.size();
+	m_snapshotState.m_indexOrder = m_indexOrder;
+	m_snapshotState.m_vertexCount = m_vertexes.size();
+
+	m_dirtyTileChunks.assign(nbMorceauxTuiles, false);
+	m_dirtyVertexChunks.assign(nbMorceauxSommets, false);
+	m_dirtyFromTile = m_tiles.size();
+	m_dirtyFromVertex = m_vertexes.size();
+	m_trackedVertexCount = m_vertexes.size();
+	m_snapshotTracking = true;
+	return m_snapshotState;
+}
+
+void opt::Level::truncateTiles(std::size_t count)
+{
+	if (count >= m_tiles.size())
+		return;
+	for (std::size_t i{ count }; i < m_tiles.size(); ++i)
+	{
+		if (m_useStaticCache)
+			m_staticCache.invalidate(m_tiles[i]->getGlobalBounds());
+		if (isHidden(i))
+			--m_hiddenCount;
+	}
+	m_tilesBySubTexture.truncate(count);
+	m_occlusion.truncate(count);
+	m_cullingGrid.truncate(count);
+	m_layers.truncate(count);
+	m_vertexes.resize(m_beginTileIndex[count]);
+	m_beginTileIndex.resize(count);
+	m_tiles.resize(count);
+	m_columns.resize(count);
+	if (m_forcedOpacity.size() > count)
+		m_forcedOpacity.resize(count);
+	if (m_hidden.size() > count)
+		m_hidden.resize(count);
+	if (m_useInstanced)
+		m_instanced.resize(count);
+	std::erase_if(m_pendingUploads, [count](std::size_t index) { return index >= count; });
+	if (m_isPending.size() > count)
+		m_isPending.resize(count);
+	// Un retrait ne s'crit pas dans le journal /// A removal cannot be written inside the journal
+	m_isJournaled.clear();
+	m_journaledTiles.clear();
+	m_journalReset = m_journaling;
+	m_shownRangesDirty = true;
+	markSnapshotFrom(count);
+}
+
+void opt::Level::restore(const LevelSnapshot& snapshot)
+{
+	// L'tat courant est d'abord mis  jour : un morceau partag avec la photo est alors identique sans comparaison ///
+	// The current state is brought up to date first: a chunk shared with the snapshot is then identical without comparison
+	const LevelSnapshot actuel{ this->snapshot() };
+	const std::size_t communes{ std::min(actuel.m_tileCount, snapshot.m_tileCount) };
+	const auto debutPhoto{ [&snapshot](std::size_t index) {
+		return snapshot.m_tileChunks[index / LevelSnapshot::tileChunk]->begins[index % LevelSnapshot::tileChunk];
+	} };
+
+	// Les tuiles communes doivent avoir gard la place de leurs sommets ///
+	// The common tiles must have kept the place of their vertexes
+	bool enPlace{ true };
+	for (std::size_t i{ 0 }; enPlace && i * LevelSnapshot::tileChunk < communes; ++i)
+	{
+		if (actuel.m_tileChunks[i] == snapshot.m_tileChunks[i])
+			continue;
+		const std::size_t nombre{ std::min(communes - i * LevelSnapshot::tileChunk, LevelSnapshot::tileChunk) };
+		const std::vector<std::size_t>& debuts{ actuel.m_tileChunks[i]->begins };
+		enPlace = std::equal(debuts.begin(), debuts.begin() + nombre, snapshot.m_tileChunks[i]->begins.begin());
+	}
+	if (enPlace && m_tiles.size() > snapshot.m_tileCount)
+	{
+		// Les tuiles ajoutes depuis la photo doivent occuper la fin des sommets, dans l'ordre des index ///
+		// The tiles added since the snapshot must take the end of the vertexes, in index order
+		std::size_t sommet{ snapshot.m_vertexCount };
+		for (std::size_t i{ snapshot.m_tileCount }; enPlace && i < m_tiles.size(); ++i)
+		{
+			enPlace = m_beginTileIndex[i] == sommet;
+			sommet += m_tiles[i]->vertexCount();
+		}
+		enPlace = enPlace && sommet == m_vertexes.size();
+	}
+	else if (enPlace && m_tiles.size() < snapshot.m_tileCount)
+	{
+		// add construit les tuiles manquantes  la suite des sommets, dans l'ordre des index : la photo doit les avoir ranges ainsi ///
+		// add builds the missing tiles after the vertexes, in index order: the snapshot must have stored them this way
+		std::size_t sommet{ m_vertexes.size() };
+		for (std::size_t i{ m_tiles.size() }; enPlace && i < snapshot.m_tileCount; ++i)
+		{
+			enPlace = i == m_tiles.size() ? debutPhoto(i) == sommet : debutPhoto(i) >= sommet;
+			sommet = debutPhoto(i);
+		}
+	}
+	else if (enPlace)
+		enPlace = actuel.m_vertexCount == snapshot.m_vertexCount;
+
+	if (!enPlace)
+	{
+		// Les donnes propres aux tuiles sont gardes pour les index communs ///
+		// The data belonging to the tiles is kept for the common indexes
+		AttributeColumns colonnes{ std::move(m_columns) };
+		std::vector<std::uint8_t> opacites{ std::move(m_forcedOpacity) };
+		std::vector<std::size_t> couches(m_layers.active() ? communes : 0);
+		for (std::size_t i{ 0 }; i < couches.size(); ++i)
+			couches[i] = m_layers.layerOf(i);
+
+		std::vector<TileRecord> tuiles;
+		tuiles.reserve(snapshot.m_tileCount);
+		for (const auto& morceau : snapshot.m_tileChunks)
+			tuiles.insert(tuiles.end(), morceau->records.begin(), morceau->records.end());
+		resetTiles();
+		add(tuiles);
+		for (std::size_t i{ 0 }; i < snapshot.m_tileChunks.size(); ++i)
+			for (std::size_t j{ 0 }; j < snapshot.m_tileChunks[i]->hidden.size(); ++j)
+				if (snapshot.m_tileChunks[i]->hidden[j])
+					setVisible(i * LevelSnapshot::tileChunk + j, false);
+
+		colonnes.resize(m_tiles.size());
+		m_columns = std::move(colonnes);
+		opacites.resize(std::min(opacites.size(), m_tiles.size()));
+		m_forcedOpacity = std::move(opacites);
+		for (std::size_t i{ 0 }; m_useOcclusion && i < m_forcedOpacity.size(); ++i)
+			if (m_forcedOpacity[i])
+				m_occlusion.update(i, m_tiles[i]->getGlobalBounds(), isOpaque(i));
+		for (std::size_t i{ 0 }; i < couches.size(); ++i)
+			if (couches[i] != 0 && couches[i] != static_cast<std::size_t>(-1))
+				m_layers.moveTile(i, couches[i], uploadSource(m_beginTileIndex[i], tileEnd(i), &i, 1), m_tiles[i]->vertexCount(), m_tiles[i]->bottomLeftCorner().y);
+	}
+	else
+	{
+		const bool retirees{ m_tiles.size() > snapshot.m_tileCount };
+		truncateTiles(snapshot.m_tileCount);
+		// Les tuiles communes n'ont pas boug et add range les autres  la suite : l'ordre tient s'il tenait d'un ct ///
+		// Common tiles did not move and add stores the others after them: the order holds if it held on either side
+		m_indexOrder = m_indexOrder || snapshot.m_indexOrder;
+		std::vector<std::size_t> modifiees;
+		for (std::size_t i{ 0 }; i * LevelSnapshot::tileChunk < communes; ++i)
+		{
+			if (actuel.m_tileChunks[i] == snapshot.m_tileChunks[i])
+				continue;
+			const LevelSnapshot::TileChunk& avant{ *actuel.m_tileChunks[i] };
+			const LevelSnapshot::TileChunk& apres{ *snapshot.m_tileChunks[i] };
+			const std::size_t nombre{ std::min(communes - i * LevelSnapshot::tileChunk, LevelSnapshot::tileChunk) };
+			for (std::size_t j{ 0 }; j < nombre; ++j)
+			{
+				const TileRecord& a{ avant.records[j] };
+				const TileRecord& b{ apres.records[j] };
+				if (a.rect == b.rect && a.subTexture == b.subTexture && a.textureRule == b.textureRule && a.scale == b.scale
+					&& a.colour == b.colour && avant.hidden[j] == apres.hidden[j])
+					continue;
+				const std::size_t index{ i * LevelSnapshot::tileChunk + j };
+				Tile& tuile{ *m_tiles[index] };
+				if (m_useStaticCache)
+					m_staticCache.invalidate(tuile.getGlobalBounds());
+				tuile.m_tileRect = b.rect;
+				tuile.m_subTextureIndex = b.subTexture;
+				tuile.m_textureRule = b.textureRule;
+				tuile.m_scale = b.scale;
+				tuile.m_colour = b.colour;
+				const bool sousTexture{ b.rect.getSize() != sf::Vector2f() && b.subTexture >= 0 && b.subTexture < static_cast<int>(m_subTextures.size()) };
+				tuile.m_tileVertexesCount = Tile::vertexCount(b.rect, sousTexture ? &m_subTextures[b.subTexture] : nullptr, b.scale);
+				if (avant.hidden[j] != apres.hidden[j])
+				{
+					if (m_hidden.size() < m_tiles.size())
+						m_hidden.resize(m_tiles.size(), false);
+					m_hidden[index] = apres.hidden[j];
+					m_hiddenCount = apres.hidden[j] ? m_hiddenCount + 1 : m_hiddenCount - 1;
+				}
+				modifiees.push_back(index);
+			}
+		}
+		// Seule la partie des sommets commune  la photo est recopie; add construit le reste ///
+		// Only the part of the vertexes common with the snapshot is copied back; add builds the rest
+		const std::size_t limite{ std::min(m_vertexes.size(), snapshot.m_vertexCount) };
+		for (std::size_t i{ 0 }; i * LevelSnapshot::vertexChunk < limite; ++i)
+		{
+			if (i < actuel.m_vertexChunks.size() && actuel.m_vertexChunks[i] == snapshot.m_vertexChunks[i])
+				continue;
+			const std::vector<sf::Vertex>& morceau{ *snapshot.m_vertexChunks[i] };
+			const std::size_t nombre{ std::min(morceau.size(), limite - i * LevelSnapshot::vertexChunk) };
+			std::copy(morceau.begin(), morceau.begin() + nombre, m_vertexes.begin() + i * LevelSnapshot::vertexChunk);
+		}
+		for (std::size_t index : modifiees)
+			refreshTile(index);
+		m_shownRangesDirty = true;
+		syncTiles(modifiees, retirees);
+
+		if (m_tiles.size() < snapshot.m_tileCount)
+		{
+			const std::size_t premiere{ m_tiles.size() };
+			std::vector<TileRecord> tuiles;
+			tuiles.reserve(snapshot.m_tileCount - premiere);
+			for (std::size_t i{ premiere }; i < snapshot.m_tileCount; ++i)
+				tuiles.push_back(snapshot.m_tileChunks[i / LevelSnapshot::tileChunk]->records[i % LevelSnapshot::tileChunk]);
+			add(tuiles);
+			for (std::size_t i{ premiere }; i < snapshot.m_tileCount; ++i)
+				if (snapshot.m_tileChunks[i / LevelSnapshot::tileChunk]->hidden[i % LevelSnapshot::tileChunk])
+					setVisible(i, false);
+		}
+	}
+
+	// Le niveau est maintenant identique  la photo : il partage tous ses morceaux ///
+	// The level is now identical to the snapshot: it shares all of its chunks
+	m_snapshotState = snapshot;
+	m_dirtyTileChunks.assign(snapshot.m_tileChunks.size(), false);
+	m_dirtyVertexChunks.assign(snapshot.m_vertexChunks.size(), false);
+	m_dirtyFromTile = m_tiles.size();
+	m_dirtyFromVertex = m_vertexes.size();
+	m_trackedVertexCount = m_vertexes.size();
+}
+
+void opt::Level::importGrid(const std::string& path, const sf::Vector2f& cellSize, const GridImportOptions& options)
+{
+	add(GridImport::read(path, cellSize, options));
+}
+
+void opt::Level::removeColumn(const std::string& name)
+{
+	m_columns.remove(name);
+}
+
+void opt::Level::sortLayout()
+{
+	m_layoutChanges = 0;
+	if (m_tiles.size() < 2)
+		return;
+
+	sf::Vector2f minimum{ m_tiles[0]->getGlobalBounds().getPosition() }, maximum{ minimum };
+	std::vector<sf::Vector2f> centres(m_tiles.size());
+	for (std::size_t i{ 0 }; i < m_tiles.size(); ++i)
+	{
+		const sf::FloatRect rectangle{ m_tiles[i]->getGlobalBounds() };
+		centres[i] = sf::Vector2f(rectangle.left + rectangle.width / 2.f, rectangle.top + rectangle.height / 2.f);
+		minimum.x = std::min(minimum.x, centres[i].x);
+		minimum.y = std::min(minimum.y, centres[i].y);
+		maximum.x = std::max(maximum.x, centres[i].x);
+		maximum.y = std::max(maximum.y, centres[i].y);
+	}
+	// Les centres sont ramens sur 16 bits par axe avant l'entrelacement ///
+	// Centres are brought down to 16 bits per axis before interleaving
+	const sf::Vector2f echelle{ maximum.x > minimum.x ? 65535.f / (maximum.x - minimum.x) : 0.f,
+		maximum.y > minimum.y ? 65535.f / (maximum.y - minimum.y) : 0.f };
+	std::vector<std::pair<std::uint32_t, std::size_t>> ordre(m_tiles.size());
+	for (std::size_t i{ 0 }; i < m_tiles.size(); ++i)
+	{
+		const std::uint32_t x{ static_cast<std::uint32_t>((centres[i].x - minimum.x) * echelle.x) };
+		const std::uint32_t y{ static_cast<std::uint32_t>((centres[i].y - minimum.y) * echelle.y) };
+		ordre[i] = { spreadBits(x) | (spreadBits(y) << 1), i };
+	}
+	std::sort(ordre.begin(), ordre.end());
+
+	std::vector<sf::Vertex> sommets;
+	sommets.reserve(m_vertexes.size());
+	for (const auto& [code, index] : ordre)
+	{
+		const std::size_t debut{ sommets.size() };
+		sommets.insert(sommets.end(), m_vertexes.begin() + m_beginTileIndex[index], m_vertexes.begin() + tileEnd(index));
+		m_beginTileIndex[index] = debut;
+	}
+	// change du contenu : les tuiles gardent l'adresse du vector ///
+	// Content swap: tiles keep the address of the vector
+	m_vertexes.swap(sommets);
+	m_indexOrder = false;
+
+	// Le tampon n'a plus le mme rangement : les tlversements partiels en attente ne sont plus valides ///
+	// The buffer no longer has the same layout: pending partial uploads are no longer valid
+	m_pendingUploads.clear();
+	m_isPending.assign(m_isPending.size(), false);
+	m_staticCache.invalidate();
+	// L'ordre de dessin a chang : une tuile peut passer sous ou sur une autre ///
+	// The draw order changed: a tile may go under or over another one
+	m_occlusion.markAll();
+	m_shownRangesDirty = true;
+	markSnapshotAll();
+}
+
+void opt::Level::optimizeLayout()
+{
+	sortLayout();
+	if (m_autoUpdate && usesVertexBuffer())
+		reloadBuffer();
+}
+
+void opt::Level::autoOptimizeLayout(bool enabled)
+{
+	m_autoLayout = enabled;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> opt::Level::vertexRanges(const sf::FloatRect& area) const
+{
+	return drawnRanges(area);
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> opt::Level::drawnRanges(const std::optional<sf::FloatRect>& area) const
+{
+	if (m_useOcclusion)
+	{
+		[[maybe_unused]] const std::size_t evaluees{ m_occlusion.resolve(m_beginTileIndex) };
+		OPTTILE_STAT(m_stats.occlusionTests += evaluees);
+	}
+	std::vector<std::pair<std::size_t, std::size_t>> plages;
+	const auto ajouter{ [&](std::size_t i) {
+		if (m_tiles[i]->vertexCount() && !isHidden(i) && !(m_useOcclusion && m_occlusion.occluded(i)))
+			plages.emplace_back(m_beginTileIndex[i], m_tiles[i]->vertexCount());
+	} };
+	if (area && usesCullingGrid())
+	{
+		// La grille ne retourne que les tuiles qui touchent la zone /// The grid only returns the tiles touching the area
+		std::vector<std::size_t> tuiles;
+		m_cullingGrid.query(*area, tuiles);
+		for (std::size_t i : tuiles)
+			ajouter(i);
+	}
+	else
+	{
+		for (std::size_t i{ 0 }; i < m_tiles.size(); ++i)
+			if (!area || area->intersects(m_tiles[i]->getGlobalBounds()))
+				ajouter(i);
+	}
+	std::sort(plages.begin(), plages.end());
+	std::size_t fusionnees{ 0 };
+	for (std::size_t i{ 0 }; i < plages.size(); ++i)
+	{
+		if (fusionnees && plages[fusionnees - 1].first + plages[fusionnees - 1].second == plages[i].first)
+			plages[fusionnees - 1].second += plages[i].second;
+		else
+			plages[fusionnees++] = plages[i];
+	}
+	plages.resize(fusionnees);
+	return plages;
+}
+
+void opt::Level::culling(bool enabled)
+{
+	const bool grille{ usesCullingGrid() };
+	m_culling = enabled;
+	refreshCullingGrid(grille);
+}
+
+bool opt::Level::isOpaque(std::size_t index) const
+{
+	if (isHidden(index))
+		return false;
+	if (index < m_forcedOpacity.size() && m_forcedOpacity[index] != 0)
+		return m_forcedOpacity[index] == 1;
+	const Tile& tuile{ *m_tiles[index] };
+	const int sousTexture{ tuile.subTextureIndex() };
+	return tuile.vertexCount() && tuile.getColour().a == 255 && sousTexture >= 0
+		&& sousTexture < static_cast<int>(m_opaqueSubTextures.size()) && m_opaqueSubTextures[sousTexture];
+}
+
+void opt::Level::refreshOcclusion()
+{
+	m_opaqueSubTextures.assign(m_subTextures.size(), false);
+	const sf::Image image{ m_texture.copyToImage() };
+	const sf::Vector2u taille{ image.getSize() };
+	const sf::Uint8* pixels{ image.getPixelsPtr() };
+	for (std::size_t i{ 0 }; pixels && i < m_subTextures.size(); ++i)
+	{
+		const sf::FloatRect& rectangle{ m_subTextures[i] };
+		const long gauche{ static_cast<long>(std::floor(rectangle.left)) }, haut{ static_cast<long>(std::floor(rectangle.top)) };
+		const long droite{ static_cast<long>(std::ceil(rectangle.left + rectangle.width)) }, bas{ static_cast<long>(std::ceil(rectangle.top + rectangle.height)) };
+		// Une sous-texture qui sort de la texture est rpte ou vide : elle n'est jamais opaque ///
+		// A subtexture going out of the texture is repeated or empty: it is never opaque
+		if (gauche < 0 || haut < 0 || droite > static_cast<long>(taille.x) || bas > static_cast<long>(taille.y) || droite <= gauche || bas <= haut)
+			continue;
+		bool opaque{ true };
+		for (long y{ haut }; opaque && y < bas; ++y)
+			for (long x{ gauche }; opaque && x < droite; ++x)
+				opaque = pixels[(static_cast<std::size_t>(y) * taille.x + static_cast<std::size_t>(x)) * 4 + 3] == 255;
+		m_opaqueSubTextures[i] = opaque;
+	}
+	m_occlusion.clear();
+	for (std::size_t i{ 0 }; i < m_tiles.size(); ++i)
+		m_occlusion.update(i, m_tiles[i]->getGlobalBounds(), isOpaque(i));
+}
+
+void opt::Level::occlusionCulling(bool enabled)
+{
+	if (enabled == m_useOcclusion)
+		return;
+	m_useOcclusion = enabled;
+	if (m_useOcclusion)
+		refreshOcclusion();
+	else
+		m_occlusion.clear();
+}
+
+void opt::Level::setOpaque(bool opaque, std::size_t index)
+{
+	if (m_forcedOpacity.size() <= index)
+		m_forcedOpacity.resize(index + 1, 0);
+	m_forcedOpacity[index] = opaque ? 1 : 2;
+	if (m_useOcclusion)
+		m_occlusion.update(index, m_tiles[index]->getGlobalBounds(), isOpaque(index));
+}
+
+void opt::Level::resetOpaque(std::size_t index)
+{
+	if (index < m_forcedOpacity.size())
+		m_forcedOpacity[index] = 0;
+	if (m_useOcclusion)
+		m_occlusion.update(index, m_tiles[index]->getGlobalBounds(), isOpaque(index));
+}
+
+bool opt::Level::isOccluded(std::size_t index) const
+{
+	if (!m_useOcclusion)
+		return false;
+	[[maybe_unused]] const std::size_t evaluees{ m_occlusion.resolve(m_beginTileIndex) };
+	OPTTILE_STAT(m_stats.occlusionTests += evaluees);
+	return m_occlusion.occluded(index);
+}
+
+void opt::Level::addLayer(const std::string& name)
+{
+	if (!m_layers.active())
+	{
+		// La couche de base reoit les tuiles existantes, dans l'ordre du tampon ///
+		// The base layer receives the existing tiles, in buffer order
+		m_layers.add("base");
+		std::vector<std::size_t> ordre(m_tiles.size());
+		for (std::size_t i{ 0 }; i < ordre.size(); ++i)
+			ordre[i] = i;
+		std::sort(ordre.begin(), ordre.end(), [this](std::size_t a, std::size_t b) { return m_beginTileIndex[a] < m_beginTileIndex[b]; });
+		for (std::size_t index : ordre)
+			m_layers.update(index, uploadSource(m_beginTileIndex[index], tileEnd(index), &index, 1), m_tiles[index]->vertexCount(), m_tiles[index]->bottomLeftCorner().y);
+	}
+	m_layers.add(name);
+}
+
+void opt::Level::setLayer(const std::string& layer, std::size_t index)
+{
+	const std::size_t couche{ m_layers.find(layer) };
+	if (couche == static_cast<std::size_t>(-1) || index >= m_tiles.size())
+		return;
+	m_layers.moveTile(index, couche, uploadSource(m_beginTileIndex[index], tileEnd(index), &index, 1), m_tiles[index]->vertexCount(), m_tiles[index]->bottomLeftCorner().y);
+}
+
+void opt::Level::layerVisible(const std::string& layer, bool visible)
+{
+	const std::size_t couche{ m_layers.find(layer) };
+	if (couche != static_cast<std::size_t>(-1))
+		m_layers.setVisible(couche, visible);
+}
+
+void opt::Level::layerYSorted(const std::string& layer, bool sorted)
+{
+	const std::size_t couche{ m_layers.find(layer) };
+	if (couche != static_cast<std::size_t>(-1))
+		m_layers.setYSorted(couche, sorted);
+}
+
+std::string opt::Level::layerOf(std::size_t index) const
+{
+	const std::size_t couche{ m_layers.layerOf(index) };
+	return couche == static_cast<std::size_t>(-1) ? std::string() : m_layers.name(couche);
+}
+
+bool opt::Level::isHidden(std::size_t index) const
+{
+	return index < m_hidden.size() && m_hidden[index];
+}
+
+const sf::Vertex* opt::Level::uploadSource(std::size_t begin, std::size_t end, const std::size_t* tiles, std::size_t tileCount) const
+{
+	if (!m_hiddenCount)
+		return m_vertexes.data() + begin;
+	m_visibleVertexes.assign(m_vertexes.begin() + begin, m_vertexes.begin() + end);
+	// Sans liste, la plage est le tampon entier : toutes les tuiles sont parcourues ///
+	// Without a list, the range is the whole buffer: every tile is visited
+	const std::size_t nombre{ tiles ? tileCount : m_tiles.size() };
+	for (std::size_t i{ 0 }; i < nombre; ++i)
+	{
+		const std::size_t index{ tiles ? tiles[i] : i };
+		if (isHidden(index))
+			std::fill(m_visibleVertexes.begin() + (m_beginTileIndex[index] - begin), m_visibleVertexes.begin() + (tileEnd(index) - begin), sf::Vertex());
+	}
+	return m_visibleVertexes.data();
+}
+
+void opt::Level::setVisible(std::size_t index, bool visible)
+{
+	setVisible(std::span<const std::size_t>(&index, 1), visible);
+}
+
+void opt::Level::setVisible(std::span<const std::size_t> indexes, bool visible)
+{
+	std::vector<std::size_t> tuiles;
+	for (std::size_t index : indexes)
+	{
+		if (index >= m_tiles.size() || isHidden(index) != visible)
+			continue;
+		if (m_hidden.size() < m_tiles.size())
+			m_hidden.resize(m_tiles.size(), false);
+		m_hidden[index] = !visible;
+		m_hiddenCount = visible ? m_hiddenCount - 1 : m_hiddenCount + 1;
+		if (m_useOcclusion)
+			m_occlusion.update(index, m_tiles[index]->getGlobalBounds(), isOpaque(index));
+		if (m_useInstanced)
+			m_instanced.set(index, instanceOf(*m_tiles[index]));
+		if (m_layers.active())
+			m_layers.update(index, uploadSource(m_beginTileIndex[index], tileEnd(index), &index, 1), m_tiles[index]->vertexCount(), m_tiles[index]->bottomLeftCorner().y);
+		if (m_useStaticCache)
+			m_staticCache.invalidate(m_tiles[index]->getGlobalBounds());
+		tuiles.push_back(index);
+	}
+	if (tuiles.empty())
+		return;
+	m_shownRangesDirty = true;
+	syncTiles(tuiles, false);
+}
+
+bool opt::Level::isVisible(std::size_t index) const
+{
+	return !isHidden(index);
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+///
+/// Tests des fichiers de sous-textures et des atlas générés - Subtexture file and generated atlas tests
+///
+
+#include "unit_tests.h"
+#include "Exceptions.h"
+#include <fstream>
+
+#ifdef OPTTILE_TEST_ATLAS
+// Généré par opttile_atlasgen depuis tests/atlas/test_atlas.txt /// Generated by opttile_atlasgen from tests/atlas/test_atlas.txt
+#include "test_atlas.h"
+
+// Lignes blanches ignorées : quatre lignes non vides, quatre index /// Blank lines skipped: four non-blank lines, four indexes
+static_assert(testatlas::testTileAtlas.size() == 4);
+static_assert(testatlas::testTileAtlas.index(testatlas::TestTile::subTexture2) == 2);
+static_assert(testatlas::testTileAtlas[testatlas::TestTile::cliffTop].height == 48.5f);
+#endif
+
+namespace
+{
+	void write(const std::string& path, const std::string& text)
+	{
+		std::ofstream fichier{ path, std::ios::binary };
+		fichier << text;
+	}
+}
+
+OPTTILE_TEST(subtexture_file_skips_blank_lines)
+{
+	opt::test::TemporaryFile fichier{ "subtextures.txt" };
+	write(fichier.path(), "\n0,0,16,16\r\n\r\n  \t\n16,0,16,8,named\n\n32, 0, 8, 8\n");
+	const std::vector<sf::FloatRect> attendu{ sf::FloatRect(0.f, 0.f, 16.f, 16.f), sf::FloatRect(16.f, 0.f, 16.f, 8.f), sf::FloatRect(32.f, 0.f, 8.f, 8.f) };
+	opt::Level niveau;
+	niveau.loadTexture(sf::Texture(), fichier.path());
+	OPTTILE_CHECK(niveau.getSubTextures() == attendu);
+
+	// Sans fin de ligne finale /// Without a final line end
+	write(fichier.path(), "0,0,16,16\n16,0,16,8");
+	niveau.loadTexture(sf::Texture(), fichier.path());
+	OPTTILE_CHECK(niveau.getSubTextures().size() == 2);
+}
+
+OPTTILE_TEST(subtexture_file_errors)
+{
+	opt::test::TemporaryFile fichier{ "subtextures_bad.txt" };
+	opt::Level niveau;
+	OPTTILE_CHECK_THROWS(niveau.loadTexture(sf::Texture(), fichier.path()), opt::LoadException);
+	write(fichier.path(), "\n \r\n\n");
+	OPTTILE_CHECK_THROWS(niveau.loadTexture(sf::Texture(), fichier.path()), opt::LoadException);
+	write(fichier.path(), "0,0,16,16\n0,0,16\n");
+	OPTTILE_CHECK_THROWS(niveau.loadTexture(sf::Texture(), fichier.path()), opt::ParseException);
+}
+
+#ifdef OPTTILE_TEST_ATLAS
+OPTTILE_TEST(generated_atlas_matches_runtime_parsing)
+{
+	opt::Level lu;
+	lu.loadTexture(sf::Texture(), OPTTILE_TEST_ATLAS);
+	OPTTILE_CHECK(lu.getSubTextures().size() == testatlas::testTileAtlas.size());
+	OPTTILE_CHECK(lu.getSubTextures() == testatlas::testTileAtlas.subTextures());
+
+	opt::Level genere;
+	genere.loadTexture(sf::Texture(), testatlas::testTileAtlas);
+	OPTTILE_CHECK(lu.getSubTextures() == genere.getSubTextures());
+	OPTTILE_CHECK(genere.getSubTexture(testatlas::testTileAtlas.index(testatlas::TestTile::water)) == sf::FloatRect(32.f, 0.f, 32.f, 32.f));
+}
+#endif
@@ -0,0 +1,126 @@
+///
+/// Tests des colonnes d'attributs - Attribute column tests
+///
+
+#include "unit_tests.h"
+#include "AttributeColumns.h"
+#include <cstdint>
+
+namespace
+{
+	struct Health {
+		int current{ 10 };
+		int maximum{ 10 };
+	};
+}
+
+OPTTILE_TEST(columns_grow_with_tiles)
+{
+	opt::AttributeColumns colonnes;
+	colonnes.resize(3);
+	std::span<float> vitesses{ colonnes.add<float>("speed") };
+	OPTTILE_CHECK(vitesses.size() == 3);
+	vitesses[1] = 2.5f;
+
+	// Une colonne existante du même type est gardée /// An existing column of the same type is kept
+	OPTTILE_CHECK(colonnes.add<float>("speed")[1] == 2.5f);
+
+	colonnes.resize(1000);
+	const std::span<float> agrandies{ colonnes.get<float>("speed") };
+	OPTTILE_CHECK(agrandies.size() == 1000);
+	OPTTILE_CHECK(agrandies[1] == 2.5f && agrandies[999] == 0.f);
+
+	// Une colonne ajoutée plus tard reçoit des valeurs par défaut pour les tuiles existantes ///
+	// A column added later receives default values for the existing tiles
+	const std::span<Health> vies{ colonnes.add<Health>("health") };
+	OPTTILE_CHECK(vies.size() == 1000 && vies[500].current == 10);
+
+	colonnes.resize(2);
+	OPTTILE_CHECK(colonnes.get<float>("speed").size() == 2);
+	OPTTILE_CHECK(colonnes.get<Health>("health").size() == 2);
+	colonnes.remove("speed");
+	OPTTILE_CHECK(!colonnes.contains("speed") && colonnes.contains("health"));
+	OPTTILE_CHECK(colonnes.get<float>("speed").empty());
+}
+
+OPTTILE_TEST(columns_type_mismatch)
+{
+	opt::AttributeColumns colonnes;
+	colonnes.resize(4);
+	colonnes.add<std::uint8_t>("solid")[2] = 1;
+
+	// Un autre type donne une vue vide, sans toucher la colonne /// Another type gives an empty view, without touching the column
+	OPTTILE_CHECK(colonnes.get<int>("solid").empty());
+	OPTTILE_CHECK(colonnes.add<int>("solid").empty());
+	const opt::AttributeColumns& constantes{ colonnes };
+	OPTTILE_CHECK(constantes.get<float>("solid").empty());
+	OPTTILE_CHECK(constantes.get<std::uint8_t>("solid").size() == 4);
+	OPTTILE_CHECK(constantes.get<std::uint8_t>("solid")[2] == 1);
+	OPTTILE_CHECK(colonnes.get<int>("missing").empty());
+	OPTTILE_CHECK(!colonnes.contains("missing"));
+}
+
+OPTTILE_TEST(columns_append)
+{
+	opt::AttributeColumns source;
+	source.resize(3);
+	std::span<int> valeurs{ source.add<int>("owner") };
+	valeurs[0] = 7;
+	valeurs[1] = 8;
+	valeurs[2] = 9;
+	source.add<float>("mismatch")[0] = 1.f;
+	source.add<int>("source only");
+
+	opt::AttributeColumns cible;
+	cible.resize(1);
+	cible.add<int>("owner")[0] = 1;
+	cible.add<int>("mismatch")[0] = 4;
+	cible.add<Health>("target only")[0].current = 3;
+
+	// Les deux premières tuiles seulement /// Only the two first tiles
+	cible.append(source, 2);
+	const std::span<int> proprietaires{ cible.get<int>("owner") };
+	OPTTILE_CHECK(proprietaires.size() == 3);
+	OPTTILE_CHECK(proprietaires[0] == 1 && proprietaires[1] == 7 && proprietaires[2] == 8);
+	// Type différent ou colonne absente : valeurs par défaut /// Different type or missing column: default values
+	OPTTILE_CHECK(cible.get<int>("mismatch").size() == 3 && cible.get<int>("mismatch")[0] == 4 && cible.get<int>("mismatch")[1] == 0);
+	OPTTILE_CHECK(cible.get<Health>("target only").size() == 3 && cible.get<Health>("target only")[0].current == 3);
+	OPTTILE_CHECK(cible.get<Health>("target only")[2].current == 10);
+	// Les colonnes propres à la source ne sont pas créées /// Columns belonging only to the source are not created
+	OPTTILE_CHECK(!cible.contains("source only"));
+
+	// La table elle-même, assez grande pour forcer une réallocation /// The table itself, big enough to force a reallocation
+	for (int i{ 0 }; i < 6; ++i)
+		source.append(source, source.get<int>("owner").size());
+	const std::span<int> doublees{ source.get<int>("owner") };
+	OPTTILE_CHECK(doublees.size() == 3 * 64);
+	bool identiques{ true };
+	for (std::size_t i{ 0 }; i < doublees.size(); ++i)
+		identiques = identiques && doublees[i] == 7 + static_cast<int>(i % 3);
+	OPTTILE_CHECK(identiques);
+	OPTTILE_CHECK(source.get<float>("mismatch").size() == 3 * 64 && source.get<float>("mismatch")[3] == 1.f);
+}
+
+OPTTILE_TEST(columns_follow_level_changes)
+{
+	opt::Level niveau;
+	opt::test::prepare(niveau);
+	niveau.add(opt::test::grid(4, 4));
+	std::span<int> numeros{ niveau.addColumn<int>("id") };
+	OPTTILE_CHECK(numeros.size() == 16);
+	for (std::size_t i{ 0 }; i < numeros.size(); ++i)
+		numeros[i] = static_cast<int>(i);
+
+	niveau.add(opt::test::grid(2, 1));
+	OPTTILE_CHECK(niveau.column<int>("id").size() == 18 && niveau.column<int>("id")[17] == 0);
+	OPTTILE_CHECK(niveau.column<float>("id").empty());
+
+	// Le niveau ajouté à lui-même copie aussi ses colonnes /// The level appended to itself copies its columns too
+	niveau.append(niveau, sf::Vector2f(1000.f, 0.f));
+	const std::span<int> copies{ niveau.column<int>("id") };
+	OPTTILE_CHECK(copies.size() == 36);
+	OPTTILE_CHECK(copies[18] == 0 && copies[18 + 15] == 15 && copies[35] == 0);
+
+	niveau.removeColumn("id");
+	OPTTILE_CHECK(niveau.column<int>("id").empty());
+}
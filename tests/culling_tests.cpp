@@ -0,0 +1,134 @@
+///
+/// Tests de l'élimination hors de la vue et du rangement des sommets - Culling and vertex layout tests
+///
+
+#include "unit_tests.h"
+
+namespace
+{
+	using Ranges = std::vector<std::pair<std::size_t, std::size_t>>;
+
+	/// <summary>
+	/// Plages obtenues par la grille, puis par le parcours de tout le niveau ///
+	/// Ranges obtained through the grid, then by going through the whole level
+	/// </summary>
+	bool sameRanges(opt::Level& level, const sf::FloatRect& area)
+	{
+		level.culling(true);
+		const Ranges grille{ level.vertexRanges(area) };
+		level.culling(false);
+		const Ranges parcours{ level.vertexRanges(area) };
+		level.culling(true);
+		return grille == parcours;
+	}
+
+	const sf::FloatRect areas[]{
+		sf::FloatRect(0.f, 0.f, 100.f, 100.f),
+		sf::FloatRect(-50.f, 130.f, 600.f, 35.f),
+		sf::FloatRect(390.f, 390.f, 1.f, 1.f),
+		sf::FloatRect(-1e6f, -1e6f, 2e6f, 2e6f),
+		sf::FloatRect(5000.f, 5000.f, 10.f, 10.f)
+	};
+
+	/// <summary>
+	/// Compare les sommets de chaque tuile, où qu'ils soient rangés dans le tampon ///
+	/// Compares the vertexes of each tile, wherever they are stored inside the buffer
+	/// </summary>
+	bool sameTileVertexes(opt::Level& expected, opt::Level& obtained)
+	{
+		if (expected.size() != obtained.size() || expected.vertices().size() != obtained.vertices().size())
+			return false;
+		for (std::size_t i{ 0 }; i < expected.size(); ++i)
+		{
+			const std::size_t nombre{ expected[static_cast<int>(i)].vertexCount() };
+			if (obtained[static_cast<int>(i)].vertexCount() != nombre)
+				return false;
+			const auto debutAttendu{ expected.vertices().begin() + expected.beginTileIndexes()[i] };
+			const auto debutObtenu{ obtained.vertices().begin() + obtained.beginTileIndexes()[i] };
+			if (!opt::test::sameVertexes(std::vector<sf::Vertex>(debutAttendu, debutAttendu + nombre), std::vector<sf::Vertex>(debutObtenu, debutObtenu + nombre)))
+				return false;
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Change le nombre de sommets de quelques tuiles, dont la première et la dernière ///
+	/// Changes the vertex count of a few tiles, including the first and the last one
+	/// </summary>
+	void resizeSome(opt::Level& level)
+	{
+		const std::size_t derniere{ level.size() - 1 };
+		for (std::size_t index : { std::size_t{ 0 }, std::size_t{ 7 }, std::size_t{ 55 }, derniere })
+			level.resize(120.f, 80.f, index);
+		level.resize(40.f, 40.f, 7);
+	}
+}
+
+OPTTILE_TEST(culling_grid_matches_full_scan)
+{
+	opt::Level level;
+	opt::test::prepare(level);
+	const std::vector<opt::TileRecord> tuiles{ opt::test::grid(30, 30) };
+	level.add(tuiles);
+	level.culling(true);
+	for (const sf::FloatRect& zone : areas)
+		OPTTILE_CHECK(sameRanges(level, zone));
+
+	// Déplacements, tuiles cachées, ajouts et retraits doivent suivre dans la grille ///
+	// Moves, hidden tiles, additions and removals must follow inside the grid
+	const opt::LevelSnapshot photo{ level.snapshot() };
+	level.move(700.f, 3.f, 12);
+	level.setPosition(4990.f, 4990.f, 31);
+	level.resize(300.f, 40.f, 64);
+	level.setVisible(65, false);
+	level.add(sf::Vector2f(40.f, 40.f), sf::Vector2f(20.f, 20.f), 1, opt::TextureRule::repeat_texture);
+	for (const sf::FloatRect& zone : areas)
+		OPTTILE_CHECK(sameRanges(level, zone));
+	OPTTILE_CHECK(!level.vertexRanges(sf::FloatRect(5000.f, 5000.f, 10.f, 10.f)).empty());
+
+	level.restore(photo);
+	for (const sf::FloatRect& zone : areas)
+		OPTTILE_CHECK(sameRanges(level, zone));
+	OPTTILE_CHECK(level.vertexRanges(sf::FloatRect(5000.f, 5000.f, 10.f, 10.f)).empty());
+}
+
+OPTTILE_TEST(layout_shift_in_index_order)
+{
+	opt::Level attendu, obtenu;
+	opt::test::prepare(attendu);
+	opt::test::prepare(obtenu);
+	const std::vector<opt::TileRecord> tuiles{ opt::test::grid(12, 12) };
+	attendu.add(tuiles);
+	obtenu.add(tuiles);
+	resizeSome(obtenu);
+
+	// Sans rangement, le tampon suit l'ordre des index : il doit être celui d'un niveau construit d'un coup ///
+	// Without layout, the buffer follows index order: it must be the one of a level built at once
+	attendu.resetTiles();
+	attendu.add(obtenu.records());
+	OPTTILE_CHECK(opt::test::sameLevel(attendu, obtenu));
+	for (std::size_t i{ 1 }; i < obtenu.size(); ++i)
+		OPTTILE_CHECK(obtenu.beginTileIndexes()[i] == obtenu.beginTileIndexes()[i - 1] + obtenu[static_cast<int>(i) - 1].vertexCount());
+}
+
+OPTTILE_TEST(layout_shift_after_optimize)
+{
+	opt::Level attendu, obtenu;
+	opt::test::prepare(attendu);
+	opt::test::prepare(obtenu);
+	const std::vector<opt::TileRecord> tuiles{ opt::test::grid(12, 12) };
+	attendu.add(tuiles);
+	obtenu.add(tuiles);
+	obtenu.optimizeLayout();
+	resizeSome(attendu);
+	resizeSome(obtenu);
+	OPTTILE_CHECK(sameTileVertexes(attendu, obtenu));
+
+	// Une photo rangée selon Morton garde le décalage complet après restore ///
+	// A snapshot laid out along Morton keeps the full shift after restore
+	const opt::LevelSnapshot photo{ obtenu.snapshot() };
+	obtenu.restore(photo);
+	obtenu.resize(200.f, 200.f, 3);
+	attendu.resize(200.f, 200.f, 3);
+	OPTTILE_CHECK(sameTileVertexes(attendu, obtenu));
+}
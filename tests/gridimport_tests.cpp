@@ -0,0 +1,136 @@
+///
+/// Tests de la lecture de grilles CSV - CSV grid import tests
+///
+
+#include "unit_tests.h"
+#include "Exceptions.h"
+#include "GridImport.h"
+#include <fstream>
+
+namespace
+{
+	const sf::Vector2f cell{ 16.f, 8.f };
+
+	std::vector<opt::TileRecord> parse(const std::string& text, unsigned threads, opt::GridImportOptions options = opt::GridImportOptions())
+	{
+		options.threads = threads;
+		return opt::GridImport::parse(text.data(), text.data() + text.size(), cell, options);
+	}
+
+	opt::TileRecord record(std::size_t column, std::size_t row, int id)
+	{
+		opt::TileRecord tuile;
+		tuile.rect = sf::FloatRect(static_cast<float>(column) * cell.x, static_cast<float>(row) * cell.y, cell.x, cell.y);
+		tuile.subTexture = id;
+		return tuile;
+	}
+
+	/// <summary>
+	/// Grille de rows rangées avec des cellules vides, des blancs, des rangées vides et des fins de ligne CRLF ///
+	/// Grid of rows rows with empty cells, blanks, empty rows and CRLF line ends
+	/// </summary>
+	std::string messyGrid(std::size_t rows, std::vector<opt::TileRecord>& expected)
+	{
+		std::string texte;
+		for (std::size_t rangee{ 0 }; rangee < rows; ++rangee)
+		{
+			if (rangee % 7 != 3)
+				for (std::size_t colonne{ 0 }; colonne < 5; ++colonne)
+				{
+					const std::size_t graine{ rangee * 5 + colonne };
+					if (colonne)
+						texte += ',';
+					if (graine % 4 == 1)
+						texte += graine % 8 == 1 ? "" : " ";
+					else
+					{
+						const int identifiant{ static_cast<int>(graine % 13) };
+						texte += (graine % 3 ? "" : " ") + std::to_string(identifiant) + (graine % 5 ? "" : "\t");
+						expected.push_back(record(colonne, rangee, identifiant));
+					}
+				}
+			texte += rangee % 2 ? "\r\n" : "\n";
+		}
+		return texte;
+	}
+}
+
+OPTTILE_TEST(grid_import_cells)
+{
+	// Marque d'ordre des octets, CRLF, cellules vides ou blanches, pas de fin de ligne finale ///
+	// Byte order mark, CRLF, empty or blank cells, no final line end
+	const std::string texte{ "\xEF\xBB\xBF" "1,2,3\r\n4,,5\r\n , 6 ,\r\n\r\n7" };
+	const std::vector<opt::TileRecord> attendu{
+		record(0, 0, 1), record(1, 0, 2), record(2, 0, 3),
+		record(0, 1, 4), record(2, 1, 5),
+		record(1, 2, 6),
+		record(0, 4, 7) };
+	OPTTILE_CHECK(opt::test::sameRecords(attendu, parse(texte, 1)));
+	OPTTILE_CHECK(opt::test::sameRecords(attendu, parse(texte, 4)));
+
+	OPTTILE_CHECK(parse("", 1).empty());
+	OPTTILE_CHECK(parse("\xEF\xBB\xBF", 1).empty());
+	OPTTILE_CHECK(parse("\n\n\r\n", 3).empty());
+}
+
+OPTTILE_TEST(grid_import_options)
+{
+	opt::GridImportOptions options;
+	options.idOffset = -1;
+	options.emptyId = -1;
+	options.separator = ';';
+	options.origin = sf::Vector2f(100.f, -50.f);
+	options.textureRule = opt::TextureRule::keep_size;
+	// Identifiants commençant à 1, 0 pour vide /// Ids starting at 1, 0 for empty
+	const std::vector<opt::TileRecord> tuiles{ parse("0;3;1\n2;0;0\n", 2, options) };
+	OPTTILE_CHECK(tuiles.size() == 3);
+	OPTTILE_CHECK(tuiles[0].subTexture == 2 && tuiles[1].subTexture == 0 && tuiles[2].subTexture == 1);
+	OPTTILE_CHECK(tuiles[0].rect == sf::FloatRect(100.f + cell.x, -50.f, cell.x, cell.y));
+	OPTTILE_CHECK(tuiles[2].rect == sf::FloatRect(100.f, -50.f + cell.y, cell.x, cell.y));
+	OPTTILE_CHECK(tuiles[1].textureRule == opt::TextureRule::keep_size);
+
+	// Un identifiant vide explicite, sans décalage /// An explicit empty id, without offset
+	options = opt::GridImportOptions();
+	options.emptyId = 9;
+	OPTTILE_CHECK(parse("9,-1,9", 1, options).size() == 1);
+	OPTTILE_CHECK(parse("9,-1,9", 1, options)[0].subTexture == -1);
+}
+
+OPTTILE_TEST(grid_import_blocks_keep_row_numbers)
+{
+	std::vector<opt::TileRecord> attendu;
+	const std::string texte{ messyGrid(200, attendu) };
+	OPTTILE_CHECK(opt::test::sameRecords(attendu, parse(texte, 1)));
+	// Plus de fils que de rangées, et des nombres de blocs qui coupent près des CRLF ///
+	// More threads than rows, and block counts cutting near the CRLF
+	for (unsigned fils : { 2u, 3u, 7u, 16u, 64u, 500u })
+		OPTTILE_CHECK(opt::test::sameRecords(attendu, parse(texte, fils)));
+	// Automatique : un seul bloc pour un petit texte /// Automatic: a single block for a small text
+	OPTTILE_CHECK(opt::test::sameRecords(attendu, parse(texte, 0)));
+}
+
+OPTTILE_TEST(grid_import_errors)
+{
+	OPTTILE_CHECK_THROWS(parse("1,2\n3,x\n", 1), opt::ParseException);
+	OPTTILE_CHECK_THROWS(parse("1,2\n3,4 5\n", 1), opt::ParseException);
+	// L'erreur d'un bloc autre que le premier remonte aussi /// The error of a block other than the first one comes up too
+	std::vector<opt::TileRecord> attendu;
+	const std::string texte{ messyGrid(100, attendu) + "1,2,oops\n" };
+	OPTTILE_CHECK_THROWS(parse(texte, 8), opt::ParseException);
+	try
+	{
+		parse(texte, 8);
+	}
+	catch (const opt::ParseException& erreur)
+	{
+		OPTTILE_CHECK(std::string(erreur.showMessage()).find("row 100, column 2") != std::string::npos);
+	}
+
+	opt::test::TemporaryFile fichier{ "grid.csv" };
+	{
+		std::ofstream sortie{ fichier.path(), std::ios::binary };
+		sortie << "5,6\n7,8\n";
+	}
+	OPTTILE_CHECK(opt::GridImport::read(fichier.path(), cell).size() == 4);
+	OPTTILE_CHECK_THROWS(opt::GridImport::read(fichier.path() + ".missing", cell), opt::LoadException);
+}
@@ -0,0 +1,98 @@
+///
+/// Tests du journal des tuiles - Tile journal tests
+///
+
+#include "unit_tests.h"
+
+namespace
+{
+	void build(opt::Level& level)
+	{
+		opt::test::prepare(level);
+		const std::vector<opt::TileRecord> tuiles{ opt::test::grid(20, 20) };
+		level.add(tuiles);
+	}
+
+	/// <summary>
+	/// Modifie quelques tuiles de toutes les façons journalisées, dont une deux fois, puis ajoute une tuile ///
+	/// Modifies a few tiles in every journaled way, one of them twice, then adds a tile
+	/// </summary>
+	void mutate(opt::Level& level, float offset)
+	{
+		level.move(offset, 0.f, 3);
+		level.move(0.f, offset, 3);
+		level.resize(80.f, 40.f, 17);
+		level.changeTextureRect(4, 42);
+		level.changeColour(sf::Color(10, 20, 30, 200), 150);
+		level.setPosition(offset * 2.f, 1000.f, 399);
+		level.add(sf::Vector2f(40.f, 40.f), sf::Vector2f(offset, -200.f), 2, opt::TextureRule::keep_size);
+	}
+
+	bool reloadsIdentically(opt::Level& level, const std::string& path)
+	{
+		opt::Level relu;
+		opt::test::prepare(relu);
+		relu.load(path);
+		return opt::test::sameLevel(level, relu);
+	}
+}
+
+OPTTILE_TEST(journal_replays_appended_changes)
+{
+	const opt::test::TemporaryFile fichier{ "journal_tests_single.optl" };
+	opt::Level level;
+	build(level);
+	level.save(fichier.path());
+	level.journal(true);
+
+	mutate(level, 8.f);
+	// La tuile 3 déplacée deux fois ne compte qu'une fois /// Tile 3 moved twice only counts once
+	OPTTILE_CHECK(level.journalSize() == 6);
+	level.saveJournal(fichier.path());
+	OPTTILE_CHECK(level.journalSize() == 0);
+	OPTTILE_CHECK(reloadsIdentically(level, fichier.path()));
+}
+
+OPTTILE_TEST(journal_replays_several_blocks)
+{
+	const opt::test::TemporaryFile fichier{ "journal_tests_blocks.optl" };
+	opt::Level level;
+	build(level);
+	level.save(fichier.path(), opt::LevelFile::Encoding::raw);
+	level.journal(true);
+
+	for (int bloc{ 1 }; bloc <= 3; ++bloc)
+	{
+		mutate(level, 8.f * bloc);
+		level.saveJournal(fichier.path());
+		OPTTILE_CHECK(reloadsIdentically(level, fichier.path()));
+	}
+	// Un journal vide n'ajoute rien au fichier /// An empty journal adds nothing to the file
+	level.saveJournal(fichier.path());
+	OPTTILE_CHECK(reloadsIdentically(level, fichier.path()));
+	OPTTILE_CHECK(level.size() == 403);
+}
+
+OPTTILE_TEST(journal_rewrites_file_after_reset)
+{
+	const opt::test::TemporaryFile fichier{ "journal_tests_reset.optl" };
+	opt::Level level;
+	build(level);
+	const opt::LevelSnapshot photo{ level.snapshot() };
+	level.save(fichier.path());
+	level.journal(true);
+
+	mutate(level, 8.f);
+	// Le retrait des tuiles ajoutées ne s'écrit pas dans un journal : le fichier entier est réécrit ///
+	// Removing the added tiles cannot be written in a journal: the whole file is written again
+	level.restore(photo);
+	level.move(4.f, 4.f, 9);
+	level.saveJournal(fichier.path());
+	OPTTILE_CHECK(level.size() == 400);
+	OPTTILE_CHECK(reloadsIdentically(level, fichier.path()));
+
+	// Le journal repart ensuite du fichier réécrit /// The journal then starts again from the rewritten file
+	mutate(level, 12.f);
+	level.saveJournal(fichier.path());
+	OPTTILE_CHECK(reloadsIdentically(level, fichier.path()));
+}
@@ -0,0 +1,255 @@
+///
+/// Tests des couches - Layer tests
+///
+
+#include "unit_tests.h"
+#include <algorithm>
+
+namespace
+{
+	constexpr std::size_t quad{ 6 };
+
+	/// <summary>
+	/// Sommets d'une tuile : x identifie la tuile, y est sa clé de tri ///
+	/// Vertexes of a tile: x identifies the tile, y is its sort key
+	/// </summary>
+	std::vector<sf::Vertex> tile(std::size_t index, float key, std::size_t count = quad)
+	{
+		return std::vector<sf::Vertex>(count, sf::Vertex(sf::Vector2f(static_cast<float>(index + 1) * 10.f, key)));
+	}
+
+	void update(opt::LayerStack& layers, std::size_t index, float key, std::size_t count = quad)
+	{
+		const std::vector<sf::Vertex> sommets{ tile(index, key, count) };
+		layers.update(index, sommets.data(), sommets.size(), key);
+	}
+
+	void move(opt::LayerStack& layers, std::size_t index, std::size_t layer, float key)
+	{
+		const std::vector<sf::Vertex> sommets{ tile(index, key) };
+		layers.moveTile(index, layer, sommets.data(), sommets.size(), key);
+	}
+
+	/// <summary>
+	/// Tuiles d'une couche dans l'ordre de dessin, trous ignorés ///
+	/// Tiles of a layer in draw order, holes skipped
+	/// </summary>
+	std::vector<std::size_t> order(const opt::LayerStack& layers, std::size_t layer)
+	{
+		std::vector<std::size_t> tuiles;
+		float precedente{ 0.f };
+		for (const sf::Vertex& sommet : layers.vertexes(layer))
+		{
+			if (sommet.position.x != precedente && sommet.position.x != 0.f)
+				tuiles.push_back(static_cast<std::size_t>(sommet.position.x / 10.f) - 1);
+			precedente = sommet.position.x;
+		}
+		return tuiles;
+	}
+
+	std::size_t holes(const opt::LayerStack& layers, std::size_t layer)
+	{
+		const std::vector<sf::Vertex>& sommets{ layers.vertexes(layer) };
+		return static_cast<std::size_t>(std::count_if(sommets.begin(), sommets.end(), [](const sf::Vertex& sommet) { return sommet.position.x == 0.f; }));
+	}
+
+	/// <summary>
+	/// Dessine et retourne le nombre de sommets téléversés ///
+	/// Draws and returns the number of uploaded vertexes
+	/// </summary>
+	std::size_t drawUploads(opt::LayerStack& layers, sf::RenderTarget& target, std::size_t* calls = nullptr)
+	{
+		std::size_t soumis{ 0 };
+		const std::size_t appels{ layers.draw(target, sf::RenderStates::Default, soumis) };
+		if (calls)
+			*calls = appels;
+		return layers.takeUploadedBytes() / sizeof(sf::Vertex);
+	}
+
+	bool sortedByKey(const opt::LayerStack& layers, std::size_t layer)
+	{
+		const std::vector<sf::Vertex>& sommets{ layers.vertexes(layer) };
+		float precedente{ -1e9f };
+		for (const sf::Vertex& sommet : sommets)
+		{
+			if (sommet.position.x == 0.f)
+				continue;
+			if (sommet.position.y < precedente)
+				return false;
+			precedente = sommet.position.y;
+		}
+		return true;
+	}
+}
+
+OPTTILE_TEST(layer_stack_places_and_compacts)
+{
+	opt::LayerStack couches;
+	OPTTILE_CHECK(!couches.active());
+	const std::size_t base{ couches.add("base") }, dessus{ couches.add("top") };
+	OPTTILE_CHECK(couches.active());
+	OPTTILE_CHECK(couches.add("top") == dessus);
+	OPTTILE_CHECK(couches.find("top") == dessus);
+	OPTTILE_CHECK(couches.find("none") == static_cast<std::size_t>(-1));
+
+	// Une tuile sans couche va dans la couche 0 /// A tile without layer goes into the layer 0
+	for (std::size_t i{ 0 }; i < 4; ++i)
+		update(couches, i, static_cast<float>(i));
+	OPTTILE_CHECK((order(couches, base) == std::vector<std::size_t>{ 0, 1, 2, 3 }));
+	OPTTILE_CHECK(couches.layerOf(2) == base);
+
+	// Le premier départ laisse un trou à sa place /// The first departure leaves a hole at its place
+	move(couches, 1, dessus, 1.f);
+	OPTTILE_CHECK(couches.vertexes(base).size() == 4 * quad);
+	OPTTILE_CHECK(holes(couches, base) == quad);
+	OPTTILE_CHECK(couches.vertexes(base)[quad].position == sf::Vector2f());
+	OPTTILE_CHECK((order(couches, base) == std::vector<std::size_t>{ 0, 2, 3 }));
+	OPTTILE_CHECK((order(couches, dessus) == std::vector<std::size_t>{ 1 }));
+	OPTTILE_CHECK(couches.layerOf(1) == dessus);
+
+	// Moitié de trous : pas encore compactée /// Half of holes: not compacted yet
+	move(couches, 3, dessus, 3.f);
+	OPTTILE_CHECK(couches.vertexes(base).size() == 4 * quad);
+	OPTTILE_CHECK(holes(couches, base) == 2 * quad);
+
+	// Plus de la moitié : la couche est compactée /// More than half: the layer is compacted
+	move(couches, 0, dessus, 0.f);
+	OPTTILE_CHECK(couches.vertexes(base).size() == quad);
+	OPTTILE_CHECK(holes(couches, base) == 0);
+	OPTTILE_CHECK((order(couches, base) == std::vector<std::size_t>{ 2 }));
+	OPTTILE_CHECK((order(couches, dessus) == std::vector<std::size_t>{ 1, 3, 0 }));
+
+	// La tuile restante est toujours modifiable après le compactage /// The remaining tile is still modifiable after compaction
+	update(couches, 2, 7.f, 2 * quad);
+	OPTTILE_CHECK(couches.vertexes(base).size() == 2 * quad);
+	OPTTILE_CHECK(couches.vertexes(base).back().position.y == 7.f);
+
+	// Un changement du nombre de sommets décale la suite de la couche /// A vertex count change shifts the rest of the layer
+	update(couches, 1, 1.f, 3 * quad);
+	OPTTILE_CHECK((order(couches, dessus) == std::vector<std::size_t>{ 1, 3, 0 }));
+	OPTTILE_CHECK(couches.vertexes(dessus).size() == 5 * quad);
+	update(couches, 3, 9.f);
+	OPTTILE_CHECK(couches.vertexes(dessus)[3 * quad].position == sf::Vector2f(40.f, 9.f));
+
+	couches.truncate(2);
+	OPTTILE_CHECK((order(couches, dessus) == std::vector<std::size_t>{ 1, 0 }));
+	OPTTILE_CHECK(couches.layerOf(3) == static_cast<std::size_t>(-1));
+	couches.clearTiles();
+	OPTTILE_CHECK(couches.vertexes(base).empty() && couches.vertexes(dessus).empty());
+	OPTTILE_CHECK(couches.add("top") == dessus);
+}
+
+OPTTILE_TEST(layer_stack_hidden_layer_keeps_changes)
+{
+	opt::LayerStack couches;
+	const std::size_t base{ couches.add("base") }, dessus{ couches.add("top") };
+	for (std::size_t i{ 0 }; i < 3; ++i)
+		update(couches, i, 0.f);
+	for (std::size_t i{ 3 }; i < 6; ++i)
+		move(couches, i, dessus, 0.f);
+	sf::RenderTexture cible;
+	OPTTILE_CHECK(cible.create(16, 16));
+
+	std::size_t appels{ 0 };
+	OPTTILE_CHECK(drawUploads(couches, cible, &appels) == 6 * quad);
+	OPTTILE_CHECK(appels == 2);
+
+	couches.setVisible(dessus, false);
+	OPTTILE_CHECK(!couches.isVisible(dessus) && couches.isVisible(base));
+	update(couches, 4, 5.f);
+	OPTTILE_CHECK(drawUploads(couches, cible, &appels) == 0);
+	OPTTILE_CHECK(appels == 1);
+
+	// Montrée de nouveau, la couche téléverse la modification gardée /// Shown again, the layer uploads the kept change
+	couches.setVisible(dessus, true);
+	OPTTILE_CHECK(drawUploads(couches, cible, &appels) == quad);
+	OPTTILE_CHECK(appels == 2);
+	OPTTILE_CHECK(couches.vertexes(dessus)[quad].position.y == 5.f);
+}
+
+OPTTILE_TEST(layer_stack_uploads_only_dirty_ranges)
+{
+	opt::LayerStack couches;
+	const std::size_t base{ couches.add("base") }, dessus{ couches.add("top") };
+	for (std::size_t i{ 0 }; i < 4; ++i)
+		update(couches, i, 0.f);
+	// Trois tuiles : le tampon du dessus peut en contenir quatre /// Three tiles: the top buffer can hold four
+	for (std::size_t i{ 4 }; i < 7; ++i)
+		move(couches, i, dessus, 0.f);
+	sf::RenderTexture cible;
+	OPTTILE_CHECK(cible.create(16, 16));
+	OPTTILE_CHECK(drawUploads(couches, cible) == 7 * quad);
+	OPTTILE_CHECK(drawUploads(couches, cible) == 0);
+
+	update(couches, 2, 3.f);
+	OPTTILE_CHECK(drawUploads(couches, cible) == quad);
+
+	// Le trou laissé dans la base et la nouvelle place au bout du dessus /// The hole left in the base and the new place at the end of the top
+	move(couches, 1, dessus, 0.f);
+	OPTTILE_CHECK(drawUploads(couches, cible) == 2 * quad);
+	OPTTILE_CHECK((order(couches, dessus) == std::vector<std::size_t>{ 4, 5, 6, 1 }));
+
+	// Le dessus est plein : la tuile suivante recrée son tampon /// The top is full: the next tile recreates its buffer
+	move(couches, 3, dessus, 0.f);
+	OPTTILE_CHECK(drawUploads(couches, cible) == quad + 5 * quad);
+	// Capacité doublée de 4 à 8 tuiles /// Capacity doubled from 4 to 8 tiles
+	OPTTILE_CHECK(couches.gpuBytes() == (4 + 8) * quad * sizeof(sf::Vertex));
+	OPTTILE_CHECK((order(couches, base) == std::vector<std::size_t>{ 0, 2 }));
+}
+
+OPTTILE_TEST(layer_stack_y_sorted_repair)
+{
+	opt::LayerStack couches;
+	const std::size_t base{ couches.add("base") }, tri{ couches.add("sorted") };
+	const float cles[]{ 50.f, 10.f, 40.f, 20.f, 30.f, 60.f };
+	for (std::size_t i{ 0 }; i < 6; ++i)
+		move(couches, i, tri, cles[i]);
+
+	// L'activation trie une fois /// Enabling sorts once
+	couches.setYSorted(tri, true);
+	OPTTILE_CHECK(couches.isYSorted(tri) && !couches.isYSorted(base));
+	OPTTILE_CHECK((order(couches, tri) == std::vector<std::size_t>{ 1, 3, 4, 2, 0, 5 }));
+
+	sf::RenderTexture cible;
+	OPTTILE_CHECK(cible.create(16, 16));
+	OPTTILE_CHECK(drawUploads(couches, cible) == 6 * quad);
+
+	// Passe une seule voisine : seuls les deux emplacements échangés sont téléversés ///
+	// Goes past a single neighbour: only the two swapped slots are uploaded
+	update(couches, 3, 35.f);
+	OPTTILE_CHECK((order(couches, tri) == std::vector<std::size_t>{ 1, 4, 3, 2, 0, 5 }));
+	OPTTILE_CHECK(drawUploads(couches, cible) == 2 * quad);
+
+	// Vers le début, par-dessus plusieurs voisines /// Towards the beginning, past several neighbours
+	update(couches, 5, 5.f);
+	OPTTILE_CHECK((order(couches, tri) == std::vector<std::size_t>{ 5, 1, 4, 3, 2, 0 }));
+	OPTTILE_CHECK(drawUploads(couches, cible) == 6 * quad);
+
+	// Une clé égale ne déplace pas la tuile /// An equal key does not move the tile
+	update(couches, 2, 35.f);
+	OPTTILE_CHECK((order(couches, tri) == std::vector<std::size_t>{ 5, 1, 4, 3, 2, 0 }));
+	OPTTILE_CHECK(drawUploads(couches, cible) == quad);
+
+	// Un trou laissé par un départ est franchi par la réparation /// A hole left by a departure is crossed by the repair
+	move(couches, 4, base, 0.f);
+	OPTTILE_CHECK(holes(couches, tri) == quad);
+	update(couches, 0, 15.f);
+	OPTTILE_CHECK((order(couches, tri) == std::vector<std::size_t>{ 5, 1, 0, 3, 2 }));
+	OPTTILE_CHECK(sortedByKey(couches, tri));
+	update(couches, 1, 100.f);
+	OPTTILE_CHECK((order(couches, tri) == std::vector<std::size_t>{ 5, 0, 3, 2, 1 }));
+	OPTTILE_CHECK(couches.vertexes(tri).back().position == sf::Vector2f(20.f, 100.f));
+
+	// Une arrivée dans une couche triée prend sa place, pas la fin /// An arrival in a sorted layer takes its place, not the end
+	move(couches, 4, tri, 36.f);
+	OPTTILE_CHECK((order(couches, tri) == std::vector<std::size_t>{ 5, 0, 3, 2, 4, 1 }));
+	OPTTILE_CHECK(sortedByKey(couches, tri));
+	OPTTILE_CHECK(couches.layerOf(4) == tri);
+
+	// Un changement du nombre de sommets garde l'ordre et les sommets de chaque tuile /// A vertex count change keeps the order and the vertexes of each tile
+	update(couches, 3, 37.f, 2 * quad);
+	OPTTILE_CHECK((order(couches, tri) == std::vector<std::size_t>{ 5, 0, 2, 4, 3, 1 }));
+	OPTTILE_CHECK(sortedByKey(couches, tri));
+	const std::vector<sf::Vertex>& sommets{ couches.vertexes(tri) };
+	OPTTILE_CHECK(std::count_if(sommets.begin(), sommets.end(), [](const sf::Vertex& sommet) { return sommet.position == sf::Vector2f(40.f, 37.f); }) == 2 * quad);
+}
@@ -0,0 +1,167 @@
+///
+/// Tests de la construction répartie sur plusieurs images - Level builder tests
+///
+
+#include "unit_tests.h"
+#include "Exceptions.h"
+#include "LevelBuilder.h"
+
+namespace
+{
+	/// <summary>
+	/// Avance la construction par petites tranches jusqu'à la fin ///
+	/// Moves the construction forward by small slices until the end
+	/// </summary>
+	/// <returns>Nombre d'appels à step /// Number of calls to step</returns>
+	std::size_t run(opt::LevelBuilder& builder)
+	{
+		std::size_t etapes{ 0 };
+		while (!builder.step(std::chrono::microseconds(50)) && etapes < 1000000)
+			++etapes;
+		return etapes + 1;
+	}
+
+	/// <summary>
+	/// Niveau de référence : les tuiles existantes puis les nouvelles, ajoutées d'un coup ///
+	/// Reference level: the existing tiles then the new ones, added at once
+	/// </summary>
+	void oneShot(opt::Level& level, const std::vector<opt::TileRecord>& existing, const std::vector<opt::TileRecord>& added)
+	{
+		opt::test::prepare(level);
+		level.add(existing);
+		level.add(added);
+	}
+}
+
+OPTTILE_TEST(level_builder_matches_one_shot_add)
+{
+	const std::vector<opt::TileRecord> existantes{ opt::test::grid(10, 10) };
+	std::vector<opt::TileRecord> ajoutees{ opt::test::grid(120, 100) };
+	for (opt::TileRecord& tuile : ajoutees)
+		tuile.rect.top += 1000.f;
+	opt::Level attendu;
+	oneShot(attendu, existantes, ajoutees);
+
+	opt::Level niveau;
+	opt::test::prepare(niveau);
+	niveau.add(existantes);
+	niveau.resetStats();
+	opt::LevelBuilder constructeur{ niveau, ajoutees };
+	OPTTILE_CHECK(constructeur.totalTiles() == ajoutees.size());
+	OPTTILE_CHECK(constructeur.builtTiles() == 0 && !constructeur.done());
+	OPTTILE_CHECK(!niveau.bufferAutoUpdate());
+	OPTTILE_CHECK(run(constructeur) > 1);
+	OPTTILE_CHECK(constructeur.done() && constructeur.builtTiles() == ajoutees.size());
+	OPTTILE_CHECK(niveau.bufferAutoUpdate());
+	OPTTILE_CHECK(opt::test::sameLevel(attendu, niveau));
+	OPTTILE_CHECK(constructeur.step(std::chrono::microseconds(0)));
+
+#ifdef OPTTILE_ENABLE_STATS
+	// Aperçu des nouveaux sommets, puis tampon final rempli par tranches et adopté d'un coup ///
+	// Preview of the new vertexes, then final buffer filled by slices and adopted at once
+	const std::size_t nouveaux{ niveau.vertices().size() - attendu.beginTileIndexes()[existantes.size()] };
+	OPTTILE_CHECK(niveau.stats().uploadedVertexes == nouveaux + niveau.vertices().size());
+	OPTTILE_CHECK(niveau.stats().bufferCreations == 1);
+#endif
+}
+
+OPTTILE_TEST(level_builder_keeps_disabled_auto_update)
+{
+	const std::vector<opt::TileRecord> tuiles{ opt::test::grid(40, 40) };
+	opt::Level attendu;
+	oneShot(attendu, {}, tuiles);
+
+	opt::Level niveau;
+	opt::test::prepare(niveau);
+	niveau.bufferAutoUpdate(false);
+	{
+		opt::LevelBuilder constructeur{ niveau, tuiles };
+		run(constructeur);
+		OPTTILE_CHECK(!niveau.bufferAutoUpdate());
+	}
+	OPTTILE_CHECK(!niveau.bufferAutoUpdate());
+	OPTTILE_CHECK(opt::test::sameLevel(attendu, niveau));
+
+	// Des tuiles cachées font recharger le tampon d'un coup plutôt que par tranches ///
+	// Hidden tiles make the buffer reload at once instead of by slices
+	opt::Level cache;
+	opt::test::prepare(cache);
+	cache.add(tuiles);
+	cache.setVisible(3, false);
+	attendu.setVisible(3, false);
+	attendu.add(tuiles);
+	{
+		opt::LevelBuilder constructeur{ cache, tuiles };
+		run(constructeur);
+	}
+	OPTTILE_CHECK(cache.bufferAutoUpdate());
+	OPTTILE_CHECK(opt::test::sameLevel(attendu, cache));
+}
+
+OPTTILE_TEST(level_builder_destroyed_before_done)
+{
+	const std::vector<opt::TileRecord> tuiles{ opt::test::grid(200, 100) };
+	opt::Level niveau;
+	opt::test::prepare(niveau);
+	std::size_t construites{ 0 };
+	{
+		opt::LevelBuilder constructeur{ niveau, tuiles };
+		constructeur.step(std::chrono::microseconds(1));
+		constructeur.step(std::chrono::microseconds(1));
+		construites = constructeur.builtTiles();
+		OPTTILE_CHECK(!constructeur.done());
+	}
+	// Les tuiles déjà ajoutées restent, et le niveau reprend sa mise à jour ///
+	// Tiles already added stay, and the level gets its update back
+	OPTTILE_CHECK(construites < tuiles.size());
+	OPTTILE_CHECK(niveau.size() == construites);
+	OPTTILE_CHECK(niveau.bufferAutoUpdate());
+	opt::Level attendu;
+	oneShot(attendu, {}, std::vector<opt::TileRecord>(tuiles.begin(), tuiles.begin() + static_cast<std::ptrdiff_t>(construites)));
+	OPTTILE_CHECK(opt::test::sameLevel(attendu, niveau));
+
+	// Le niveau reste utilisable /// The level stays usable
+	niveau.add(tuiles);
+	attendu.add(tuiles);
+	OPTTILE_CHECK(opt::test::sameLevel(attendu, niveau));
+}
+
+OPTTILE_TEST(level_builder_preview)
+{
+	const std::vector<opt::TileRecord> tuiles{ opt::test::grid(150, 150) };
+	opt::Level niveau;
+	opt::test::prepare(niveau);
+	opt::LevelBuilder constructeur{ niveau, tuiles };
+	sf::RenderTexture cible;
+	OPTTILE_CHECK(cible.create(16, 16));
+
+	constructeur.step(std::chrono::microseconds(200));
+	OPTTILE_CHECK(constructeur.builtTiles() > 0);
+	niveau.resetStats();
+	cible.draw(constructeur);
+#ifdef OPTTILE_ENABLE_STATS
+	// L'aperçu dessine exactement les sommets déjà construits /// The preview draws exactly the vertexes already built
+	OPTTILE_CHECK(niveau.stats().submittedVertexes == niveau.vertices().size());
+	OPTTILE_CHECK(niveau.stats().drawCalls >= 1);
+#endif
+
+	run(constructeur);
+	// Terminé, l'aperçu est libéré et ne dessine plus rien /// Done, the preview is freed and draws nothing anymore
+	niveau.resetStats();
+	cible.draw(constructeur);
+#ifdef OPTTILE_ENABLE_STATS
+	OPTTILE_CHECK(niveau.stats().drawCalls == 0);
+#endif
+	OPTTILE_CHECK(niveau.size() == tuiles.size());
+}
+
+OPTTILE_TEST(level_builder_rejects_unknown_subtexture)
+{
+	std::vector<opt::TileRecord> tuiles{ opt::test::grid(5, 5) };
+	tuiles[17].subTexture = 99;
+	opt::Level niveau;
+	opt::test::prepare(niveau);
+	OPTTILE_CHECK_THROWS(opt::LevelBuilder(niveau, tuiles), opt::AtlasException);
+	OPTTILE_CHECK(niveau.size() == 0);
+	OPTTILE_CHECK(niveau.bufferAutoUpdate());
+}
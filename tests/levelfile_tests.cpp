@@ -0,0 +1,206 @@
+///
+/// Tests des fichiers de niveau (LevelFile) - Level file tests
+///
+
+#include "unit_tests.h"
+#include "Exceptions.h"
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace
+{
+	bool sameBits(float a, float b)
+	{
+		return std::bit_cast<std::uint32_t>(a) == std::bit_cast<std::uint32_t>(b);
+	}
+
+	/// <summary>
+	/// Compare les champs bit à bit, pour que -0 et NaN comptent ///
+	/// Compares the fields bit for bit, so that -0 and NaN count
+	/// </summary>
+	bool identical(const std::vector<opt::TileRecord>& expected, const std::vector<opt::TileRecord>& obtained)
+	{
+		if (expected.size() != obtained.size())
+			return false;
+		for (std::size_t i{ 0 }; i < expected.size(); ++i)
+		{
+			const opt::TileRecord& a{ expected[i] };
+			const opt::TileRecord& b{ obtained[i] };
+			if (!sameBits(a.rect.left, b.rect.left) || !sameBits(a.rect.top, b.rect.top) || !sameBits(a.rect.width, b.rect.width) || !sameBits(a.rect.height, b.rect.height)
+				|| !sameBits(a.scale.x, b.scale.x) || !sameBits(a.scale.y, b.scale.y)
+				|| a.subTexture != b.subTexture || a.textureRule != b.textureRule || a.colour != b.colour)
+				return false;
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Tuiles régulières pour les plages du format compact, puis des valeurs inhabituelles ///
+	/// Regular tiles for the runs of the compact format, then unusual values
+	/// </summary>
+	std::vector<opt::TileRecord> unusualTiles()
+	{
+		std::vector<opt::TileRecord> tuiles{ opt::test::grid(12, 5) };
+		const float nan{ std::numeric_limits<float>::quiet_NaN() };
+		opt::TileRecord tuile;
+		tuile.rect = sf::FloatRect(-0.f, 0.1f, 40.f, 40.f);
+		tuiles.push_back(tuile);
+		tuile.rect = sf::FloatRect(nan, -nan, 1e-30f, 3.4e38f);
+		tuile.scale = sf::Vector2f(-0.f, 0.333f);
+		tuile.textureRule = opt::TextureRule::fill_space;
+		tuile.colour = sf::Color(1, 2, 3, 4);
+		tuiles.push_back(tuile);
+		tuile.rect = sf::FloatRect(std::numeric_limits<float>::infinity(), -123456.75f, 0.5f, 2.25f);
+		tuile.subTexture = -1;
+		tuile.textureRule = opt::TextureRule::keep_height;
+		tuile.colour = sf::Color(255, 0, 128, 0);
+		tuiles.push_back(tuile);
+		tuiles.push_back(tuile);
+		return tuiles;
+	}
+
+	std::string encode(const std::vector<opt::TileRecord>& tiles, opt::LevelFile::Encoding encoding)
+	{
+		std::ostringstream flux;
+		opt::LevelFile::write(flux, tiles, encoding);
+		return flux.str();
+	}
+
+	std::vector<opt::TileRecord> decodeStream(const std::string& bytes)
+	{
+		std::istringstream flux{ bytes };
+		return opt::LevelFile::read(flux);
+	}
+
+	std::vector<opt::TileRecord> decodeBytes(const std::string& bytes)
+	{
+		return opt::LevelFile::read(std::span<const char>(bytes.data(), bytes.size()));
+	}
+
+	void putLittleEndian(std::string& bytes, std::size_t offset, std::uint64_t value)
+	{
+		for (std::size_t i{ 0 }; i < 8; ++i)
+			bytes[offset + i] = static_cast<char>(value >> (8 * i));
+	}
+
+	/// <summary>
+	/// Fichier compact annonçant le nombre de tuiles donné, suivi des données compactes données ///
+	/// Compact file announcing the given tile count, followed by the given compact data
+	/// </summary>
+	std::string compactFile(std::uint64_t count, const std::string& data)
+	{
+		std::string octets{ encode({}, opt::LevelFile::Encoding::compact).substr(0, 28) };
+		putLittleEndian(octets, 12, count);
+		putLittleEndian(octets, 20, data.size());
+		return octets + data;
+	}
+}
+
+OPTTILE_TEST(levelfile_round_trip_keeps_every_bit)
+{
+	const std::vector<opt::TileRecord> tuiles{ unusualTiles() };
+	for (opt::LevelFile::Encoding encodage : { opt::LevelFile::Encoding::raw, opt::LevelFile::Encoding::compact })
+	{
+		const std::string octets{ encode(tuiles, encodage) };
+		OPTTILE_CHECK(identical(tuiles, decodeStream(octets)));
+		OPTTILE_CHECK(identical(tuiles, decodeBytes(octets)));
+	}
+}
+
+OPTTILE_TEST(levelfile_raw_and_compact_agree)
+{
+	const std::vector<opt::TileRecord> tuiles{ unusualTiles() };
+	const std::vector<opt::TileRecord> brutes{ decodeBytes(encode(tuiles, opt::LevelFile::Encoding::raw)) };
+	// Relire en brut puis réécrire en compact ne doit rien changer ///
+	// Reading raw then writing compact again must not change anything
+	OPTTILE_CHECK(identical(brutes, decodeBytes(encode(brutes, opt::LevelFile::Encoding::compact))));
+	OPTTILE_CHECK(encode(tuiles, opt::LevelFile::Encoding::compact).size() < encode(tuiles, opt::LevelFile::Encoding::raw).size());
+}
+
+OPTTILE_TEST(levelfile_empty_and_default_tiles)
+{
+	const std::vector<opt::TileRecord> vide;
+	const std::vector<opt::TileRecord> defaut(100);
+	for (opt::LevelFile::Encoding encodage : { opt::LevelFile::Encoding::raw, opt::LevelFile::Encoding::compact })
+	{
+		OPTTILE_CHECK(decodeBytes(encode(vide, encodage)).empty());
+		OPTTILE_CHECK(identical(defaut, decodeStream(encode(defaut, encodage))));
+	}
+}
+
+OPTTILE_TEST(levelfile_save_and_load)
+{
+	const opt::test::TemporaryFile fichier{ "levelfile_tests.optl" };
+	const std::vector<opt::TileRecord> tuiles{ unusualTiles() };
+	opt::LevelFile::save(fichier.path(), tuiles);
+	OPTTILE_CHECK(identical(tuiles, opt::LevelFile::load(fichier.path())));
+	OPTTILE_CHECK_THROWS(opt::LevelFile::load(fichier.path() + ".missing"), opt::LoadException);
+}
+
+OPTTILE_TEST(levelfile_truncated_input_throws)
+{
+	const std::vector<opt::TileRecord> tuiles{ unusualTiles() };
+	for (opt::LevelFile::Encoding encodage : { opt::LevelFile::Encoding::raw, opt::LevelFile::Encoding::compact })
+	{
+		const std::string octets{ encode(tuiles, encodage) };
+		for (std::size_t taille{ 0 }; taille < octets.size(); ++taille)
+		{
+			const std::string tronque{ octets.substr(0, taille) };
+			OPTTILE_CHECK_THROWS(decodeStream(tronque), opt::ParseException);
+			OPTTILE_CHECK_THROWS(decodeBytes(tronque), opt::ParseException);
+		}
+	}
+}
+
+OPTTILE_TEST(levelfile_corrupt_input_throws)
+{
+	const std::vector<opt::TileRecord> tuiles{ unusualTiles() };
+	const std::string brut{ encode(tuiles, opt::LevelFile::Encoding::raw) };
+	const std::string compact{ encode(tuiles, opt::LevelFile::Encoding::compact) };
+
+	// En-tête : signature, version, encodage /// Header: magic, version, encoding
+	for (std::size_t octet : { std::size_t{ 0 }, std::size_t{ 4 }, std::size_t{ 8 } })
+	{
+		std::string corrompu{ compact };
+		corrompu[octet] = static_cast<char>(corrompu[octet] + 7);
+		OPTTILE_CHECK_THROWS(decodeStream(corrompu), opt::ParseException);
+		OPTTILE_CHECK_THROWS(decodeBytes(corrompu), opt::ParseException);
+	}
+
+	// Règle de texture inconnue dans la première tuile brute /// Unknown texture rule inside the first raw tile
+	std::string regle{ brut };
+	regle[20 + 20] = static_cast<char>(200);
+	OPTTILE_CHECK_THROWS(decodeStream(regle), opt::ParseException);
+	OPTTILE_CHECK_THROWS(decodeBytes(regle), opt::ParseException);
+
+	// Octets en trop après les tuiles /// Extra bytes after the tiles
+	OPTTILE_CHECK_THROWS(decodeBytes(brut + "x"), opt::ParseException);
+	OPTTILE_CHECK_THROWS(decodeBytes(compact + "x"), opt::ParseException);
+
+	// Nombre de tuiles plus grand que les données compactes /// Tile count larger than the compact data
+	std::string nombre{ compact };
+	nombre[12] = static_cast<char>(nombre[12] + 1);
+	OPTTILE_CHECK_THROWS(decodeStream(nombre), opt::ParseException);
+	OPTTILE_CHECK_THROWS(decodeBytes(nombre), opt::ParseException);
+}
+
+OPTTILE_TEST(levelfile_compact_columns_are_checked)
+{
+	// Sans colonne, le nombre de tuiles ne peut être vérifié : il est refusé avant toute réservation ///
+	// Without any column, the tile count cannot be checked: it is refused before any reservation
+	for (std::uint64_t nombre : { std::uint64_t{ 100 }, std::numeric_limits<std::uint64_t>::max() / 64 })
+	{
+		OPTTILE_CHECK_THROWS(decodeStream(compactFile(nombre, std::string(1, '\0'))), opt::ParseException);
+		OPTTILE_CHECK_THROWS(decodeBytes(compactFile(nombre, std::string(1, '\0'))), opt::ParseException);
+	}
+	OPTTILE_CHECK(decodeBytes(compactFile(0, std::string(1, '\0'))).empty());
+
+	// Bit de colonne inconnu (le dixième), devant une colonne de sous-texture valide ///
+	// Unknown column bit (the tenth one), before a valid subtexture column
+	const std::string colonne{ "\x02\x02\x00", 3 };
+	OPTTILE_CHECK(decodeBytes(compactFile(2, std::string("\x01", 1) + colonne)).size() == 2);
+	OPTTILE_CHECK_THROWS(decodeStream(compactFile(2, std::string("\x81\x04", 2) + colonne)), opt::ParseException);
+	OPTTILE_CHECK_THROWS(decodeBytes(compactFile(2, std::string("\x81\x04", 2) + colonne)), opt::ParseException);
+}
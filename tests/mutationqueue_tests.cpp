@@ -0,0 +1,98 @@
+///
+/// Tests de la file de modifications - Mutation queue tests
+///
+
+#include "unit_tests.h"
+#include "MutationQueue.h"
+#include <thread>
+
+namespace
+{
+	opt::TileMutation mutation(std::size_t producer, int sequence)
+	{
+		opt::TileMutation modification;
+		modification.index = producer;
+		modification.subTexture = sequence;
+		return modification;
+	}
+}
+
+OPTTILE_TEST(mutation_queue_keeps_order_across_blocks)
+{
+	opt::MutationQueue file;
+	opt::TileMutation sortie;
+	OPTTILE_CHECK(!file.pop(sortie));
+
+	// Plusieurs blocs de nœuds, puis une seconde passe sur les nœuds recyclés ///
+	// Several node blocks, then a second pass over the recycled nodes
+	for (int passe{ 0 }; passe < 2; ++passe)
+	{
+		for (int i{ 0 }; i < 3000; ++i)
+			file.push(mutation(0, i));
+		for (int i{ 0 }; i < 3000; ++i)
+		{
+			OPTTILE_CHECK(file.pop(sortie));
+			OPTTILE_CHECK(sortie.subTexture == i);
+		}
+		OPTTILE_CHECK(!file.pop(sortie));
+	}
+}
+
+OPTTILE_TEST(mutation_queue_interleaves_push_and_pop)
+{
+	opt::MutationQueue file;
+	opt::TileMutation sortie;
+	int attendu{ 0 };
+	for (int i{ 0 }; i < 5000; ++i)
+	{
+		file.push(mutation(0, i));
+		if (i % 3 == 0)
+		{
+			OPTTILE_CHECK(file.pop(sortie));
+			OPTTILE_CHECK(sortie.subTexture == attendu++);
+		}
+	}
+	while (file.pop(sortie))
+		OPTTILE_CHECK(sortie.subTexture == attendu++);
+	OPTTILE_CHECK(attendu == 5000);
+}
+
+OPTTILE_TEST(mutation_queue_many_producers)
+{
+	constexpr std::size_t producteurs{ 4 };
+	constexpr int parProducteur{ 20000 };
+	opt::MutationQueue file;
+
+	std::vector<std::thread> fils;
+	for (std::size_t p{ 0 }; p < producteurs; ++p)
+		fils.emplace_back([&file, p] {
+			for (int i{ 0 }; i < parProducteur; ++i)
+				file.push(mutation(p, i));
+		});
+
+	// Le consommateur retire pendant les ajouts, donc les nœuds sont recyclés pendant que les producteurs en prennent ///
+	// The consumer pops during the pushes, so nodes are recycled while the producers take some
+	std::vector<int> suivant(producteurs, 0);
+	std::size_t recues{ 0 };
+	bool ordonne{ true };
+	opt::TileMutation sortie;
+	while (recues < producteurs * parProducteur)
+	{
+		if (!file.pop(sortie))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		ordonne = ordonne && sortie.index < producteurs && sortie.subTexture == suivant[sortie.index];
+		if (sortie.index < producteurs)
+			++suivant[sortie.index];
+		++recues;
+	}
+	for (std::thread& fil : fils)
+		fil.join();
+
+	OPTTILE_CHECK(ordonne);
+	OPTTILE_CHECK(!file.pop(sortie));
+	for (int compte : suivant)
+		OPTTILE_CHECK(compte == parProducteur);
+}
@@ -0,0 +1,160 @@
+///
+/// Tests de la passe d'occlusion - Occlusion pass tests
+///
+
+#include "unit_tests.h"
+#include "OcclusionIndex.h"
+
+namespace
+{
+	/// <summary>
+	/// Évaluation complète : une tuile est cachée par une tuile opaque visible, dessinée après elle, qui la contient ///
+	/// Full evaluation: a tile is hidden by a visible opaque tile, drawn after it, which contains it
+	/// </summary>
+	bool bruteOccluded(opt::Level& level, const std::vector<bool>& opaque, const std::vector<bool>& visible, std::size_t index)
+	{
+		const sf::FloatRect dessous{ level[static_cast<int>(index)].getGlobalBounds() };
+		for (std::size_t i{ 0 }; i < level.size(); ++i)
+		{
+			const sf::FloatRect dessus{ level[static_cast<int>(i)].getGlobalBounds() };
+			if (i != index && opaque[i] && visible[i] && level.beginTileIndexes()[i] > level.beginTileIndexes()[index]
+				&& dessus.left <= dessous.left && dessus.top <= dessous.top
+				&& dessus.left + dessus.width >= dessous.left + dessous.width && dessus.top + dessus.height >= dessous.top + dessous.height)
+				return true;
+		}
+		return false;
+	}
+
+	bool matchesBruteForce(opt::Level& level, const std::vector<bool>& opaque, const std::vector<bool>& visible)
+	{
+		for (std::size_t i{ 0 }; i < level.size(); ++i)
+			if (level.isOccluded(i) != bruteOccluded(level, opaque, visible, i))
+				return false;
+		return true;
+	}
+}
+
+OPTTILE_TEST(occlusion_index_covered_and_partial)
+{
+	opt::OcclusionIndex index{ 64u };
+	// 0 est couverte par 1; 2 n'est couverte qu'à moitié; 3 couvre 0 mais est dessinée avant ///
+	// 0 is covered by 1; 2 is only half covered; 3 covers 0 but is drawn before
+	index.update(0, sf::FloatRect(10.f, 10.f, 20.f, 20.f), false);
+	index.update(1, sf::FloatRect(0.f, 0.f, 100.f, 100.f), true);
+	index.update(2, sf::FloatRect(80.f, 80.f, 40.f, 40.f), false);
+	index.update(3, sf::FloatRect(0.f, 0.f, 50.f, 50.f), true);
+	std::vector<std::size_t> ordre{ 6, 12, 18, 0 };
+	OPTTILE_CHECK(index.resolve(ordre) == 4);
+	OPTTILE_CHECK(index.occluded(0));
+	OPTTILE_CHECK(!index.occluded(1));
+	OPTTILE_CHECK(!index.occluded(2));
+	// 3 est dessinée avant 1 et entièrement dedans /// 3 is drawn before 1 and entirely inside it
+	OPTTILE_CHECK(index.occluded(3));
+	OPTTILE_CHECK(index.resolve(ordre) == 0);
+
+	// La couvrante devient transparente : seules les tuiles sous elle sont réévaluées ///
+	// The coverer becomes transparent: only the tiles under it are evaluated again
+	index.update(1, sf::FloatRect(0.f, 0.f, 100.f, 100.f), false);
+	OPTTILE_CHECK(index.resolve(ordre) == 4);
+	OPTTILE_CHECK(!index.occluded(0) && !index.occluded(3));
+
+	// Une couvrante qui s'éloigne libère ce qu'elle couvrait /// A coverer moving away frees what it covered
+	index.update(1, sf::FloatRect(0.f, 0.f, 100.f, 100.f), true);
+	index.resolve(ordre);
+	OPTTILE_CHECK(index.occluded(0));
+	index.update(1, sf::FloatRect(1000.f, 1000.f, 100.f, 100.f), true);
+	index.resolve(ordre);
+	OPTTILE_CHECK(!index.occluded(0) && !index.occluded(3));
+
+	// Couverture exacte, à la limite d'une cellule /// Exact cover, on a cell boundary
+	index.update(4, sf::FloatRect(64.f, 64.f, 10.f, 10.f), false);
+	index.update(5, sf::FloatRect(64.f, 64.f, 10.f, 10.f), true);
+	ordre = { 6, 12, 18, 0, 24, 30 };
+	index.resolve(ordre);
+	OPTTILE_CHECK(index.occluded(4) && !index.occluded(5));
+
+	// Sans la couvrante, la tuile marquée redevient visible /// Without the coverer, the marked tile is visible again
+	index.truncate(5);
+	ordre.resize(5);
+	index.resolve(ordre);
+	OPTTILE_CHECK(!index.occluded(4));
+	OPTTILE_CHECK(!index.occluded(5));
+}
+
+OPTTILE_TEST(occlusion_index_relayout)
+{
+	opt::OcclusionIndex index;
+	index.update(0, sf::FloatRect(0.f, 0.f, 10.f, 10.f), false);
+	index.update(1, sf::FloatRect(0.f, 0.f, 10.f, 10.f), true);
+	index.resolve({ 0, 6 });
+	OPTTILE_CHECK(index.occluded(0) && !index.occluded(1));
+
+	// Ordre de dessin inversé : les deux tuiles sont réévaluées /// Reversed draw order: both tiles are evaluated again
+	index.markAll();
+	OPTTILE_CHECK(index.resolve({ 6, 0 }) == 2);
+	OPTTILE_CHECK(!index.occluded(0) && !index.occluded(1));
+
+	index.clear();
+	OPTTILE_CHECK(!index.occluded(0));
+	OPTTILE_CHECK(index.resolve({}) == 0);
+}
+
+OPTTILE_TEST(occlusion_level_hidden_coverer)
+{
+	opt::Level level;
+	opt::test::prepare(level);
+	level.add(sf::Vector2f(20.f, 20.f), sf::Vector2f(10.f, 10.f), 0, opt::TextureRule::keep_size);
+	level.add(sf::Vector2f(100.f, 100.f), sf::Vector2f(0.f, 0.f), 1, opt::TextureRule::keep_size);
+	level.add(sf::Vector2f(40.f, 40.f), sf::Vector2f(80.f, 80.f), 2, opt::TextureRule::keep_size);
+	level.occlusionCulling(true);
+	level.setOpaque(true, 1);
+	OPTTILE_CHECK(level.isOccluded(0));
+	OPTTILE_CHECK(!level.isOccluded(2));
+
+	// Une couvrante cachée ne cache plus rien /// A hidden coverer no longer hides anything
+	level.setVisible(1, false);
+	OPTTILE_CHECK(!level.isOccluded(0));
+	level.setVisible(1, true);
+	OPTTILE_CHECK(level.isOccluded(0));
+
+	// Une couverture seulement partielle après un déplacement /// Only a partial cover after a move
+	level.move(95.f, 0.f, 0);
+	OPTTILE_CHECK(!level.isOccluded(0));
+	level.move(-95.f, 0.f, 0);
+	OPTTILE_CHECK(level.isOccluded(0));
+
+	level.resetOpaque(1);
+	OPTTILE_CHECK(!level.isOccluded(0));
+}
+
+OPTTILE_TEST(occlusion_level_matches_brute_force_after_layout)
+{
+	opt::Level level;
+	opt::test::prepare(level);
+	const std::vector<opt::TileRecord> tuiles{ opt::test::grid(12, 12) };
+	level.add(tuiles);
+	// Couvrantes réparties dans le niveau, ajoutées après la grille /// Coverers spread over the level, added after the grid
+	for (int i{ 0 }; i < 6; ++i)
+		level.add(sf::Vector2f(120.f, 120.f), sf::Vector2f(static_cast<float>(i * 70), static_cast<float>(i * 60)), i % 4, opt::TextureRule::keep_size);
+	level.occlusionCulling(true);
+
+	std::vector<bool> opaque(level.size(), false), visible(level.size(), true);
+	for (std::size_t i{ tuiles.size() }; i < level.size(); ++i)
+	{
+		level.setOpaque(true, i);
+		opaque[i] = true;
+	}
+	OPTTILE_CHECK(matchesBruteForce(level, opaque, visible));
+
+	level.setVisible(tuiles.size() + 2, false);
+	visible[tuiles.size() + 2] = false;
+	level.setOpaque(true, 30);
+	opaque[30] = true;
+	OPTTILE_CHECK(matchesBruteForce(level, opaque, visible));
+
+	// Le rangement change l'ordre de dessin de toutes les tuiles /// The layout changes the draw order of every tile
+	level.optimizeLayout();
+	OPTTILE_CHECK(matchesBruteForce(level, opaque, visible));
+	level.move(35.f, 15.f, tuiles.size() + 4);
+	OPTTILE_CHECK(matchesBruteForce(level, opaque, visible));
+}
@@ -0,0 +1,61 @@
+///
+/// Tests des sommets compacts (PackedVertexBuffer) - Packed vertex tests
+///
+
+#include "unit_tests.h"
+#include "PackedVertexBuffer.h"
+
+namespace
+{
+	/// <summary>
+	/// Ajoute un carré de deux triangles en (x, y) ///
+	/// Adds a square of two triangles at (x, y)
+	/// </summary>
+	void square(std::vector<sf::Vertex>& vertexes, float x, float y)
+	{
+		for (const sf::Vector2f coin : { sf::Vector2f(0.f, 0.f), sf::Vector2f(8.f, 0.f), sf::Vector2f(0.f, 8.f), sf::Vector2f(8.f, 0.f), sf::Vector2f(8.f, 8.f), sf::Vector2f(0.f, 8.f) })
+			vertexes.emplace_back(sf::Vector2f(x, y) + coin);
+	}
+}
+
+OPTTILE_TEST(packed_small_extent_is_exact)
+{
+	std::vector<sf::Vertex> sommets;
+	for (int i{ 0 }; i < 100; ++i)
+		square(sommets, static_cast<float>(i * 600), 0.f);
+	opt::PackedVertexBuffer tampon;
+	const sf::Texture texture;
+	OPTTILE_CHECK(tampon.update(sommets, texture));
+	OPTTILE_CHECK(tampon.getVertexCount() == sommets.size());
+}
+
+OPTTILE_TEST(packed_wide_chunk_is_refused)
+{
+	std::vector<sf::Vertex> sommets;
+	square(sommets, 0.f, 0.f);
+	square(sommets, 70000.f, 0.f);
+	opt::PackedVertexBuffer tampon;
+	const sf::Texture texture;
+	OPTTILE_CHECK(!tampon.update(sommets, texture));
+}
+
+OPTTILE_TEST(packed_chunks_have_their_own_origin)
+{
+	// Chaque morceau est étroit, mais le niveau s'étend sur plus de 16 bits ///
+	// Each chunk is narrow, but the level spans more than 16 bits
+	std::vector<sf::Vertex> sommets;
+	for (std::size_t morceau{ 0 }; morceau < 3; ++morceau)
+	{
+		for (std::size_t i{ 0 }; i < opt::PackedVertexBuffer::chunkVertexes / 6; ++i)
+			square(sommets, morceau * 100000.f + (i % 64) * 8.f, (i / 64) * 8.f);
+	}
+	opt::PackedVertexBuffer tampon;
+	const sf::Texture texture;
+	OPTTILE_CHECK(tampon.update(sommets, texture));
+
+	// Un morceau partiel qui revient à l'origine du niveau dépasse l'étendue exacte ///
+	// A partial chunk going back to the origin of the level exceeds the exact extent
+	square(sommets, 250000.f, 0.f);
+	square(sommets, 0.f, 0.f);
+	OPTTILE_CHECK(!tampon.update(sommets, texture));
+}
@@ -0,0 +1,493 @@
+///
+/// Harnais de régression du rendu de Level - Render regression harness for Level
+///
+/// Construit des scènes couvrant chaque règle de texture, compare les sommets générés et le hachage de l'image rendue
+/// dans un sf::RenderTexture aux résultats de référence, puis rapporte le nombre d'images par seconde de chaque scène ///
+/// Builds scenes covering every texture rule, compares the generated vertexes and the hash of the image rendered
+/// inside an sf::RenderTexture to the golden outputs, then reports the frames per second of each scene
+///
+/// Utilisation /// Usage :
+///		opttile_render_regression [--golden-dir dir] [--update] [--vertices-only] [--min-time 0.1]
+///
+/// Sans écran, lancer sous Xvfb avec Mesa (LIBGL_ALWAYS_SOFTWARE=1) pour que les hachages d'image soient reproductibles ///
+/// Without a display, run under Xvfb with Mesa (LIBGL_ALWAYS_SOFTWARE=1) so image hashes are reproducible
+///
+
+#include "Autotiler.h"
+#include "Exceptions.h"
+#include "Level.h"
+#include <SFML/OpenGL.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef OPTTILE_GOLDEN_DIR
+#define OPTTILE_GOLDEN_DIR "golden"
+#endif
+
+namespace
+{
+	constexpr unsigned renderSize{ 256u };
+	// Proportion maximale de pixels différents tolérée pour les rendus par nuanceurs (instancié et compact) ///
+	// Maximum share of differing pixels tolerated for the shader renderers (instanced and packed)
+	constexpr double shaderTolerance{ 0.01 };
+
+	struct Options {
+		std::string goldenDir{ OPTTILE_GOLDEN_DIR };
+		bool update{ false };
+		bool verticesOnly{ false };
+		double minSeconds{ 0.1 };
+	};
+
+	struct Scene {
+		std::string name;
+		std::function<void(opt::Level&)> build;
+	};
+
+	const std::pair<opt::TextureRule, const char*> regles[]{
+		{ opt::TextureRule::repeat_texture, "repeat_texture" },
+		{ opt::TextureRule::keep_height, "keep_height" },
+		{ opt::TextureRule::keep_width, "keep_width" },
+		{ opt::TextureRule::keep_size, "keep_size" },
+		{ opt::TextureRule::adjustable_size, "adjustable_size" },
+		{ opt::TextureRule::fill_space, "fill_space" }
+	};
+
+	/// <summary>
+	/// Sous-textures de l'atlas de test. Les quatre premières sont de même taille; la dernière ne l'est pas ///
+	/// Subtextures of the test atlas. The first four share the same size; the last one does not
+	/// </summary>
+	std::vector<sf::FloatRect> testSubTextures()
+	{
+		return {
+			sf::FloatRect(0.f, 0.f, 32.f, 32.f),
+			sf::FloatRect(32.f, 0.f, 32.f, 32.f),
+			sf::FloatRect(64.f, 0.f, 32.f, 32.f),
+			sf::FloatRect(96.f, 0.f, 32.f, 32.f),
+			sf::FloatRect(0.f, 32.f, 48.f, 16.f)
+		};
+	}
+
+	sf::Image testAtlas()
+	{
+		sf::Image atlas;
+		atlas.create(128, 48);
+		for (unsigned x{ 0 }; x < atlas.getSize().x; ++x)
+			for (unsigned y{ 0 }; y < atlas.getSize().y; ++y)
+				atlas.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(x * 2), static_cast<sf::Uint8>(y * 5), static_cast<sf::Uint8>((x ^ y) * 3)));
+		return atlas;
+	}
+
+	/// <summary>
+	/// Ajoute trois tuiles pour que les modifications de la tuile du milieu déplacent les sommets de la dernière ///
+	/// Adds three tiles so changes made to the middle tile shift the vertexes of the last one
+	/// </summary>
+	void addRow(opt::Level& level, opt::TextureRule regle)
+	{
+		level.add(sf::Vector2f(40.f, 40.f), sf::Vector2f(4.f, 4.f), 0, regle);
+		level.add(sf::Vector2f(100.f, 70.f), sf::Vector2f(50.f, 4.f), 1, regle);
+		level.add(sf::Vector2f(45.f, 45.f), sf::Vector2f(160.f, 4.f), 2, regle);
+	}
+
+	std::vector<Scene> makeScenes()
+	{
+		std::vector<Scene> scenes;
+		for (const auto& [regle, nom] : regles)
+		{
+			const opt::TextureRule r{ regle };
+			const std::string prefixe{ nom };
+			scenes.push_back({ prefixe + "_add", [r](opt::Level& level) {
+				addRow(level, r);
+			} });
+			scenes.push_back({ prefixe + "_resize", [r](opt::Level& level) {
+				addRow(level, r);
+				level.resize(sf::Vector2f(130.f, 90.f), 1);
+			} });
+			scenes.push_back({ prefixe + "_scale", [r](opt::Level& level) {
+				addRow(level, r);
+				level.setScale(1.5f, 0.75f, 1);
+			} });
+			scenes.push_back({ prefixe + "_scaled_add", [r](opt::Level& level) {
+				level.add(sf::Vector2f(100.f, 70.f), sf::Vector2f(10.f, 10.f), 3, r, sf::Vector2f(0.6f, 1.3f));
+			} });
+		}
+		scenes.push_back({ "change_texture_same_size", [](opt::Level& level) {
+			addRow(level, opt::TextureRule::repeat_texture);
+			level.changeTextureRect(3, 1);
+		} });
+		scenes.push_back({ "change_texture_other_size", [](opt::Level& level) {
+			addRow(level, opt::TextureRule::repeat_texture);
+			level.changeTextureRect(4, 1);
+		} });
+		scenes.push_back({ "replace_sub_texture", [](opt::Level& level) {
+			addRow(level, opt::TextureRule::repeat_texture);
+			addRow(level, opt::TextureRule::fill_space);
+			level.replaceSubTexture(0, 3);
+			level.replaceSubTexture(2, 4);
+		} });
+		// Le gabarit a ses sous-textures dans l'ordre inverse : append doit les associer par rectangle ///
+		// The template has its subtextures in reverse order: append has to match them by rectangle
+		scenes.push_back({ "append", [](opt::Level& level) {
+			addRow(level, opt::TextureRule::repeat_texture);
+			std::vector<sf::FloatRect> inverses{ testSubTextures() };
+			std::reverse(inverses.begin(), inverses.end());
+			opt::Level gabarit;
+			gabarit.loadTexture(sf::Texture(), inverses);
+			gabarit.add(sf::Vector2f(40.f, 40.f), sf::Vector2f(0.f, 0.f), 0, opt::TextureRule::repeat_texture);
+			gabarit.add(sf::Vector2f(70.f, 30.f), sf::Vector2f(40.f, 10.f), 3, opt::TextureRule::fill_space);
+			level.append(gabarit, sf::Vector2f(10.f, 120.f));
+			level.append(level, sf::Vector2f(0.f, 60.f));
+		} });
+		// Rangement de Morton puis modifications qui changent le nombre de sommets de tuiles rangées ailleurs que selon leur index ///
+		// Morton layout, then changes of the vertex count of tiles stored elsewhere than by their index
+		scenes.push_back({ "optimize_layout", [](opt::Level& level) {
+			for (int i{ 0 }; i < 16; ++i)
+			{
+				const int case_{ (i * 7) % 16 };
+				level.add(sf::Vector2f(40.f, 40.f), sf::Vector2f(static_cast<float>(case_ % 4) * 60.f, static_cast<float>(case_ / 4) * 60.f), i % 4, opt::TextureRule::repeat_texture);
+			}
+			level.optimizeLayout();
+			level.resize(sf::Vector2f(70.f, 50.f), 3);
+			level.changeTextureRect(4, 9);
+			level.move(sf::Vector2f(5.f, 5.f), 15);
+		} });
+		// Auto-pavage : la sous-texture dépend des voisins nord et est de même terrain ///
+		// Autotiling: the subtexture depends on the north and east neighbours of same terrain
+		scenes.push_back({ "autotile", [](opt::Level& level) {
+			for (int i{ 0 }; i < 24; ++i)
+				level.add(sf::Vector2f(32.f, 32.f), sf::Vector2f(static_cast<float>(i % 6) * 32.f, static_cast<float>(i / 6) * 32.f), 4, opt::TextureRule::repeat_texture);
+			opt::AutotileRules regles;
+			for (unsigned masque{ 0 }; masque < 256; ++masque)
+				regles.set(static_cast<std::uint8_t>(masque), (masque & 1 ? 1 : 0) + (masque & 4 ? 2 : 0));
+			opt::Autotiler autotiler{ level, 6, 4 };
+			autotiler.setRules(1, regles);
+			autotiler.bordersMatch(false);
+			autotiler.paint(sf::IntRect(1, 0, 4, 3), 1);
+			autotiler.apply();
+			autotiler.paint(2, 1, 0);
+			autotiler.apply();
+		} });
+		scenes.push_back({ "move_and_position", [](opt::Level& level) {
+			addRow(level, opt::TextureRule::repeat_texture);
+			level.move(sf::Vector2f(3.f, 60.f), 0);
+			level.setPosition(sf::Vector2f(20.f, 150.f), 2);
+		} });
+		scenes.push_back({ "colour", [](opt::Level& level) {
+			addRow(level, opt::TextureRule::repeat_texture);
+			level.changeColour(sf::Color(255, 128, 0, 200), 0);
+			level.changeColour(sf::Color(0, 0, 255), 2);
+			level.resetColour(2);
+		} });
+		// Les modifications en file d'une même tuile sont fusionnées : même résultat qu'en les appliquant une à une ///
+		// Queued changes of a same tile are merged: same result as applying them one by one
+		scenes.push_back({ "mutation_queue", [](opt::Level& level) {
+			addRow(level, opt::TextureRule::repeat_texture);
+			level.enqueueMove(sf::Vector2f(3.f, 20.f), 0);
+			level.enqueueMove(sf::Vector2f(0.f, 40.f), 0);
+			level.enqueueSetPosition(sf::Vector2f(20.f, 150.f), 2);
+			level.enqueueMove(sf::Vector2f(5.f, 5.f), 2);
+			level.enqueueChangeTexture(3, 1);
+			level.enqueueSetColour(sf::Color(0, 0, 255), 1);
+			level.enqueueSetColour(sf::Color(255, 128, 0, 200), 1);
+			level.enqueueAdd(sf::Vector2f(64.f, 32.f), sf::Vector2f(100.f, 200.f), 2, opt::TextureRule::repeat_texture);
+			level.applyMutations();
+		} });
+		return scenes;
+	}
+
+	std::string vertexesToText(const std::vector<sf::Vertex>& vertexes)
+	{
+		std::ostringstream texte;
+		char ligne[160];
+		for (const sf::Vertex& sommet : vertexes)
+		{
+			std::snprintf(ligne, sizeof(ligne), "%.9g %.9g %u %u %u %u %.9g %.9g\n",
+				sommet.position.x, sommet.position.y,
+				static_cast<unsigned>(sommet.color.r), static_cast<unsigned>(sommet.color.g),
+				static_cast<unsigned>(sommet.color.b), static_cast<unsigned>(sommet.color.a),
+				sommet.texCoords.x, sommet.texCoords.y);
+			texte << ligne;
+		}
+		return texte.str();
+	}
+
+	// FNV-1a sur 64 bits /// 64-bit FNV-1a
+	std::uint64_t hashBytes(const sf::Uint8* data, std::size_t size)
+	{
+		std::uint64_t hachage{ 14695981039346656037ull };
+		for (std::size_t i{ 0 }; i < size; ++i)
+		{
+			hachage ^= data[i];
+			hachage *= 1099511628211ull;
+		}
+		return hachage;
+	}
+
+	std::string hashToText(std::uint64_t hachage)
+	{
+		char texte[17];
+		std::snprintf(texte, sizeof(texte), "%016llx", static_cast<unsigned long long>(hachage));
+		return texte;
+	}
+
+	std::string readFile(const std::string& path)
+	{
+		std::ifstream fichier{ path, std::ios::binary };
+		if (!fichier)
+			throw opt::LoadException(path);
+		std::ostringstream contenu;
+		contenu << fichier.rdbuf();
+		return contenu.str();
+	}
+
+	void writeFile(const std::string& path, const std::string& contenu)
+	{
+		std::ofstream fichier{ path, std::ios::binary };
+		fichier << contenu;
+		if (!fichier)
+			throw opt::LoadException(path);
+	}
+
+	std::map<std::string, std::string> readImageHashes(const std::string& path)
+	{
+		std::map<std::string, std::string> hachages;
+		std::ifstream fichier{ path };
+		std::string scene, hachage;
+		while (fichier >> scene >> hachage)
+			hachages[scene] = hachage;
+		return hachages;
+	}
+
+	/// <summary>
+	/// Indique la première ligne différente entre deux textes pour faciliter le diagnostic ///
+	/// Reports the first differing line between two texts to ease diagnosis
+	/// </summary>
+	std::string firstDifference(const std::string& attendu, const std::string& obtenu)
+	{
+		std::istringstream a{ attendu }, b{ obtenu };
+		std::string ligneA, ligneB;
+		for (std::size_t ligne{ 1 }; ; ++ligne)
+		{
+			const bool finA{ !std::getline(a, ligneA) }, finB{ !std::getline(b, ligneB) };
+			if (finA && finB)
+				return "identical";
+			if (finA || finB || ligneA != ligneB)
+				return "vertex " + std::to_string(ligne - 1) + ": expected '" + (finA ? "<end>" : ligneA) + "', got '" + (finB ? "<end>" : ligneB) + "'";
+		}
+	}
+
+	std::uint64_t renderHash(const opt::Level& level, sf::RenderTexture& cible)
+	{
+		cible.clear(sf::Color::Black);
+		cible.draw(level);
+		cible.display();
+		const sf::Image image{ cible.getTexture().copyToImage() };
+		return hashBytes(image.getPixelsPtr(), static_cast<std::size_t>(image.getSize().x) * image.getSize().y * 4);
+	}
+
+	/// <summary>
+	/// Proportion des pixels dont un canal diffère de plus de la tolérance entre deux rendus ///
+	/// Share of the pixels with a channel differing by more than the tolerance between two renders
+	/// </summary>
+	double differingPixels(const sf::Image& attendu, const sf::Image& obtenu, int tolerance)
+	{
+		const std::size_t pixels{ static_cast<std::size_t>(attendu.getSize().x) * attendu.getSize().y };
+		const sf::Uint8* a{ attendu.getPixelsPtr() };
+		const sf::Uint8* b{ obtenu.getPixelsPtr() };
+		std::size_t differents{ 0 };
+		for (std::size_t i{ 0 }; i < pixels; ++i)
+			for (std::size_t canal{ 0 }; canal < 4; ++canal)
+				if (std::abs(static_cast<int>(a[i * 4 + canal]) - static_cast<int>(b[i * 4 + canal])) > tolerance)
+				{
+					++differents;
+					break;
+				}
+		return pixels ? static_cast<double>(differents) / pixels : 0.0;
+	}
+
+	sf::Image renderImage(const opt::Level& level, sf::RenderTexture& cible)
+	{
+		cible.clear(sf::Color::Black);
+		cible.draw(level);
+		cible.display();
+		return cible.getTexture().copyToImage();
+	}
+
+	double framesPerSecond(const opt::Level& level, sf::RenderTexture& cible, double minSeconds)
+	{
+		using Clock = std::chrono::steady_clock;
+		const Clock::time_point debut{ Clock::now() };
+		std::size_t images{ 0 };
+		double secondes{ 0.0 };
+		do
+		{
+			cible.clear(sf::Color::Black);
+			cible.draw(level);
+			cible.display();
+			glFinish();
+			++images;
+			secondes = std::chrono::duration<double>(Clock::now() - debut).count();
+		} while (secondes < minSeconds);
+		return images / secondes;
+	}
+
+	Options parseOptions(int argc, char** argv)
+	{
+		Options options;
+		for (int i{ 1 }; i < argc; ++i)
+		{
+			const std::string argument{ argv[i] };
+			if (argument == "--update")
+				options.update = true;
+			else if (argument == "--vertices-only")
+				options.verticesOnly = true;
+			else if (argument == "--golden-dir" && i + 1 < argc)
+				options.goldenDir = argv[++i];
+			else if (argument == "--min-time" && i + 1 < argc)
+				options.minSeconds = std::stod(argv[++i]);
+			else
+				throw opt::ParseException(argument);
+		}
+		return options;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		const Options options{ parseOptions(argc, argv) };
+		std::vector<sf::FloatRect> subTextures{ testSubTextures() };
+
+		sf::Texture texture;
+		sf::RenderTexture cible;
+		if (!options.verticesOnly)
+		{
+			if (!texture.loadFromImage(testAtlas()))
+				throw opt::LoadException("test atlas");
+			if (!cible.create(renderSize, renderSize))
+				throw opt::LoadException("sf::RenderTexture");
+		}
+
+		const std::string imageHashesPath{ options.goldenDir + "/images.txt" };
+		std::map<std::string, std::string> imageHashes{ readImageHashes(imageHashesPath) };
+		int echecs{ 0 };
+
+		for (const Scene& scene : makeScenes())
+		{
+			opt::Level level;
+			level.loadTexture(texture, subTextures);
+			scene.build(level);
+			level.reloadBuffer();
+
+			const std::string vertexPath{ options.goldenDir + "/" + scene.name + ".vertices" };
+			const std::string sommets{ vertexesToText(level.vertices()) };
+			std::string statut{ "ok" };
+			if (options.update)
+				writeFile(vertexPath, sommets);
+			else
+			{
+				const std::string attendu{ readFile(vertexPath) };
+				if (attendu != sommets)
+				{
+					statut = "VERTEX MISMATCH (" + firstDifference(attendu, sommets) + ")";
+					++echecs;
+				}
+			}
+
+			if (options.verticesOnly)
+			{
+				std::cout << scene.name << " : " << statut << '\n';
+				continue;
+			}
+
+			const std::string hachage{ hashToText(renderHash(level, cible)) };
+			if (options.update)
+				imageHashes[scene.name] = hachage;
+			else if (imageHashes.count(scene.name) && imageHashes[scene.name] != hachage)
+			{
+				statut += ", IMAGE MISMATCH (expected " + imageHashes[scene.name] + ", got " + hachage + ")";
+				++echecs;
+			}
+			else if (!imageHashes.count(scene.name))
+			{
+				// Une scène sans image de référence ne vérifie rien : elle échoue jusqu'à l'enregistrement ///
+				// A scene without a golden image checks nothing: it fails until it is recorded
+				statut += ", NO GOLDEN IMAGE HASH (run with --update to record it)";
+				++echecs;
+			}
+
+			// Le cache de rendu statique doit donner exactement la même image que le dessin direct ///
+			// The static render cache must give exactly the same image as the direct draw
+			level.staticCache(true, 128u);
+			const std::string hachageCache{ hashToText(renderHash(level, cible)) };
+			level.staticCache(false);
+			if (hachageCache != hachage)
+			{
+				statut += ", STATIC CACHE MISMATCH (direct " + hachage + ", cached " + hachageCache + ")";
+				++echecs;
+			}
+
+			const sf::Image direct{ renderImage(level, cible) };
+			// Les coordonnées de texture compactes sont arrondies à 1/65535 de la texture : la même tolérance s'applique ///
+			// Packed texture coordinates are rounded to 1/65535 of the texture: the same tolerance applies
+			if (level.packedVertexes(true))
+			{
+				const double ecart{ differingPixels(direct, renderImage(level, cible), 8) };
+				if (ecart > shaderTolerance)
+				{
+					statut += ", PACKED MISMATCH (" + std::to_string(ecart * 100.0) + "% of pixels differ)";
+					++echecs;
+				}
+				level.packedVertexes(false);
+			}
+
+			// Le rendu instancié échantillonne dans le nuanceur de fragments : seuls les bords des pixels peuvent différer ///
+			// The instanced renderer samples in the fragment shader: only pixel edges may differ
+			double fpsInstancie{ 0.0 };
+			if (level.instancedRendering(true))
+			{
+				const double ecart{ differingPixels(direct, renderImage(level, cible), 8) };
+				if (ecart > shaderTolerance)
+				{
+					statut += ", INSTANCED MISMATCH (" + std::to_string(ecart * 100.0) + "% of pixels differ)";
+					++echecs;
+				}
+				fpsInstancie = framesPerSecond(level, cible, options.minSeconds);
+				level.instancedRendering(false);
+			}
+
+			std::printf("%-32s %10.1f fps %10.1f fps instanced  %s\n", scene.name.c_str(), framesPerSecond(level, cible, options.minSeconds), fpsInstancie, statut.c_str());
+		}
+
+		if (options.update && !options.verticesOnly)
+		{
+			std::ostringstream contenu;
+			for (const auto& [scene, hachage] : imageHashes)
+				contenu << scene << ' ' << hachage << '\n';
+			writeFile(imageHashesPath, contenu.str());
+		}
+
+		if (echecs)
+		{
+			std::cerr << echecs << " regression(s) detected\n";
+			return 1;
+		}
+	}
+	catch (const opt::Exception& exception)
+	{
+		std::cerr << exception.showMessage() << '\n';
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,137 @@
+///
+/// Tests des photos de niveau (LevelSnapshot) - Level snapshot tests
+///
+
+#include "unit_tests.h"
+
+namespace
+{
+	struct State {
+		std::vector<opt::TileRecord> records;
+		std::vector<sf::Vertex> vertexes;
+		std::vector<bool> visible;
+	};
+
+	State capture(opt::Level& level)
+	{
+		State etat{ level.records(), level.vertices(), {} };
+		for (std::size_t i{ 0 }; i < level.size(); ++i)
+			etat.visible.push_back(level.isVisible(i));
+		return etat;
+	}
+
+	bool matches(opt::Level& level, const State& etat)
+	{
+		const State actuel{ capture(level) };
+		return opt::test::sameRecords(etat.records, actuel.records) && opt::test::sameVertexes(etat.vertexes, actuel.vertexes) && etat.visible == actuel.visible;
+	}
+
+	/// <summary>
+	/// Niveau de 2 600 tuiles, sur plusieurs morceaux, avec une colonne, une couche et une opacité imposée ///
+	/// Level of 2 600 tiles, over several chunks, with a column, a layer and a forced opacity
+	/// </summary>
+	void build(opt::Level& level)
+	{
+		opt::test::prepare(level);
+		const std::vector<opt::TileRecord> tuiles{ opt::test::grid(52, 50) };
+		level.add(tuiles);
+		std::span<int> points{ level.addColumn<int>("points") };
+		for (std::size_t i{ 0 }; i < points.size(); ++i)
+			points[i] = static_cast<int>(i) * 3;
+		level.addLayer("top");
+		level.setLayer("top", 5);
+		level.occlusionCulling(true);
+		level.setOpaque(true, 7);
+		level.setVisible(11, false);
+	}
+
+	void checkTileData(opt::Level& level)
+	{
+		const std::span<const int> points{ std::as_const(level).column<int>("points") };
+		OPTTILE_CHECK(points.size() == level.size());
+		for (std::size_t i{ 0 }; i < 2600; ++i)
+			OPTTILE_CHECK(points[i] == static_cast<int>(i) * 3);
+		OPTTILE_CHECK(level.layerOf(5) == "top");
+		OPTTILE_CHECK(level.layerOf(6) == "base");
+	}
+}
+
+OPTTILE_TEST(snapshot_restore_removes_added_tiles)
+{
+	opt::Level level;
+	build(level);
+	const opt::LevelSnapshot photo{ level.snapshot() };
+	const State etat{ capture(level) };
+
+	level.add(sf::Vector2f(64.f, 32.f), sf::Vector2f(10.f, 10.f), 4, opt::TextureRule::repeat_texture);
+	const std::vector<opt::TileRecord> ajoutees{ opt::test::grid(3, 1) };
+	level.add(ajoutees);
+	level.setVisible(level.size() - 1, false);
+	level.changeColour(sf::Color(1, 2, 3), 20);
+	level.restore(photo);
+
+	OPTTILE_CHECK(matches(level, etat));
+	checkTileData(level);
+	// Le niveau restauré partage tous les morceaux de la photo /// The restored level shares every chunk of the snapshot
+	OPTTILE_CHECK(level.snapshot().sharedChunks(photo) == photo.chunkCount());
+}
+
+OPTTILE_TEST(snapshot_restore_adds_removed_tiles)
+{
+	opt::Level level;
+	build(level);
+	const opt::LevelSnapshot avant{ level.snapshot() };
+	const State etatAvant{ capture(level) };
+	const std::vector<opt::TileRecord> ajoutees{ opt::test::grid(7, 3) };
+	level.add(ajoutees);
+	level.setVisible(level.size() - 2, false);
+	level.move(sf::Vector2f(3.f, 4.f), 1);
+	const opt::LevelSnapshot apres{ level.snapshot() };
+	const State etatApres{ capture(level) };
+
+	level.restore(avant);
+	OPTTILE_CHECK(matches(level, etatAvant));
+	level.restore(apres);
+	OPTTILE_CHECK(matches(level, etatApres));
+	checkTileData(level);
+	level.restore(avant);
+	OPTTILE_CHECK(matches(level, etatAvant));
+	checkTileData(level);
+}
+
+OPTTILE_TEST(snapshot_restore_rebuild_keeps_tile_data)
+{
+	opt::Level level;
+	build(level);
+	const opt::LevelSnapshot photo{ level.snapshot() };
+	const State etat{ capture(level) };
+
+	// Un changement du nombre de sommets de la première tuile décale toutes les autres : le niveau est reconstruit ///
+	// A change of the vertex count of the first tile shifts every other one: the level is rebuilt
+	level.resize(sf::Vector2f(90.f, 70.f), 0);
+	level.add(sf::Vector2f(40.f, 40.f), sf::Vector2f(0.f, 0.f), 1, opt::TextureRule::repeat_texture);
+	OPTTILE_CHECK(level.vertices().size() != etat.vertexes.size());
+	level.restore(photo);
+
+	OPTTILE_CHECK(matches(level, etat));
+	checkTileData(level);
+	// L'opacité imposée est gardée : la tuile 7 cache la tuile 6 une fois posée dessus ///
+	// The forced opacity is kept: tile 7 hides tile 6 once put over it
+	OPTTILE_CHECK(!level.isOccluded(6));
+	level.setPosition(sf::Vector2f(240.f, 0.f), 7);
+	OPTTILE_CHECK(level.isOccluded(6));
+}
+
+OPTTILE_TEST(snapshot_restore_in_place)
+{
+	opt::Level level;
+	build(level);
+	const opt::LevelSnapshot photo{ level.snapshot() };
+	const State etat{ capture(level) };
+	level.changeTextureRect(3, 40);
+	level.changeColour(sf::Color(9, 9, 9), 2000);
+	level.setVisible(12, false);
+	level.restore(photo);
+	OPTTILE_CHECK(matches(level, etat));
+	checkTileData(level);
+}
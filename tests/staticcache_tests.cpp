@@ -0,0 +1,121 @@
+///
+/// Tests du cache de rendu statique - Static render cache tests
+///
+
+#include "unit_tests.h"
+
+namespace
+{
+	/// <summary>
+	/// Deux triangles couvrant un carré de 100 unités en (x, y) ///
+	/// Two triangles covering a square of 100 units at (x, y)
+	/// </summary>
+	void square(std::vector<sf::Vertex>& vertexes, float x, float y)
+	{
+		for (const sf::Vector2f coin : { sf::Vector2f(0.f, 0.f), sf::Vector2f(100.f, 0.f), sf::Vector2f(0.f, 100.f), sf::Vector2f(100.f, 0.f), sf::Vector2f(100.f, 100.f), sf::Vector2f(0.f, 100.f) })
+			vertexes.emplace_back(sf::Vector2f(x, y) + coin);
+	}
+
+	/// <summary>
+	/// Plages des carrés qui touchent une région, trouvées en parcourant tous les sommets ///
+	/// Ranges of the squares touching a region, found by going through every vertex
+	/// </summary>
+	opt::StaticCache::RangeQuery touching(const std::vector<sf::Vertex>& vertexes)
+	{
+		return [&vertexes](const sf::FloatRect& region) {
+			std::vector<std::pair<std::size_t, std::size_t>> plages;
+			for (std::size_t i{ 0 }; i + 5 < vertexes.size(); i += 6)
+				if (region.intersects(sf::FloatRect(vertexes[i].position, sf::Vector2f(100.f, 100.f))))
+					plages.emplace_back(i, 6);
+			return plages;
+		};
+	}
+
+	/// <summary>
+	/// Nombre de sommets des tuiles du niveau qui touchent une région ///
+	/// Number of vertexes of the level's tiles touching a region
+	/// </summary>
+	std::size_t touchingVertexes(opt::Level& level, const sf::FloatRect& region)
+	{
+		std::size_t sommets{ 0 };
+		for (std::size_t i{ 0 }; i < level.size(); ++i)
+			if (region.intersects(level[static_cast<int>(i)].getGlobalBounds()))
+				sommets += level[static_cast<int>(i)].vertexCount();
+		return sommets;
+	}
+}
+
+OPTTILE_TEST(static_cache_renders_only_touched_cells)
+{
+	std::vector<sf::Vertex> sommets;
+	for (int i{ 0 }; i < 6; ++i)
+		square(sommets, 10.f + i * 256.f, 10.f);
+	const sf::VertexBuffer tampon;
+	const sf::Texture texture;
+	opt::StaticCache cache{ 256u };
+	std::size_t dessines{ 0 };
+	OPTTILE_CHECK(cache.render(&tampon, sommets, texture, touching(sommets), dessines) == 6);
+	OPTTILE_CHECK(cache.render(&tampon, sommets, texture, touching(sommets), dessines) == 0);
+	// Chaque cellule ne dessine que son carré /// Each cell only draws its square
+	OPTTILE_CHECK(dessines == sommets.size());
+
+	cache.invalidate(sf::FloatRect(300.f, 20.f, 10.f, 10.f));
+	OPTTILE_CHECK(cache.render(&tampon, sommets, texture, touching(sommets), dessines) == 1);
+
+	// Une tuile arrivée dans une cellule inoccupée ne rend que cette cellule ///
+	// A tile arriving inside an unoccupied cell only renders that cell
+	square(sommets, 10.f, 600.f);
+	cache.invalidate(sf::FloatRect(10.f, 600.f, 100.f, 100.f));
+	OPTTILE_CHECK(cache.render(&tampon, sommets, texture, touching(sommets), dessines) == 1);
+	OPTTILE_CHECK(cache.gpuBytes() == 7u * 256u * 256u * 4u);
+
+	// Une région plus grande que les cellules occupées recalcule tout le cache ///
+	// A region larger than the occupied cells computes the whole cache again
+	cache.invalidate(sf::FloatRect(-5000.f, -5000.f, 10000.f, 10000.f));
+	OPTTILE_CHECK(cache.render(&tampon, sommets, texture, touching(sommets), dessines) == 7);
+}
+
+OPTTILE_TEST(static_cache_cells_draw_only_touching_tiles)
+{
+	opt::Level level;
+	opt::test::prepare(level);
+	level.add(opt::test::grid(10, 10));
+	level.staticCache(true, 128u);
+	sf::RenderTexture cible;
+	OPTTILE_CHECK(cible.create(16, 16));
+
+	level.resetStats();
+	cible.draw(level);
+#ifdef OPTTILE_ENABLE_STATS
+	// Les 16 cellules sont rendues, chacune avec les seules tuiles qui la touchent, puis dessinées comme des quadrilatères ///
+	// The 16 cells are rendered, each with only the tiles touching it, then drawn as quads
+	std::size_t attendus{ 0 };
+	for (int x{ 0 }; x < 4; ++x)
+		for (int y{ 0 }; y < 4; ++y)
+			attendus += touchingVertexes(level, sf::FloatRect(x * 128.f, y * 128.f, 128.f, 128.f));
+	OPTTILE_CHECK(level.stats().cacheCellRenders == 16);
+	OPTTILE_CHECK(level.stats().submittedVertexes == attendus + 16 * 6);
+	OPTTILE_CHECK(attendus < 4 * level.vertices().size());
+#endif
+
+	// Un déplacement à l'intérieur d'une cellule ne rend que ses tuiles, même sans élimination hors de la vue ///
+	// A move inside a cell only renders its tiles, even without culling
+	level.move(5.f, 0.f, 0);
+	level.resetStats();
+	cible.draw(level);
+#ifdef OPTTILE_ENABLE_STATS
+	OPTTILE_CHECK(level.stats().cacheCellRenders == 1);
+	OPTTILE_CHECK(level.stats().submittedVertexes == touchingVertexes(level, sf::FloatRect(0.f, 0.f, 128.f, 128.f)) + 16 * 6);
+#endif
+
+	// Une tuile cachée n'est pas rendue dans sa cellule /// A hidden tile is not rendered inside its cell
+	const std::size_t visibles{ touchingVertexes(level, sf::FloatRect(0.f, 0.f, 128.f, 128.f)) };
+	level.setVisible(0, false);
+	level.resetStats();
+	cible.draw(level);
+#ifdef OPTTILE_ENABLE_STATS
+	OPTTILE_CHECK(level.stats().submittedVertexes == visibles - level[0].vertexCount() + 16 * 6);
+#else
+	(void)visibles;
+#endif
+}
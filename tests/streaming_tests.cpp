@@ -0,0 +1,206 @@
+///
+/// Tests du monde découpé en tronçons - Streaming world tests
+///
+
+#include "unit_tests.h"
+#include "StreamingWorld.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace
+{
+	constexpr float chunkSize{ 160.f };
+
+	/// <summary>
+	/// Grille de 16 x 16 tuiles identiques, donc 4 x 4 tronçons de même taille ///
+	/// Grid of 16 x 16 identical tiles, so 4 x 4 chunks of the same size
+	/// </summary>
+	void build(opt::Level& level)
+	{
+		opt::test::prepare(level);
+		std::vector<opt::TileRecord> tuiles{ opt::test::grid(16, 16) };
+		for (opt::TileRecord& tuile : tuiles)
+			tuile.subTexture = 0;
+		level.add(tuiles);
+	}
+
+	/// <summary>
+	/// Vue qui ne touche que le tronçon (x, y) lorsque le rayon de préchargement est nul ///
+	/// View touching only the chunk (x, y) when the prefetch radius is zero
+	/// </summary>
+	sf::View chunkView(int x, int y)
+	{
+		return sf::View(sf::Vector2f((x + 0.5f) * chunkSize, (y + 0.5f) * chunkSize), sf::Vector2f(10.f, 10.f));
+	}
+
+	/// <summary>
+	/// Appelle update jusqu'à ce que plus rien ne soit en attente ///
+	/// Calls update until nothing is pending anymore
+	/// </summary>
+	/// <param name="uploads">Reçoit le plus grand nombre de tronçons téléversés par un appel /// Receives the largest number of chunks uploaded by one call</param>
+	bool settle(opt::StreamingWorld& world, std::size_t* uploads = nullptr)
+	{
+		const auto limite{ std::chrono::steady_clock::now() + std::chrono::seconds(20) };
+		while (world.pendingChunks() != 0)
+		{
+			const std::size_t televerses{ world.update() };
+			if (uploads)
+				*uploads = std::max(*uploads, televerses);
+			if (std::chrono::steady_clock::now() > limite)
+				return false;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		world.update();
+		return true;
+	}
+}
+
+OPTTILE_TEST(streaming_split_and_upload_budget)
+{
+	opt::Level niveau;
+	build(niveau);
+	opt::test::TemporaryFile dossier{ "streaming_budget" };
+	OPTTILE_CHECK(opt::StreamingWorld::split(niveau, dossier.path(), chunkSize) == 16);
+
+	opt::StreamingWorld monde{ niveau, dossier.path(), chunkSize };
+	monde.prefetchRadius(0.f);
+	monde.setCamera(chunkView(0, 0));
+	OPTTILE_CHECK(monde.pendingChunks() == 1);
+	OPTTILE_CHECK(settle(monde));
+	OPTTILE_CHECK(monde.residentChunks() == 1);
+	const std::size_t octets{ monde.residentBytes() };
+	OPTTILE_CHECK(octets > 0);
+
+	// Un seul tronçon par update : le budget est toujours dépassé par un tronçon ///
+	// A single chunk per update: the budget is always exceeded by one chunk
+	monde.uploadBudget(1);
+	monde.setCamera(sf::View(sf::FloatRect(0.f, 0.f, 4.f * chunkSize - 1.f, 4.f * chunkSize - 1.f)));
+	OPTTILE_CHECK(monde.pendingChunks() == 15);
+	std::size_t televerses{ 0 };
+	OPTTILE_CHECK(settle(monde, &televerses));
+	OPTTILE_CHECK(televerses == 1);
+	OPTTILE_CHECK(monde.residentChunks() == 16);
+	OPTTILE_CHECK(monde.residentBytes() == 16 * octets);
+}
+
+OPTTILE_TEST(streaming_camera_walk_evicts_least_recent)
+{
+	opt::Level niveau;
+	build(niveau);
+	opt::test::TemporaryFile dossier{ "streaming_walk" };
+	opt::StreamingWorld::split(niveau, dossier.path(), chunkSize);
+
+	opt::StreamingWorld monde{ niveau, dossier.path(), chunkSize };
+	monde.prefetchRadius(0.f);
+	monde.setCamera(chunkView(0, 0));
+	OPTTILE_CHECK(settle(monde));
+	const std::size_t octets{ monde.residentBytes() };
+	monde.memoryBudget(2 * octets);
+
+	monde.setCamera(chunkView(1, 0));
+	OPTTILE_CHECK(settle(monde));
+	OPTTILE_CHECK(monde.residentChunks() == 2);
+
+	// Revu, (0, 0) devient le plus récent sans être relu /// Seen again, (0, 0) becomes the most recent without being read again
+	monde.setCamera(chunkView(0, 0));
+	OPTTILE_CHECK(monde.pendingChunks() == 0);
+
+	// Un troisième tronçon évince le moins récemment vu, (1, 0) /// A third chunk evicts the least recently seen, (1, 0)
+	monde.setCamera(chunkView(2, 0));
+	OPTTILE_CHECK(settle(monde));
+	OPTTILE_CHECK(monde.residentChunks() == 2);
+	OPTTILE_CHECK(monde.residentBytes() == 2 * octets);
+	monde.setCamera(chunkView(0, 0));
+	OPTTILE_CHECK(monde.pendingChunks() == 0);
+	monde.setCamera(chunkView(1, 0));
+	OPTTILE_CHECK(monde.pendingChunks() == 1);
+	OPTTILE_CHECK(settle(monde));
+
+	// Les tronçons demandés ne sont jamais évincés, même au-delà du budget ///
+	// Requested chunks are never evicted, even above the budget
+	monde.setCamera(sf::View(sf::FloatRect(0.f, 0.f, 4.f * chunkSize - 1.f, 2.f * chunkSize - 1.f)));
+	OPTTILE_CHECK(settle(monde));
+	OPTTILE_CHECK(monde.residentChunks() == 8);
+	monde.setCamera(chunkView(3, 3));
+	OPTTILE_CHECK(settle(monde));
+	OPTTILE_CHECK(monde.residentChunks() == 2);
+}
+
+OPTTILE_TEST(streaming_cancels_requests_left_behind)
+{
+	opt::Level niveau;
+	build(niveau);
+	opt::test::TemporaryFile dossier{ "streaming_cancel" };
+	opt::StreamingWorld::split(niveau, dossier.path(), chunkSize);
+
+	opt::StreamingWorld monde{ niveau, dossier.path(), chunkSize };
+	monde.prefetchRadius(0.f);
+	// Marche rapide sans update : seules les demandes de la dernière vue restent ///
+	// Quick walk without update: only the requests of the last view remain
+	for (int x{ 0 }; x < 4; ++x)
+		for (int y{ 0 }; y < 4; ++y)
+			monde.setCamera(chunkView(x, y));
+	monde.setCamera(chunkView(1, 2));
+	OPTTILE_CHECK(monde.pendingChunks() == 1);
+	OPTTILE_CHECK(settle(monde));
+	// Les tronçons construits pendant la marche sont jetés au téléversement /// Chunks built during the walk are dropped at upload
+	OPTTILE_CHECK(monde.residentChunks() == 1);
+	OPTTILE_CHECK(monde.pendingChunks() == 0);
+
+	// Hors du monde : des tronçons vides, résidents quand même /// Outside the world: empty chunks, resident anyway
+	monde.setCamera(chunkView(-5, 9));
+	OPTTILE_CHECK(settle(monde));
+	OPTTILE_CHECK(monde.residentChunks() == 2);
+}
+
+OPTTILE_TEST(streaming_failed_chunk_is_read_again)
+{
+	opt::Level niveau;
+	build(niveau);
+	opt::test::TemporaryFile dossier{ "streaming_failure" };
+	opt::StreamingWorld::split(niveau, dossier.path(), chunkSize);
+	const std::string chemin{ opt::StreamingWorld::chunkPath(dossier.path(), 2, 1) };
+	std::filesystem::copy_file(chemin, chemin + ".good");
+	{
+		std::ofstream abime{ chemin, std::ios::binary | std::ios::trunc };
+		abime << "not a chunk";
+	}
+
+	opt::StreamingWorld monde{ niveau, dossier.path(), chunkSize };
+	monde.prefetchRadius(0.f);
+	monde.setCamera(chunkView(0, 0));
+	OPTTILE_CHECK(settle(monde));
+	const std::size_t octets{ monde.residentBytes() };
+
+	monde.setCamera(chunkView(2, 1));
+	bool lancee{ false };
+	const auto limite{ std::chrono::steady_clock::now() + std::chrono::seconds(20) };
+	while (!lancee && std::chrono::steady_clock::now() < limite)
+	{
+		try
+		{
+			monde.update();
+		}
+		catch (const opt::Exception&)
+		{
+			lancee = true;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	OPTTILE_CHECK(lancee);
+	// Le tronçon en échec n'est pas résident vide /// The failed chunk is not resident empty
+	OPTTILE_CHECK(monde.residentChunks() == 1);
+	OPTTILE_CHECK(monde.pendingChunks() == 0);
+
+	// Réparé, il est relu à la prochaine demande /// Repaired, it is read again at the next request
+	std::filesystem::remove(chemin);
+	std::filesystem::rename(chemin + ".good", chemin);
+	monde.setCamera(chunkView(2, 1));
+	OPTTILE_CHECK(monde.pendingChunks() == 1);
+	OPTTILE_CHECK(settle(monde));
+	OPTTILE_CHECK(monde.residentChunks() == 2);
+	OPTTILE_CHECK(monde.residentBytes() == 2 * octets);
+}
@@ -0,0 +1,149 @@
+///
+/// Tests unitaires d'OptTile - OptTile unit tests
+///
+/// Utilisation /// Usage :
+///		opttile_unit_tests [filter]
+///
+/// Sans filtre, tous les cas sont lancés; sinon, seuls ceux dont le nom contient le filtre ///
+/// Without filter, every case runs; otherwise, only the ones whose name holds the filter
+///
+
+#include "unit_tests.h"
+#include "Exceptions.h"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+std::vector<opt::test::Case>& opt::test::cases()
+{
+	static std::vector<Case> liste;
+	return liste;
+}
+
+opt::test::Registration::Registration(const char* name, void (*function)())
+{
+	cases().push_back({ name, function });
+}
+
+void opt::test::fail(const std::string& message, const char* file, int line)
+{
+	throw Failure{ std::string(file) + ':' + std::to_string(line) + ": " + message };
+}
+
+std::vector<sf::FloatRect> opt::test::subTextures()
+{
+	return {
+		sf::FloatRect(0.f, 0.f, 32.f, 32.f),
+		sf::FloatRect(32.f, 0.f, 32.f, 32.f),
+		sf::FloatRect(64.f, 0.f, 32.f, 32.f),
+		sf::FloatRect(96.f, 0.f, 32.f, 32.f),
+		sf::FloatRect(0.f, 32.f, 48.f, 16.f)
+	};
+}
+
+void opt::test::prepare(Level& level)
+{
+	std::vector<sf::FloatRect> sousTextures{ subTextures() };
+	level.loadTexture(sf::Texture(), sousTextures);
+}
+
+std::vector<opt::TileRecord> opt::test::grid(std::size_t columns, std::size_t rows)
+{
+	std::vector<TileRecord> tuiles(columns * rows);
+	for (std::size_t i{ 0 }; i < tuiles.size(); ++i)
+	{
+		tuiles[i].rect = sf::FloatRect(static_cast<float>(i % columns) * 40.f, static_cast<float>(i / columns) * 40.f, 40.f, 40.f);
+		tuiles[i].subTexture = static_cast<int>(i % 5);
+		tuiles[i].colour = sf::Color(static_cast<sf::Uint8>(i * 37), 255, static_cast<sf::Uint8>(i * 11));
+	}
+	return tuiles;
+}
+
+bool opt::test::sameRecords(const std::vector<TileRecord>& expected, const std::vector<TileRecord>& obtained)
+{
+	if (expected.size() != obtained.size())
+		return false;
+	for (std::size_t i{ 0 }; i < expected.size(); ++i)
+	{
+		const TileRecord& a{ expected[i] };
+		const TileRecord& b{ obtained[i] };
+		if (a.rect != b.rect || a.subTexture != b.subTexture || a.textureRule != b.textureRule || a.scale != b.scale || a.colour != b.colour)
+			return false;
+	}
+	return true;
+}
+
+bool opt::test::sameVertexes(const std::vector<sf::Vertex>& expected, const std::vector<sf::Vertex>& obtained)
+{
+	if (expected.size() != obtained.size())
+		return false;
+	for (std::size_t i{ 0 }; i < expected.size(); ++i)
+		if (expected[i].position != obtained[i].position || expected[i].texCoords != obtained[i].texCoords || expected[i].color != obtained[i].color)
+			return false;
+	return true;
+}
+
+bool opt::test::sameLevel(Level& expected, Level& obtained)
+{
+	if (!sameRecords(expected.records(), obtained.records()) || !sameVertexes(expected.vertices(), obtained.vertices()))
+		return false;
+	for (std::size_t i{ 0 }; i < expected.size(); ++i)
+		if (expected.isVisible(i) != obtained.isVisible(i))
+			return false;
+	return true;
+}
+
+opt::test::TemporaryFile::TemporaryFile(const std::string& name) :
+	m_path{ (std::filesystem::temp_directory_path() / ("opttile_" + name)).string() }
+{
+	std::filesystem::remove_all(m_path);
+}
+
+opt::test::TemporaryFile::~TemporaryFile()
+{
+	std::error_code erreur;
+	std::filesystem::remove_all(m_path, erreur);
+}
+
+const std::string& opt::test::TemporaryFile::path() const
+{
+	return m_path;
+}
+
+int main(int argc, char** argv)
+{
+	const std::string filtre{ argc > 1 ? argv[1] : "" };
+	int echecs{ 0 }, lances{ 0 };
+	for (const opt::test::Case& cas : opt::test::cases())
+	{
+		if (std::string(cas.name).find(filtre) == std::string::npos)
+			continue;
+		++lances;
+		std::string statut{ "ok" };
+		try
+		{
+			cas.function();
+		}
+		catch (const opt::test::Failure& echec)
+		{
+			statut = "FAILED (" + echec.message + ")";
+		}
+		catch (const opt::Exception& exception)
+		{
+			statut = "FAILED (" + std::string(exception.showMessage()) + ")";
+		}
+		catch (const std::exception& exception)
+		{
+			statut = std::string("FAILED (") + exception.what() + ")";
+		}
+		if (statut != "ok")
+			++echecs;
+		std::printf("%-48s %s\n", cas.name, statut.c_str());
+	}
+	if (echecs)
+	{
+		std::cerr << echecs << " of " << lances << " test(s) failed\n";
+		return 1;
+	}
+	return 0;
+}
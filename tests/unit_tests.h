@@ -0,0 +1,103 @@
+///
+/// Tests unitaires d'OptTile - OptTile unit tests
+///
+/// Chaque fichier de tests enregistre ses cas avec OPTTILE_TEST; un cas échoue à la première vérification fausse
+/// ou à la première exception qui sort ///
+/// Each test file records its cases with OPTTILE_TEST; a case fails at the first false check
+/// or at the first exception going out
+///
+
+#ifndef UNIT_TESTS_H
+#define UNIT_TESTS_H
+
+#include "Level.h"
+#include <string>
+#include <vector>
+
+namespace opt::test
+{
+	struct Case {
+		const char* name;
+		void (*function)();
+	};
+
+	std::vector<Case>& cases();
+
+	struct Registration {
+		Registration(const char* name, void (*function)());
+	};
+
+	/// <summary>
+	/// Exception lancée par une vérification fausse ///
+	/// Exception thrown by a false check
+	/// </summary>
+	struct Failure {
+		std::string message;
+	};
+
+	[[noreturn]] void fail(const std::string& message, const char* file, int line);
+
+	/// <summary>
+	/// Sous-textures communes aux tests. Les quatre premières sont de même taille; la dernière ne l'est pas ///
+	/// Subtextures shared by the tests. The first four share the same size; the last one does not
+	/// </summary>
+	std::vector<sf::FloatRect> subTextures();
+
+	/// <summary>
+	/// Niveau vide dont l'atlas utilise subTextures ///
+	/// Empty level whose atlas uses subTextures
+	/// </summary>
+	void prepare(Level& level);
+
+	/// <summary>
+	/// Grille de columns x rows tuiles de 40 unités, avec des sous-textures et des couleurs variées ///
+	/// Grid of columns x rows tiles of 40 units, with varied subtextures and colours
+	/// </summary>
+	std::vector<TileRecord> grid(std::size_t columns, std::size_t rows);
+
+	bool sameRecords(const std::vector<TileRecord>& expected, const std::vector<TileRecord>& obtained);
+
+	bool sameVertexes(const std::vector<sf::Vertex>& expected, const std::vector<sf::Vertex>& obtained);
+
+	/// <summary>
+	/// Compare les tuiles, les sommets et la visibilité de deux niveaux ///
+	/// Compares the tiles, the vertexes and the visibility of two levels
+	/// </summary>
+	bool sameLevel(Level& expected, Level& obtained);
+
+	/// <summary>
+	/// Fichier ou dossier temporaire propre au test, retiré à la destruction ///
+	/// Temporary file or directory belonging to the test, removed on destruction
+	/// </summary>
+	class TemporaryFile {
+	private:
+		std::string m_path;
+	public:
+		explicit TemporaryFile(const std::string& name);
+
+		TemporaryFile(const TemporaryFile&) = delete;
+
+		TemporaryFile& operator=(const TemporaryFile&) = delete;
+
+		~TemporaryFile();
+
+		const std::string& path() const;
+	};
+}
+
+#define OPTTILE_TEST(name) \
+	static void name(); \
+	static const opt::test::Registration name##Registration{ #name, name }; \
+	static void name()
+
+#define OPTTILE_CHECK(expression) \
+	do { if (!(expression)) opt::test::fail(#expression, __FILE__, __LINE__); } while (false)
+
+#define OPTTILE_CHECK_THROWS(expression, Exception) \
+	do { \
+		bool lancee_{ false }; \
+		try { expression; } catch (const Exception&) { lancee_ = true; } \
+		if (!lancee_) opt::test::fail(#expression " does not throw " #Exception, __FILE__, __LINE__); \
+	} while (false)
+
+#endif // !UNIT_TESTS_H
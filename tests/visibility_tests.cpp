@@ -0,0 +1,47 @@
+///
+/// Tests de la visibilité des tuiles - Tile visibility tests
+///
+
+#include "unit_tests.h"
+
+OPTTILE_TEST(visibility_batch_matches_single_calls)
+{
+	opt::Level unique, lot;
+	opt::test::prepare(unique);
+	opt::test::prepare(lot);
+	const std::vector<opt::TileRecord> tuiles{ opt::test::grid(10, 10) };
+	unique.add(tuiles);
+	lot.add(tuiles);
+
+	const std::vector<std::size_t> cachees{ 3, 17, 17, 42, 99, 1000 };
+	for (std::size_t index : cachees)
+		unique.setVisible(index, false);
+	lot.setVisible(cachees, false);
+	OPTTILE_CHECK(opt::test::sameLevel(unique, lot));
+	OPTTILE_CHECK(!lot.isVisible(17) && !lot.isVisible(99) && lot.isVisible(18));
+
+	const std::vector<std::size_t> montrees{ 17, 18 };
+	unique.setVisible(17, true);
+	lot.setVisible(montrees, true);
+	OPTTILE_CHECK(opt::test::sameLevel(unique, lot));
+	OPTTILE_CHECK(lot.isVisible(17) && lot.isVisible(18) && !lot.isVisible(3));
+}
+
+OPTTILE_TEST(visibility_survives_moves_and_resizes)
+{
+	opt::Level level;
+	opt::test::prepare(level);
+	const std::vector<opt::TileRecord> tuiles{ opt::test::grid(8, 8) };
+	level.add(tuiles);
+	const std::vector<std::size_t> cachees{ 5, 6, 30 };
+	level.setVisible(cachees, false);
+
+	// Un déplacement garde le nombre de sommets, un redimensionnement peut le changer ///
+	// A move keeps the vertex count, a resize may change it
+	level.move(10.f, 0.f, 6);
+	level.resize(200.f, 40.f, 2);
+	level.resize(40.f, 40.f, 2);
+	OPTTILE_CHECK(!level.isVisible(5) && !level.isVisible(6) && !level.isVisible(30));
+	OPTTILE_CHECK(level.isVisible(2) && level.isVisible(7));
+	OPTTILE_CHECK(level.records()[6].rect.left == tuiles[6].rect.left + 10.f);
+}
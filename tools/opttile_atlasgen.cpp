@@ -0,0 +1,187 @@
+///
+/// Générateur d'atlas de la bibliothèque OptTile - Atlas generator of the OptTile library
+///
+/// Transforme un fichier de sous-textures en en-tête constexpr, pour que Level::loadTexture n'ait plus de fichier à lire ni à analyser ///
+/// Turns a subtexture file into a constexpr header, so Level::loadTexture has no file left to read or parse
+///
+/// Le fichier garde le format lu par Level::loadTexture, une sous-texture par ligne, avec un nom facultatif en cinquième champ.
+/// Sans nom, la sous-texture s'appelle subTexture suivi de son index. Les lignes blanches sont ignorées, comme par Level::loadTexture ///
+/// The file keeps the format read by Level::loadTexture, one subtexture per line, with an optional name as fifth field.
+/// Without a name, the subtexture is called subTexture followed by its index. Blank lines are skipped, as by Level::loadTexture
+///		left,top,width,height[,name]
+///
+/// Utilisation /// Usage :
+///		opttile_atlasgen <descriptor.txt> <output.h> <EnumName> [namespace]
+///
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+	struct Entry {
+		float values[4];
+		std::string name;
+	};
+
+	std::string_view trim(std::string_view text)
+	{
+		while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+			text.remove_prefix(1);
+		while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+			text.remove_suffix(1);
+		return text;
+	}
+
+	bool isIdentifier(std::string_view text)
+	{
+		if (text.empty() || std::isdigit(static_cast<unsigned char>(text.front())))
+			return false;
+		for (char caractere : text)
+		{
+			if (!std::isalnum(static_cast<unsigned char>(caractere)) && caractere != '_')
+				return false;
+		}
+		return true;
+	}
+
+	std::runtime_error lineError(const std::string& path, std::size_t line, const std::string& message)
+	{
+		return std::runtime_error(path + ":" + std::to_string(line) + ": " + message);
+	}
+
+	std::vector<Entry> readDescriptor(const std::string& path)
+	{
+		std::ifstream fichier{ path };
+		if (!fichier)
+			throw std::runtime_error("cannot open " + path);
+		std::vector<Entry> entrees;
+		std::set<std::string, std::less<>> noms;
+		std::string ligne;
+		for (std::size_t numero{ 1 }; std::getline(fichier, ligne); ++numero)
+		{
+			std::string_view reste{ trim(ligne) };
+			if (reste.empty())
+				continue;
+			Entry entree;
+			std::size_t champ{ 0 };
+			while (true)
+			{
+				const std::size_t virgule{ reste.find(',') };
+				const std::string_view texte{ trim(reste.substr(0, virgule)) };
+				if (champ < 4)
+				{
+					const auto [fin, erreur] { std::from_chars(texte.data(), texte.data() + texte.size(), entree.values[champ]) };
+					if (erreur != std::errc() || fin != texte.data() + texte.size() || !std::isfinite(entree.values[champ]))
+						throw lineError(path, numero, "invalid number '" + std::string(texte) + "'");
+				}
+				else if (champ == 4)
+				{
+					if (!isIdentifier(texte))
+						throw lineError(path, numero, "invalid name '" + std::string(texte) + "'");
+					entree.name = texte;
+				}
+				else
+					throw lineError(path, numero, "too many fields");
+				++champ;
+				if (virgule == std::string_view::npos)
+					break;
+				reste.remove_prefix(virgule + 1);
+			}
+			if (champ < 4)
+				throw lineError(path, numero, "expected left,top,width,height[,name]");
+			if (entree.name.empty())
+				entree.name = "subTexture" + std::to_string(entrees.size());
+			if (!noms.insert(entree.name).second)
+				throw lineError(path, numero, "duplicate name '" + entree.name + "'");
+			entrees.push_back(std::move(entree));
+		}
+		if (entrees.empty())
+			throw std::runtime_error(path + ": no subtexture");
+		return entrees;
+	}
+
+	// Écriture la plus courte qui redonne exactement la même valeur /// Shortest spelling giving back exactly the same value
+	std::string floatLiteral(float value)
+	{
+		char tampon[32];
+		const auto [fin, erreur] { std::to_chars(tampon, tampon + sizeof(tampon), value) };
+		std::string texte(tampon, fin);
+		if (texte.find_first_of(".e") == std::string::npos)
+			texte += ".";
+		return texte + "f";
+	}
+
+	std::string fileName(const std::string& path)
+	{
+		const std::size_t separateur{ path.find_last_of("/\\") };
+		return separateur == std::string::npos ? path : path.substr(separateur + 1);
+	}
+
+	void writeHeader(std::ostream& stream, const std::vector<Entry>& entries, const std::string& source, const std::string& enumName, const std::string& space)
+	{
+		std::string garde{ space + "_" + enumName + "_ATLAS_H" };
+		for (char& caractere : garde)
+			caractere = static_cast<char>(std::toupper(static_cast<unsigned char>(caractere)));
+		std::string variable{ enumName + "Atlas" };
+		variable.front() = static_cast<char>(std::tolower(static_cast<unsigned char>(variable.front())));
+
+		stream << "// Généré par opttile_atlasgen depuis " << source << ". Ne pas modifier ///\n"
+			<< "// Generated by opttile_atlasgen from " << source << ". Do not edit\n\n"
+			<< "#ifndef " << garde << "\n#define " << garde << "\n\n"
+			<< "#include \"AtlasDescriptor.h\"\n\n"
+			<< "namespace " << space << "\n{\n"
+			<< "\tenum class " << enumName << " : int {\n";
+		for (std::size_t i{ 0 }; i < entries.size(); ++i)
+			stream << "\t\t" << entries[i].name << " = " << i << ",\n";
+		stream << "\t};\n\n"
+			<< "\tinline constexpr opt::AtlasDescriptor<" << enumName << ", " << entries.size() << "> " << variable << "{ {\n";
+		for (const Entry& entree : entries)
+		{
+			stream << "\t\topt::AtlasRect{ " << floatLiteral(entree.values[0]) << ", " << floatLiteral(entree.values[1]) << ", "
+				<< floatLiteral(entree.values[2]) << ", " << floatLiteral(entree.values[3]) << " },\n";
+		}
+		stream << "\t} };\n}\n\n#endif // !" << garde << "\n";
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc != 4 && argc != 5)
+	{
+		std::cerr << "usage: opttile_atlasgen <descriptor.txt> <output.h> <EnumName> [namespace]\n";
+		return 2;
+	}
+	try
+	{
+		const std::string entree{ argv[1] };
+		const std::string sortie{ argv[2] };
+		const std::string enumeration{ argv[3] };
+		const std::string espace{ argc == 5 ? argv[4] : "atlas" };
+		if (!isIdentifier(enumeration) || !isIdentifier(espace))
+			throw std::runtime_error("enum and namespace names must be identifiers");
+
+		std::ostringstream entete;
+		writeHeader(entete, readDescriptor(entree), fileName(entree), enumeration, espace);
+
+		std::ofstream fichier{ sortie, std::ios::binary };
+		fichier << entete.str();
+		if (!fichier)
+			throw std::runtime_error("cannot write " + sortie);
+	}
+	catch (const std::exception& exception)
+	{
+		std::cerr << exception.what() << '\n';
+		return 1;
+	}
+	return 0;
+}